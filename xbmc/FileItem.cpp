@@ -509,7 +509,7 @@ void CFileItem::Reset()
   m_strDynPath.clear();
   m_dateTime.Reset();
   m_strLockCode.clear();
-  m_mimetype.clear();
+  SetMimeType("");
   delete m_musicInfoTag;
   m_musicInfoTag=NULL;
   delete m_videoInfoTag;
@@ -556,7 +556,7 @@ void CFileItem::Archive(CArchive& ar)
     ar << m_iBadPwdCount;
 
     ar << m_bCanQueue;
-    ar << m_mimetype;
+    ar << *m_mimetype;
     ar << m_extrainfo;
     ar << m_specialSort;
     ar << m_doContentLookup;
@@ -613,7 +613,9 @@ void CFileItem::Archive(CArchive& ar)
     ar >> m_iBadPwdCount;
 
     ar >> m_bCanQueue;
-    ar >> m_mimetype;
+    std::string mimetype;
+    ar >> mimetype;
+    SetMimeType(mimetype);
     ar >> m_extrainfo;
     ar >> temp;
     m_specialSort = (SortSpecial)temp;
@@ -647,7 +649,7 @@ void CFileItem::Serialize(CVariant& value) const
   value["size"] = m_dwSize;
   value["DVDLabel"] = m_strDVDLabel;
   value["title"] = m_strTitle;
-  value["mimetype"] = m_mimetype;
+  value["mimetype"] = *m_mimetype;
   value["extrainfo"] = m_extrainfo;
 
   if (m_musicInfoTag)
@@ -670,6 +672,39 @@ void CFileItem::Serialize(CVariant& value) const
   }
 }
 
+void CFileItem::SetMimeType(const std::string& mimetype)
+{
+  // the interner never releases its strings, so only the fixed set of known types may go there.
+  // anything else (e.g. sent by a server) is stored with the item.
+  if (mimetype.empty() || CMime::IsKnownMimeType(mimetype))
+    m_mimetype = std::shared_ptr<const std::string>(std::shared_ptr<const std::string>(),
+                                                    &CStringInterner::Intern(mimetype));
+  else
+    m_mimetype = std::make_shared<const std::string>(mimetype);
+}
+
+std::size_t CFileItem::GetMemoryUsage() const
+{
+  std::size_t bytes = CGUIListItem::GetMemoryUsage() - sizeof(CGUIListItem) + sizeof(CFileItem);
+  bytes += GetStringMemoryUsage(m_strPath) + GetStringMemoryUsage(m_strDynPath);
+  bytes += GetStringMemoryUsage(m_strDVDLabel) + GetStringMemoryUsage(m_strTitle);
+  bytes += GetStringMemoryUsage(m_strLockCode) + GetStringMemoryUsage(m_extrainfo);
+  if (m_mimetype.use_count() > 0)
+    bytes += sizeof(std::string) + GetStringMemoryUsage(*m_mimetype);
+
+  // only the tag objects themselves, their contents are not walked
+  if (m_musicInfoTag)
+    bytes += sizeof(MUSIC_INFO::CMusicInfoTag);
+  if (m_videoInfoTag)
+    bytes += sizeof(CVideoInfoTag);
+  if (m_pictureInfoTag)
+    bytes += sizeof(CPictureInfoTag);
+  if (m_gameInfoTag)
+    bytes += sizeof(KODI::GAME::CGameInfoTag);
+
+  return bytes;
+}
+
 void CFileItem::ToSortable(SortItem &sortable, Field field) const
 {
   switch (field)
@@ -795,7 +830,7 @@ bool CFileItem::Exists(bool bUseCache /* = true */) const
 bool CFileItem::IsVideo() const
 {
   /* check preset mime type */
-  if(StringUtils::StartsWithNoCase(m_mimetype, "video/"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "video/"))
     return true;
 
   if (HasVideoInfoTag())
@@ -822,9 +857,9 @@ bool CFileItem::IsVideo() const
     return true;
 
   std::string extension;
-  if(StringUtils::StartsWithNoCase(m_mimetype, "application/"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "application/"))
   { /* check for some standard types */
-    extension = m_mimetype.substr(12);
+    extension = m_mimetype->substr(12);
     if( StringUtils::EqualsNoCase(extension, "ogg")
      || StringUtils::EqualsNoCase(extension, "mp4")
      || StringUtils::EqualsNoCase(extension, "mxf") )
@@ -891,7 +926,7 @@ bool CFileItem::IsDiscStub() const
 bool CFileItem::IsAudio() const
 {
   /* check preset mime type */
-  if(StringUtils::StartsWithNoCase(m_mimetype, "audio/"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "audio/"))
     return true;
 
   if (HasMusicInfoTag())
@@ -909,9 +944,9 @@ bool CFileItem::IsAudio() const
   if (IsCDDA())
     return true;
 
-  if(StringUtils::StartsWithNoCase(m_mimetype, "application/"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "application/"))
   { /* check for some standard types */
-    std::string extension = m_mimetype.substr(12);
+    std::string extension = m_mimetype->substr(12);
     if( StringUtils::EqualsNoCase(extension, "ogg")
      || StringUtils::EqualsNoCase(extension, "mp4")
      || StringUtils::EqualsNoCase(extension, "mxf") )
@@ -962,7 +997,7 @@ bool CFileItem::IsGame() const
 
 bool CFileItem::IsPicture() const
 {
-  if(StringUtils::StartsWithNoCase(m_mimetype, "image/"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "image/"))
     return true;
 
   if (HasPictureInfoTag())
@@ -1154,7 +1189,7 @@ bool CFileItem::IsRSS() const
 {
   return StringUtils::StartsWithNoCase(m_strPath, "rss://") || URIUtils::HasExtension(m_strPath, ".rss")
       || StringUtils::StartsWithNoCase(m_strPath, "rsss://")
-      || m_mimetype == "application/rss+xml";
+      || *m_mimetype == "application/rss+xml";
 }
 
 bool CFileItem::IsAndroidApp() const
@@ -1478,12 +1513,13 @@ bool CFileItem::IsParentFolder() const
 void CFileItem::FillInMimeType(bool lookup /*= true*/)
 {
   //! @todo adapt this to use CMime::GetMimeType()
-  if (m_mimetype.empty())
+  if (m_mimetype->empty())
   {
+    std::string mimetype;
     if( m_bIsFolder )
-      m_mimetype = "x-directory/normal";
+      mimetype = "x-directory/normal";
     else if( m_pvrChannelInfoTag )
-      m_mimetype = m_pvrChannelInfoTag->MimeType();
+      mimetype = m_pvrChannelInfoTag->MimeType();
     else if( StringUtils::StartsWithNoCase(GetDynPath(), "shout://")
           || StringUtils::StartsWithNoCase(GetDynPath(), "http://")
           || StringUtils::StartsWithNoCase(GetDynPath(), "https://"))
@@ -1492,32 +1528,34 @@ void CFileItem::FillInMimeType(bool lookup /*= true*/)
       if (!lookup)
         return;
 
-      CCurlFile::GetMimeType(GetDynURL(), m_mimetype);
+      CCurlFile::GetMimeType(GetDynURL(), mimetype);
 
       // try to get mime-type again but with an NSPlayer User-Agent
       // in order for server to provide correct mime-type.  Allows us
       // to properly detect an MMS stream
-      if (StringUtils::StartsWithNoCase(m_mimetype, "video/x-ms-"))
-        CCurlFile::GetMimeType(GetDynURL(), m_mimetype, "NSPlayer/11.00.6001.7000");
+      if (StringUtils::StartsWithNoCase(mimetype, "video/x-ms-"))
+        CCurlFile::GetMimeType(GetDynURL(), mimetype, "NSPlayer/11.00.6001.7000");
 
       // make sure there are no options set in mime-type
       // mime-type can look like "video/x-ms-asf ; charset=utf8"
-      size_t i = m_mimetype.find(';');
+      size_t i = mimetype.find(';');
       if(i != std::string::npos)
-        m_mimetype.erase(i, m_mimetype.length() - i);
-      StringUtils::Trim(m_mimetype);
+        mimetype.erase(i, mimetype.length() - i);
+      StringUtils::Trim(mimetype);
     }
     else
-      m_mimetype = CMime::GetMimeType(*this);
+      mimetype = CMime::GetMimeType(*this);
 
     // if it's still empty set to an unknown type
-    if (m_mimetype.empty())
-      m_mimetype = "application/octet-stream";
+    if (mimetype.empty())
+      mimetype = "application/octet-stream";
+
+    SetMimeType(mimetype);
   }
 
   // change protocol to mms for the following mime-type.  Allows us to create proper FileMMS.
-  if(StringUtils::StartsWithNoCase(m_mimetype, "application/vnd.ms.wms-hdr.asfv1") ||
-     StringUtils::StartsWithNoCase(m_mimetype, "application/x-mms-framed"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "application/vnd.ms.wms-hdr.asfv1") ||
+     StringUtils::StartsWithNoCase(*m_mimetype, "application/x-mms-framed"))
   {
     if (m_strDynPath.empty())
       m_strDynPath = m_strPath;
@@ -2311,6 +2349,16 @@ const CFileItemPtr CFileItemList::Get(const std::string& strPath) const
   return CFileItemPtr();
 }
 
+std::size_t CFileItemList::GetMemoryUsage() const
+{
+  CSingleLock lock(m_lock);
+  std::size_t bytes = CFileItem::GetMemoryUsage() - sizeof(CFileItem) + sizeof(CFileItemList);
+  bytes += m_items.capacity() * sizeof(CFileItemPtr);
+  for (const auto& item : m_items)
+    bytes += item->GetMemoryUsage();
+  return bytes;
+}
+
 int CFileItemList::Size() const
 {
   CSingleLock lock(m_lock);
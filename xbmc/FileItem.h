@@ -22,6 +22,7 @@
 #include "utils/ISerializable.h"
 #include "utils/ISortable.h"
 #include "utils/SortUtils.h"
+#include "utils/StringInterner.h"
 
 #include <map>
 #include <memory>
@@ -141,6 +142,7 @@ public:
   CFileItem& operator=(const CFileItem& item);
   void Archive(CArchive& ar) override;
   void Serialize(CVariant& value) const override;
+  std::size_t GetMemoryUsage() const override;
   void ToSortable(SortItem &sortable, Field field) const override;
   void ToSortable(SortItem &sortable, const Fields &fields) const;
   bool IsFileItem() const override { return true; };
@@ -466,10 +468,10 @@ public:
   virtual bool LoadGameTag();
 
   /* Returns the content type of this item if known */
-  const std::string& GetMimeType() const { return m_mimetype; }
+  const std::string& GetMimeType() const { return *m_mimetype; }
 
   /* sets the mime-type if known beforehand */
-  void SetMimeType(const std::string& mimetype) { m_mimetype = mimetype; } ;
+  void SetMimeType(const std::string& mimetype);
 
   /*! \brief Resolve the MIME type based on file extension or a web lookup
    If m_mimetype is already set (non-empty), this function has no effect. For
@@ -592,7 +594,9 @@ private:
   bool m_bIsParentFolder;
   bool m_bCanQueue;
   bool m_bLabelPreformatted;
-  std::string m_mimetype;
+  // known mime types point to the interned value without owning it, others are owned by the item
+  std::shared_ptr<const std::string> m_mimetype{std::shared_ptr<const std::string>(),
+                                                &CStringInterner::Empty()};
   std::string m_extrainfo;
   bool m_doContentLookup;
   MUSIC_INFO::CMusicInfoTag* m_musicInfoTag;
@@ -662,6 +666,7 @@ public:
   explicit CFileItemList(const std::string& strPath);
   ~CFileItemList() override;
   void Archive(CArchive& ar) override;
+  std::size_t GetMemoryUsage() const override;
   CFileItemPtr operator[] (int iItem);
   const CFileItemPtr operator[] (int iItem) const;
   CFileItemPtr operator[] (const std::string& strPath);
@@ -148,6 +148,7 @@ public:
   /// | **Supports descramble info** | `boolean` | @ref PVRCapabilities::SetSupportsDescrambleInfo "SetSupportsDescrambleInfo" | @ref PVRCapabilities::GetSupportsDescrambleInfo "GetSupportsDescrambleInfo"
   /// | **Supports async EPG transfer** | `boolean` | @ref PVRCapabilities::SetSupportsAsyncEPGTransfer "SetSupportsAsyncEPGTransfer" | @ref PVRCapabilities::GetSupportsAsyncEPGTransfer "GetSupportsAsyncEPGTransfer"
   /// | **Supports recording size** | `boolean` | @ref PVRCapabilities::SetSupportsRecordingSize "SetSupportsRecordingSize" | @ref PVRCapabilities::GetSupportsRecordingSize "GetSupportsRecordingSize"
+  /// | **Supports concurrent channel streams** | `boolean` | @ref PVRCapabilities::SetSupportsConcurrentChannelStreams "SetSupportsConcurrentChannelStreams" | @ref PVRCapabilities::GetSupportsConcurrentChannelStreams "GetSupportsConcurrentChannelStreams"
   /// | **Recordings lifetime values** | @ref cpp_kodi_addon_pvr_Defs_PVRTypeIntValue "PVRTypeIntValue" | @ref PVRCapabilities::SetRecordingsLifetimeValues "SetRecordingsLifetimeValues" | @ref PVRCapabilities::GetRecordingsLifetimeValues "GetRecordingsLifetimeValues"
   ///
   /// @warning This class can not be used outside of @ref kodi::addon::CInstancePVRClient::GetCapabilities()
@@ -351,6 +352,20 @@ public:
   /// @brief To get with @ref SetSupportsRecordingSize changed values.
   bool GetSupportsRecordingSize() const { return m_capabilities->bSupportsRecordingSize; }
 
+  /// @brief Set **true** if the backend can serve the streams of several
+  /// channels at the same time, e.g. to open the channels next to the playing
+  /// one ahead of a channel switch.
+  void SetSupportsConcurrentChannelStreams(bool supportsConcurrentChannelStreams)
+  {
+    m_capabilities->bSupportsConcurrentChannelStreams = supportsConcurrentChannelStreams;
+  }
+
+  /// @brief To get with @ref SetSupportsConcurrentChannelStreams changed values.
+  bool GetSupportsConcurrentChannelStreams() const
+  {
+    return m_capabilities->bSupportsConcurrentChannelStreams;
+  }
+
   /// @brief **optional**\n
   /// Set array containing the possible values for @ref PVRRecording::SetLifetime().
   ///
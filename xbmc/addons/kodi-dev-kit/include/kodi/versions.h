@@ -129,8 +129,8 @@
 #define ADDON_INSTANCE_VERSION_PERIPHERAL_DEPENDS     "addon-instance/Peripheral.h" \
                                                       "addon-instance/PeripheralUtils.h"
 
-#define ADDON_INSTANCE_VERSION_PVR                    "7.1.0"
-#define ADDON_INSTANCE_VERSION_PVR_MIN                "7.1.0"
+#define ADDON_INSTANCE_VERSION_PVR                    "7.2.0"
+#define ADDON_INSTANCE_VERSION_PVR_MIN                "7.2.0"
 #define ADDON_INSTANCE_VERSION_PVR_XML_ID             "kodi.binary.instance.pvr"
 #define ADDON_INSTANCE_VERSION_PVR_DEPENDS            "c-api/addon-instance/pvr.h" \
                                                       "c-api/addon-instance/pvr/pvr_channel_groups.h" \
@@ -7,13 +7,29 @@
  */
 
 #include "AEResampleFactory.h"
+
+#include "ServiceBroker.h"
 #include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResampleFFMPEG.h"
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResamplePolyphase.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 
 namespace ActiveAE
 {
 
 IAEResample *CAEResampleFactory::Create(uint32_t flags /* = 0 */)
 {
+  if (flags & AERESAMPLEFACTORY_POLYPHASE)
+    return new CActiveAEResamplePolyphase();
+
+  if (!(flags & (AERESAMPLEFACTORY_QUICK_RESAMPLE | AERESAMPLEFACTORY_FFMPEG)))
+  {
+    const std::shared_ptr<CAdvancedSettings> settings =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    if (settings->m_audioResampler == "polyphase")
+      return new CActiveAEResamplePolyphase();
+  }
+
   return new CActiveAEResampleFFMPEG();
 }
 
@@ -21,7 +21,10 @@ namespace ActiveAE
 enum AEResampleFactoryOptions
 {
   /* This is a quick resample job (e.g. resample a single noise packet) and may not be worth using GPU acceleration */
-  AERESAMPLEFACTORY_QUICK_RESAMPLE = 0x01
+  AERESAMPLEFACTORY_QUICK_RESAMPLE = 0x01,
+  /* Force an engine, otherwise advancedsettings.xml <audio><resampler> decides */
+  AERESAMPLEFACTORY_FFMPEG = 0x02,
+  AERESAMPLEFACTORY_POLYPHASE = 0x04
 };
 
 class CAEResampleFactory
@@ -15,15 +15,19 @@ using namespace ActiveAE;
 #include "ActiveAEStream.h"
 #include "ServiceBroker.h"
 #include "cores/AudioEngine/Interfaces/IAudioCallback.h"
+#include "cores/AudioEngine/Utils/AEKernels.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/AudioEngine/Utils/AEStreamData.h"
 #include "cores/AudioEngine/Utils/AEStreamInfo.h"
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Encoders/AEEncoderFFmpeg.h"
 
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/SystemClock.h"
 #include "windowing/WinSystem.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
 #define MAX_CACHE_LEVEL 0.4   // total cache time of stream in seconds
@@ -246,6 +250,43 @@ AEAudioFormat CEngineStats::GetCurrentSinkFormat()
   return m_sinkFormat;
 }
 
+void CEngineStats::AddStageTime(AEProcessingStage stage, int64_t us)
+{
+  CSingleLock lock(m_lock);
+
+  // report average and peak of the last second
+  const unsigned int now = XbmcThreads::SystemClockMillis();
+  if (now - m_stageWindowStart >= 1000)
+  {
+    for (auto& stats : m_stageStats)
+    {
+      stats.lastAverage = stats.count ? static_cast<double>(stats.sum) / stats.count : 0.0;
+      stats.lastMax = stats.max;
+      stats.sum = 0;
+      stats.max = 0;
+      stats.count = 0;
+    }
+    m_stageWindowStart = now;
+  }
+
+  StageStats& stats = m_stageStats[stage];
+  stats.sum += us;
+  stats.max = std::max(stats.max, us);
+  stats.count++;
+}
+
+std::string CEngineStats::GetStageInfo()
+{
+  static const char* names[AE_STAGE_MAX] = {"streams", "mix", "sink"};
+
+  CSingleLock lock(m_lock);
+  std::string info = "ae(avg/max ms)";
+  for (int i = 0; i < AE_STAGE_MAX; i++)
+    info += StringUtils::Format(" {}:{:.2f}/{:.2f}", names[i], m_stageStats[i].lastAverage / 1000.0,
+                                m_stageStats[i].lastMax / 1000.0);
+  return info;
+}
+
 CActiveAE::CActiveAE() :
   CThread("ActiveAE"),
   m_controlPort("OutputControlPort", &m_inMsgEvent, &m_outMsgEvent),
@@ -776,21 +817,6 @@ void CActiveAE::StateMachine(int signal, Protocol *port, Message *msg)
           else
             msg->Reply(CActiveAEDataProtocol::ERR);
           return;
-        case CActiveAEDataProtocol::STREAMSAMPLE:
-          MsgStreamSample *msgData;
-          CSampleBuffer *samples;
-          msgData = reinterpret_cast<MsgStreamSample*>(msg->data);
-          samples = msgData->stream->m_processingSamples.front();
-          msgData->stream->m_processingSamples.pop_front();
-          if (samples != msgData->buffer)
-            CLog::Log(LOGERROR, "CActiveAE - inconsistency in stream sample message");
-          if (msgData->buffer->pkt->nb_samples == 0)
-            msgData->buffer->Return();
-          else
-            msgData->stream->m_processingBuffers->m_inputSamples.push_back(msgData->buffer);
-          m_extTimeout = 0;
-          m_state = AE_TOP_CONFIGURED_PLAY;
-          return;
         case CActiveAEDataProtocol::FREESTREAM:
           MsgStreamFree *msgStreamFree;
           msgStreamFree = reinterpret_cast<MsgStreamFree*>(msg->data);
@@ -1085,6 +1111,14 @@ void CActiveAE::Process()
           }
         }
       }
+
+      // samples of streams
+      if (!gotMsg && m_state >= AE_TOP_CONFIGURED && ReceiveStreamSamples())
+      {
+        m_extTimeout = 0;
+        m_state = AE_TOP_CONFIGURED_PLAY;
+        continue;
+      }
     }
 
     if (gotMsg)
@@ -1531,6 +1565,8 @@ void CActiveAE::SFlushStream(CActiveAEStream *stream)
   }
   stream->m_processingBuffers->Flush();
   stream->m_streamPort->Purge();
+  // the engine is the consumer of filled buffers, empty buffers are drained by the stream
+  stream->m_filledBuffers.Clear();
   stream->m_bufferedTime = 0.0;
   stream->m_paused = false;
   stream->m_syncState = CAESyncInfo::AESyncState::SYNC_START;
@@ -1546,6 +1582,28 @@ void CActiveAE::SFlushStream(CActiveAEStream *stream)
   m_stats.UpdateStream(stream);
 }
 
+bool CActiveAE::ReceiveStreamSamples()
+{
+  bool received = false;
+  for (auto& stream : m_streams)
+  {
+    CSampleBuffer* buffer;
+    while (stream->m_filledBuffers.Pop(buffer))
+    {
+      CSampleBuffer* samples = stream->m_processingSamples.front();
+      stream->m_processingSamples.pop_front();
+      if (samples != buffer)
+        CLog::Log(LOGERROR, "CActiveAE - inconsistency in stream sample queue");
+      if (buffer->pkt->nb_samples == 0)
+        buffer->Return();
+      else
+        stream->m_processingBuffers->m_inputSamples.push_back(buffer);
+      received = true;
+    }
+  }
+  return received;
+}
+
 void CActiveAE::FlushEngine()
 {
   if (m_sinkBuffers)
@@ -1881,13 +1939,25 @@ bool CActiveAE::RunStages()
 {
   bool busy = false;
 
+  // resample and tempo of input streams, streams are independent
+  // of each other and may be processed in parallel
+  auto start = std::chrono::steady_clock::now();
+  m_activeStreamBuffers.clear();
+  for (auto& stream : m_streams)
+  {
+    if (stream->m_processingBuffers && !stream->m_paused)
+      m_activeStreamBuffers.push_back(stream->m_processingBuffers);
+  }
+  if (m_streamWorkers.ProcessBuffers(m_activeStreamBuffers))
+  {
+    busy = true;
+    AddStageTime(AE_STAGE_STREAMS, start);
+  }
+
   // serve input streams
   std::list<CActiveAEStream*>::iterator it;
   for (it = m_streams.begin(); it != m_streams.end(); ++it)
   {
-    if ((*it)->m_processingBuffers && !(*it)->m_paused)
-      busy = (*it)->m_processingBuffers->ProcessBuffers();
-
     if ((*it)->m_streamIsBuffering &&
         (*it)->m_processingBuffers &&
         ((*it)->m_processingBuffers->HasInputLevel(50)))
@@ -1899,19 +1969,25 @@ bool CActiveAE::RunStages()
     // provide buffers to stream
     float time = m_stats.GetCacheTime((*it));
     CSampleBuffer *buffer;
-    if (!(*it)->m_drain)
+    if (!(*it)->m_drain && !(*it)->m_emptyBuffersFlushing)
     {
       float buftime = (float)(*it)->m_inputBuffers->m_format.m_frames / (*it)->m_inputBuffers->m_format.m_sampleRate;
       if ((*it)->m_inputBuffers->m_format.m_dataFormat == AE_FMT_RAW)
         buftime = (*it)->m_inputBuffers->m_format.m_streamInfo.GetDuration() / 1000;
-      while ((time < MAX_CACHE_LEVEL || (*it)->m_streamIsBuffering) && !(*it)->m_inputBuffers->m_freeSamples.empty())
+      bool provided = false;
+      while ((time < MAX_CACHE_LEVEL || (*it)->m_streamIsBuffering) &&
+             !(*it)->m_inputBuffers->m_freeSamples.empty() &&
+             (*it)->m_processingSamples.size() < CActiveAEStream::MAX_QUEUED_BUFFERS)
       {
         buffer = (*it)->m_inputBuffers->GetFreeBuffer();
         (*it)->m_processingSamples.push_back(buffer);
-        (*it)->m_streamPort->SendInMessage(CActiveAEDataProtocol::STREAMBUFFER, &buffer, sizeof(CSampleBuffer*));
+        (*it)->m_emptyBuffers.Push(buffer);
         (*it)->IncFreeBuffers();
         time += buftime;
+        provided = true;
       }
+      if (provided)
+        (*it)->m_inMsgEvent.Set();
     }
     else
     {
@@ -1946,6 +2022,8 @@ bool CActiveAE::RunStages()
   if (m_stats.GetWaterLevel() < MAX_WATER_LEVEL &&
      (m_mode != MODE_TRANSCODE || (m_encoderBuffers && !m_encoderBuffers->m_freeSamples.empty())))
   {
+    start = std::chrono::steady_clock::now();
+
     // calculate sync error
     for (it = m_streams.begin(); it != m_streams.end(); ++it)
     {
@@ -2071,38 +2149,19 @@ bool CActiveAE::RunStages()
               nb_loops = out->pkt->nb_samples;
             }
 
-            for(int i=0; i<nb_loops; i++)
+            if (nb_loops > 1)
+            {
+              const float* gains = CalcFrameGains(*it, *out->pkt, fadingStep);
+              for (int j = 0; j < out->pkt->planes; j++)
+                CAEKernels::MulFrames((float*)out->pkt->data[j], gains, out->pkt->nb_samples,
+                                      nb_floats);
+            }
+            else
             {
-              if ((*it)->m_fadingSamples > 0)
-              {
-                (*it)->m_volume += fadingStep;
-                (*it)->m_fadingSamples--;
-
-                if ((*it)->m_fadingSamples == 0)
-                {
-                  // set variables being polled via stream interface
-                  CSingleLock lock((*it)->m_streamLock);
-                  (*it)->m_streamFading = false;
-                }
-              }
-
               // volume for stream
               float volume = (*it)->m_volume * (*it)->m_rgain;
-              if(nb_loops > 1)
-                volume *= (*it)->m_limiter.Run((float**)out->pkt->data, out->pkt->config.channels, i*nb_floats, out->pkt->planes > 1);
-
-              for(int j=0; j<out->pkt->planes; j++)
-              {
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
-#else
-                float* fbuffer = (float*) out->pkt->data[j]+i*nb_floats;
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  fbuffer[k] *= volume;
-                }
-#endif
-              }
+              for (int j = 0; j < out->pkt->planes; j++)
+                CAEKernels::Mul((float*)out->pkt->data[j], volume, nb_floats);
             }
           }
           else
@@ -2138,48 +2197,25 @@ bool CActiveAE::RunStages()
               nb_loops = out->pkt->nb_samples;
             }
 
-            for(int i=0; i<nb_loops; i++)
+            if (nb_loops > 1)
             {
-              if ((*it)->m_fadingSamples > 0)
+              const float* gains = CalcFrameGains(*it, *mix->pkt, fadingStep);
+              for (int j = 0; j < out->pkt->planes && j < mix->pkt->planes; j++)
               {
-                (*it)->m_volume += fadingStep;
-                (*it)->m_fadingSamples--;
-
-                if ((*it)->m_fadingSamples == 0)
-                {
-                  // set variables being polled via stream interface
-                  CSingleLock lock((*it)->m_streamLock);
-                  (*it)->m_streamFading = false;
-                }
+                if (CAEKernels::MulAddFrames((float*)out->pkt->data[j], (float*)mix->pkt->data[j],
+                                             gains, mix->pkt->nb_samples, nb_floats))
+                  needClamp = true;
               }
-
+            }
+            else
+            {
               // volume for stream
               float volume = (*it)->m_volume * (*it)->m_rgain;
-              if(nb_loops > 1)
-                volume *= (*it)->m_limiter.Run((float**)mix->pkt->data, mix->pkt->config.channels, i*nb_floats, mix->pkt->planes > 1);
-
-              for(int j=0; j<out->pkt->planes && j<mix->pkt->planes; j++)
+              for (int j = 0; j < out->pkt->planes && j < mix->pkt->planes; j++)
               {
-                float *dst = (float*)out->pkt->data[j]+i*nb_floats;
-                float *src = (float*)mix->pkt->data[j]+i*nb_floats;
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulAddArray(dst, src, volume, nb_floats);
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  if (fabs(dst[k]) > 1.0f)
-                  {
-                    needClamp = true;
-                    break;
-                  }
-                }
-#else
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  dst[k] += src[k] * volume;
-                  if (fabs(dst[k]) > 1.0f)
-                    needClamp = true;
-                }
-#endif
+                if (CAEKernels::MulAdd((float*)out->pkt->data[j], (float*)mix->pkt->data[j],
+                                       volume, nb_floats))
+                  needClamp = true;
               }
             }
             mix->Return();
@@ -2194,7 +2230,7 @@ bool CActiveAE::RunStages()
         int nb_floats = out->pkt->nb_samples * out->pkt->config.channels / out->pkt->planes;
         for (int i=0; i<out->pkt->planes; i++)
         {
-          CAEUtil::ClampArray((float*)out->pkt->data[i], nb_floats);
+          CAEKernels::Clamp((float*)out->pkt->data[i], nb_floats);
         }
       }
 
@@ -2285,6 +2321,7 @@ bool CActiveAE::RunStages()
         int samples = (m_mode == MODE_TRANSCODE) ? 1 : out->pkt->nb_samples;
         m_stats.AddSamples(samples, m_streams);
         m_sinkBuffers->m_inputSamples.push_back(out);
+        AddStageTime(AE_STAGE_MIX, start);
       }
     }
     // pass through
@@ -2312,7 +2349,12 @@ bool CActiveAE::RunStages()
   }
 
   // serve sink buffers
-  busy |= m_sinkBuffers->ResampleBuffers();
+  start = std::chrono::steady_clock::now();
+  if (m_sinkBuffers->ResampleBuffers())
+  {
+    busy = true;
+    AddStageTime(AE_STAGE_SINK, start);
+  }
   while(!m_sinkBuffers->m_outputSamples.empty())
   {
     CSampleBuffer *out = NULL;
@@ -2326,6 +2368,14 @@ bool CActiveAE::RunStages()
   return busy;
 }
 
+void CActiveAE::AddStageTime(AEProcessingStage stage,
+                             std::chrono::steady_clock::time_point start)
+{
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  m_stats.AddStageTime(stage,
+                       std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
 bool CActiveAE::HasWork()
 {
   if (!m_sounds_playing.empty())
@@ -2563,12 +2613,7 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
       out = (float*)dstSample.data[j];
       sample_buffer = (float*)(it->sound->GetSound(false)->data[j]+start);
       int nb_floats = mix_samples * dstSample.config.channels / dstSample.planes;
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulAddArray(out, sample_buffer, volume, nb_floats);
-#else
-      for (int k = 0; k < nb_floats; ++k)
-        *out++ += *sample_buffer++ * volume;
-#endif
+      CAEKernels::MulAdd(out, sample_buffer, volume, nb_floats);
     }
 
     it->samples_played += mix_samples;
@@ -2593,17 +2638,48 @@ void CActiveAE::Deamplify(CSoundPacket &dstSample)
     for(int j=0; j<dstSample.planes; j++)
     {
       float* buffer = reinterpret_cast<float*>(dstSample.data[j]);
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulArray(buffer, volume, nb_floats);
-#else
-      float *fbuffer = buffer;
-      for (int i = 0; i < nb_floats; i++)
-        *fbuffer++ *= volume;
-#endif
+      CAEKernels::Mul(buffer, volume, nb_floats);
     }
   }
 }
 
+const float* CActiveAE::CalcFrameGains(CActiveAEStream* stream,
+                                       const CSoundPacket& pkt,
+                                       float fadingStep)
+{
+  const int frames = pkt.nb_samples;
+  if (m_frameGains.size() < static_cast<size_t>(frames))
+  {
+    m_frameGains.resize(frames);
+    m_framePeaks.resize(frames);
+  }
+
+  for (int i = 0; i < frames; i++)
+  {
+    if (stream->m_fadingSamples > 0)
+    {
+      stream->m_volume += fadingStep;
+      stream->m_fadingSamples--;
+
+      if (stream->m_fadingSamples == 0)
+      {
+        // set variables being polled via stream interface
+        CSingleLock lock(stream->m_streamLock);
+        stream->m_streamFading = false;
+      }
+    }
+
+    // volume for stream
+    m_frameGains[i] = stream->m_volume * stream->m_rgain;
+  }
+
+  CAEKernels::FramePeaks(reinterpret_cast<const float* const*>(pkt.data), pkt.planes,
+                         pkt.config.channels, frames, m_framePeaks.data());
+  stream->m_limiter.Run(m_framePeaks.data(), m_frameGains.data(), frames);
+
+  return m_frameGains.data();
+}
+
 //-----------------------------------------------------------------------------
 // Configuration
 //-----------------------------------------------------------------------------
@@ -2637,6 +2713,9 @@ void CActiveAE::LoadSettings()
   m_settings.atempoThreshold = settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_ATEMPOTHRESHOLD) / 100.0;
   m_settings.streamNoise = settings->GetBool(CSettings::SETTING_AUDIOOUTPUT_STREAMNOISE);
   m_settings.silenceTimeout = settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_STREAMSILENCE) * 60000;
+  m_settings.streamWorkers =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioStreamWorkers;
+  m_streamWorkers.SetWorkers(m_settings.streamWorkers);
 }
 
 void CActiveAE::Start()
@@ -2904,6 +2983,11 @@ bool CActiveAE::GetCurrentSinkFormat(AEAudioFormat &SinkFormat)
   return true;
 }
 
+std::string CActiveAE::GetDebugInfo()
+{
+  return m_stats.GetStageInfo();
+}
+
 void CActiveAE::OnLostDisplay()
 {
   Message *reply;
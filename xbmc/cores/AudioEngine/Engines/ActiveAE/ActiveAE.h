@@ -9,12 +9,14 @@
 #pragma once
 
 #include "ActiveAESink.h"
+#include "ActiveAEStreamWorkers.h"
 #include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
 #include "cores/AudioEngine/Interfaces/AESound.h"
 #include "cores/AudioEngine/Interfaces/AEStream.h"
 #include "guilib/DispResource.h"
 #include "threads/Thread.h"
 
+#include <chrono>
 #include <list>
 #include <queue>
 #include <string>
@@ -60,6 +62,7 @@ struct AudioSettings
   double atempoThreshold;
   bool streamNoise;
   int silenceTimeout;
+  unsigned int streamWorkers;
 };
 
 class CActiveAEControlProtocol : public Protocol
@@ -114,14 +117,12 @@ public:
     FREESOUND,
     NEWSTREAM,
     FREESTREAM,
-    STREAMSAMPLE,
     DRAINSTREAM,
   };
   enum InSignal
   {
     ACC,
     ERR,
-    STREAMBUFFER,
     STREAMDRAINED,
   };
 };
@@ -139,12 +140,6 @@ struct MsgStreamFree
   bool finish; // if true switch back to gui sound mode
 };
 
-struct MsgStreamSample
-{
-  CSampleBuffer *buffer;
-  CActiveAEStream *stream;
-};
-
 struct MsgStreamParameter
 {
   CActiveAEStream *stream;
@@ -172,6 +167,14 @@ struct MsgStreamFFmpegInfo
   enum AVAudioServiceType audio_service_type;
 };
 
+enum AEProcessingStage
+{
+  AE_STAGE_STREAMS, // resample and tempo of input streams
+  AE_STAGE_MIX, // mixing, volume, gui sounds and encoding
+  AE_STAGE_SINK, // conversion to sink format
+  AE_STAGE_MAX
+};
+
 class CEngineStats
 {
 public:
@@ -194,6 +197,8 @@ public:
   void SetSinkLatency(float time) { m_sinkLatency = time; }
   bool IsSuspended();
   AEAudioFormat GetCurrentSinkFormat();
+  void AddStageTime(AEProcessingStage stage, int64_t us);
+  std::string GetStageInfo();
 protected:
   float m_sinkCacheTotal;
   float m_sinkLatency;
@@ -214,6 +219,16 @@ protected:
     CAESyncInfo::AESyncState m_syncState;
   };
   std::vector<StreamStats> m_streamStats;
+  struct StageStats
+  {
+    int64_t sum = 0;
+    int64_t max = 0;
+    int count = 0;
+    double lastAverage = 0;
+    int64_t lastMax = 0;
+  };
+  StageStats m_stageStats[AE_STAGE_MAX];
+  unsigned int m_stageWindowStart = 0;
 };
 
 class CActiveAE : public IAE, public IDispResource, private CThread
@@ -258,6 +273,7 @@ public:
   void DeviceChange() override;
   void DeviceCountChange(const std::string& driver) override;
   bool GetCurrentSinkFormat(AEAudioFormat &SinkFormat) override;
+  std::string GetDebugInfo() override;
 
   void RegisterAudioCallback(IAudioCallback* pCallback) override;
   void UnregisterAudioCallback(IAudioCallback* pCallback) override;
@@ -302,6 +318,7 @@ protected:
   CActiveAEStream* CreateStream(MsgStreamNew *streamMsg);
   void DiscardStream(CActiveAEStream *stream);
   void SFlushStream(CActiveAEStream *stream);
+  bool ReceiveStreamSamples();
   void FlushEngine();
   void ClearDiscardedBuffers();
   void SStopSound(CActiveAESound *sound);
@@ -309,6 +326,7 @@ protected:
   void ChangeResamplers();
 
   bool RunStages();
+  void AddStageTime(AEProcessingStage stage, std::chrono::steady_clock::time_point start);
   bool HasWork();
   CSampleBuffer* SyncStream(CActiveAEStream *stream);
 
@@ -316,6 +334,7 @@ protected:
   bool ResampleSound(CActiveAESound *sound);
   void MixSounds(CSoundPacket &dstSample);
   void Deamplify(CSoundPacket &dstSample);
+  const float* CalcFrameGains(CActiveAEStream* stream, const CSoundPacket& pkt, float fadingStep);
 
   bool CompareFormat(AEAudioFormat &lhs, AEAudioFormat &rhs);
 
@@ -350,6 +369,8 @@ protected:
   AEAudioFormat m_inputFormat;
   AudioSettings m_settings;
   CEngineStats m_stats;
+  std::vector<float> m_frameGains;
+  std::vector<float> m_framePeaks;
   IAEEncoder *m_encoder;
   std::string m_currDevice;
   std::unique_ptr<CActiveAESettings> m_settingsHandler;
@@ -363,6 +384,8 @@ protected:
 
   // streams
   std::list<CActiveAEStream*> m_streams;
+  std::vector<CActiveAEStreamBuffers*> m_activeStreamBuffers;
+  CActiveAEStreamWorkers m_streamWorkers;
   std::list<CActiveAEBufferPool*> m_discardBufferPools;
   unsigned int m_streamIdGen;
 
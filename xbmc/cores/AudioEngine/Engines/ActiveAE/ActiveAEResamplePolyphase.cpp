@@ -0,0 +1,327 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ActiveAEResamplePolyphase.h"
+
+#include "ActiveAEResampleFFMPEG.h"
+#include "cores/AudioEngine/Utils/AEKernels.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+extern "C" {
+#include <libavutil/mathematics.h>
+#include <libavutil/samplefmt.h>
+}
+
+using namespace ActiveAE;
+
+namespace
+{
+
+constexpr int FILTER_PHASES = 256;
+
+struct FilterParams
+{
+  int size; // taps at a cutoff of the full source band
+  double cutoff; // relative to the nyquist frequency of the lower rate
+  double beta; // kaiser window
+};
+
+// sizes and cutoffs follow the swresample settings in CActiveAEResampleFFMPEG
+FilterParams GetFilterParams(AEQuality quality)
+{
+  switch (quality)
+  {
+    case AE_QUALITY_REALLYHIGH:
+      return {256, 1.0, 12.0};
+    case AE_QUALITY_HIGH:
+      return {128, 0.99, 11.0};
+    case AE_QUALITY_MID:
+      return {64, 0.985, 9.0};
+    case AE_QUALITY_LOW:
+    default:
+      return {32, 0.97, 8.0};
+  }
+}
+
+double BesselI0(double x)
+{
+  double sum = 1.0;
+  double term = 1.0;
+  for (int k = 1; k < 50; k++)
+  {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+    if (term < sum * 1e-12)
+      break;
+  }
+  return sum;
+}
+
+bool IsFloat(AVSampleFormat fmt)
+{
+  return fmt == AV_SAMPLE_FMT_FLT || fmt == AV_SAMPLE_FMT_FLTP;
+}
+
+} // unnamed namespace
+
+CActiveAEResamplePolyphase::CActiveAEResamplePolyphase() = default;
+
+CActiveAEResamplePolyphase::~CActiveAEResamplePolyphase() = default;
+
+bool CActiveAEResamplePolyphase::Init(SampleConfig dstConfig,
+                                      SampleConfig srcConfig,
+                                      bool upmix,
+                                      bool normalize,
+                                      double centerMix,
+                                      CAEChannelInfo* remapLayout,
+                                      AEQuality quality,
+                                      bool force_resample)
+{
+  m_dstConfig = dstConfig;
+  m_srcConfig = srcConfig;
+  m_converter.reset(new CActiveAEResampleFFMPEG());
+
+  if (!IsFloat(dstConfig.fmt) || quality == AE_QUALITY_GPU)
+  {
+    m_passthrough = true;
+    return m_converter->Init(dstConfig, srcConfig, upmix, normalize, centerMix, remapLayout,
+                             quality, force_resample);
+  }
+
+  // convert format and channels at the source rate into planar float
+  SampleConfig convertConfig = dstConfig;
+  convertConfig.fmt = AV_SAMPLE_FMT_FLTP;
+  convertConfig.sample_rate = srcConfig.sample_rate;
+  convertConfig.bits_per_sample = 32;
+  convertConfig.dither_bits = 0;
+  if (!m_converter->Init(convertConfig, srcConfig, upmix, normalize, centerMix, remapLayout,
+                         quality, false))
+    return false;
+
+  m_passthrough = false;
+  m_planar = dstConfig.fmt == AV_SAMPLE_FMT_FLTP;
+  m_channels = dstConfig.channels;
+  m_srcRate = srcConfig.sample_rate;
+  m_dstRate = dstConfig.sample_rate;
+  m_doesResample = m_srcRate != m_dstRate || force_resample;
+
+  CreateFilter(quality);
+
+  // start with the first input sample in the center of the filter
+  m_historySize = m_taps / 2 - 1;
+  m_position = 0.0;
+  m_history.assign(m_channels, std::vector<float>(m_historySize, 0.0f));
+  m_convertPlanes.resize(m_channels);
+
+  CLog::Log(LOGDEBUG, "CActiveAEResamplePolyphase::Init - {} taps, {} -> {} Hz", m_taps, m_srcRate,
+            m_dstRate);
+  return true;
+}
+
+int CActiveAEResamplePolyphase::GetFilterTaps(AEQuality quality, int dstRate, int srcRate)
+{
+  const FilterParams params = GetFilterParams(quality);
+
+  // widen the filter by the decimation factor to keep the transition band
+  int taps = params.size;
+  if (dstRate < srcRate)
+    taps = static_cast<int>(std::ceil(static_cast<double>(taps) * srcRate / dstRate));
+
+  // multiple of 8 suits all simd kernels
+  return (taps + 7) & ~7;
+}
+
+void CActiveAEResamplePolyphase::CreateFilter(AEQuality quality)
+{
+  const FilterParams params = GetFilterParams(quality);
+
+  m_taps = GetFilterTaps(quality, m_dstRate, m_srcRate);
+  m_phases = FILTER_PHASES;
+
+  const double cutoff = params.cutoff * std::min(1.0, static_cast<double>(m_dstRate) / m_srcRate);
+  const double half = m_taps / 2;
+  const double center = half - 1.0;
+  const double norm = BesselI0(params.beta);
+
+  // one more row than phases, so the last phase can be interpolated as well
+  std::vector<float> rows((m_phases + 1) * m_taps);
+  for (int p = 0; p <= m_phases; p++)
+  {
+    float* row = rows.data() + p * m_taps;
+    const double frac = static_cast<double>(p) / m_phases;
+    double sum = 0.0;
+    for (int k = 0; k < m_taps; k++)
+    {
+      const double t = k - center - frac;
+      const double x = t * cutoff;
+      const double sinc = x == 0.0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+      const double w = t / half;
+      const double window = std::abs(w) >= 1.0 ? 0.0 : BesselI0(params.beta * std::sqrt(1.0 - w * w)) / norm;
+      row[k] = static_cast<float>(sinc * window);
+      sum += row[k];
+    }
+
+    // unity gain at DC for every phase
+    for (int k = 0; k < m_taps; k++)
+      row[k] = static_cast<float>(row[k] / sum);
+  }
+
+  m_filter.assign(rows.begin(), rows.begin() + m_phases * m_taps);
+  m_filterDelta.resize(m_phases * m_taps);
+  for (int i = 0; i < m_phases * m_taps; i++)
+    m_filterDelta[i] = rows[i + m_taps] - rows[i];
+}
+
+bool CActiveAEResamplePolyphase::AddInput(uint8_t** src_buffer, int src_samples)
+{
+  if (!src_buffer || src_samples <= 0)
+    return true;
+
+  // convert straight into the history
+  for (int i = 0; i < m_channels; i++)
+  {
+    m_history[i].resize(m_historySize + src_samples);
+    m_convertPlanes[i] = reinterpret_cast<uint8_t*>(m_history[i].data() + m_historySize);
+  }
+
+  const int converted = m_converter->Resample(m_convertPlanes.data(), src_samples, src_buffer,
+                                              src_samples, 1.0);
+  if (converted < 0)
+    return false;
+
+  m_historySize += converted;
+  return true;
+}
+
+void CActiveAEResamplePolyphase::WriteSample(uint8_t** dst_buffer,
+                                             int index,
+                                             int channel,
+                                             float value)
+{
+  if (m_planar)
+    reinterpret_cast<float*>(dst_buffer[channel])[index] = value;
+  else
+    reinterpret_cast<float*>(dst_buffer[0])[index * m_channels + channel] = value;
+}
+
+int CActiveAEResamplePolyphase::Resample(
+    uint8_t** dst_buffer, int dst_samples, uint8_t** src_buffer, int src_samples, double ratio)
+{
+  if (m_passthrough)
+    return m_converter->Resample(dst_buffer, dst_samples, src_buffer, src_samples, ratio);
+
+  if (!AddInput(src_buffer, src_samples))
+  {
+    CLog::Log(LOGERROR, "CActiveAEResamplePolyphase::Resample - converting input failed");
+    return -1;
+  }
+
+  if (ratio != 1.0)
+    m_doesResample = true;
+
+  int out = 0;
+  if (m_doesResample)
+  {
+    const double step = static_cast<double>(m_srcRate) / (m_dstRate * ratio);
+    while (out < dst_samples)
+    {
+      const int index = static_cast<int>(m_position);
+      if (index + m_taps > m_historySize)
+        break;
+
+      const double phase = (m_position - index) * m_phases;
+      const int row = std::min(static_cast<int>(phase), m_phases - 1);
+      const float frac = static_cast<float>(phase - row);
+      const float* filter = m_filter.data() + row * m_taps;
+      const float* delta = m_filterDelta.data() + row * m_taps;
+
+      for (int i = 0; i < m_channels; i++)
+      {
+        const float* x = m_history[i].data() + index;
+        const float value =
+            CAEKernels::Dot(x, filter, m_taps) + frac * CAEKernels::Dot(x, delta, m_taps);
+        WriteSample(dst_buffer, out, i, value);
+      }
+
+      m_position += step;
+      out++;
+    }
+  }
+  else
+  {
+    // same rate, output the samples in the filter center as they are so that
+    // resampling can start later on without a gap
+    const int center = static_cast<int>(m_position) + m_taps / 2 - 1;
+    out = std::min(dst_samples, m_historySize - center);
+    for (int i = 0; i < m_channels; i++)
+    {
+      const float* x = m_history[i].data() + center;
+      if (m_planar)
+        memcpy(dst_buffer[i], x, out * sizeof(float));
+      else
+      {
+        for (int j = 0; j < out; j++)
+          WriteSample(dst_buffer, j, i, x[j]);
+      }
+    }
+    m_position += out;
+  }
+
+  // drop input no longer covered by the filter window
+  const int consumed = std::min(static_cast<int>(m_position), m_historySize);
+  if (consumed > 0)
+  {
+    for (auto& history : m_history)
+      history.erase(history.begin(), history.begin() + consumed);
+    m_historySize -= consumed;
+    m_position -= consumed;
+  }
+
+  return out;
+}
+
+double CActiveAEResamplePolyphase::GetPendingSamples() const
+{
+  return std::max(0.0, m_historySize - (m_position + m_taps / 2 - 1));
+}
+
+int64_t CActiveAEResamplePolyphase::GetDelay(int64_t base)
+{
+  if (m_passthrough)
+    return m_converter->GetDelay(base);
+
+  return m_converter->GetDelay(base) +
+         static_cast<int64_t>(std::llround(GetPendingSamples() * base / m_srcRate));
+}
+
+int CActiveAEResamplePolyphase::GetBufferedSamples()
+{
+  if (m_passthrough)
+    return m_converter->GetBufferedSamples();
+
+  return static_cast<int>(std::ceil(GetPendingSamples() * m_dstRate / m_srcRate));
+}
+
+int CActiveAEResamplePolyphase::CalcDstSampleCount(int src_samples, int dst_rate, int src_rate)
+{
+  return av_rescale_rnd(src_samples, dst_rate, src_rate, AV_ROUND_UP);
+}
+
+int CActiveAEResamplePolyphase::GetSrcBufferSize(int samples)
+{
+  return av_samples_get_buffer_size(NULL, m_srcConfig.channels, samples, m_srcConfig.fmt, 1);
+}
+
+int CActiveAEResamplePolyphase::GetDstBufferSize(int samples)
+{
+  return av_samples_get_buffer_size(NULL, m_dstConfig.channels, samples, m_dstConfig.fmt, 1);
+}
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Interfaces/AEResample.h"
+
+#include <memory>
+#include <vector>
+
+namespace ActiveAE
+{
+
+class CActiveAEResampleFFMPEG;
+
+/*!
+ \brief Resampler using a windowed sinc polyphase filter bank
+
+ Sample format and channel layout conversion is left to libswresample at the
+ source rate, only the rate conversion is done here. Coefficients between two
+ phases are interpolated linearly, so the ratio can change with every call
+ without rebuilding the filter, which makes this cheap for sync to display.
+
+ Only float destination formats are handled natively, everything else is
+ passed on to CActiveAEResampleFFMPEG.
+ */
+class CActiveAEResamplePolyphase : public IAEResample
+{
+public:
+  const char* GetName() override { return "ActiveAEResamplePolyphase"; }
+  CActiveAEResamplePolyphase();
+  ~CActiveAEResamplePolyphase() override;
+  bool Init(SampleConfig dstConfig,
+            SampleConfig srcConfig,
+            bool upmix,
+            bool normalize,
+            double centerMix,
+            CAEChannelInfo* remapLayout,
+            AEQuality quality,
+            bool force_resample) override;
+  int Resample(
+      uint8_t** dst_buffer, int dst_samples, uint8_t** src_buffer, int src_samples, double ratio) override;
+  int64_t GetDelay(int64_t base) override;
+  int GetBufferedSamples() override;
+  bool WantsNewSamples(int samples) override { return GetBufferedSamples() <= samples * 2; }
+  int CalcDstSampleCount(int src_samples, int dst_rate, int src_rate) override;
+  int GetSrcBufferSize(int samples) override;
+  int GetDstBufferSize(int samples) override;
+
+  /*!
+   \brief Number of filter taps used for a quality level at the given rates
+   */
+  static int GetFilterTaps(AEQuality quality, int dstRate, int srcRate);
+
+protected:
+  void CreateFilter(AEQuality quality);
+  bool AddInput(uint8_t** src_buffer, int src_samples);
+  void WriteSample(uint8_t** dst_buffer, int index, int channel, float value);
+  double GetPendingSamples() const;
+
+  std::unique_ptr<CActiveAEResampleFFMPEG> m_converter;
+  bool m_passthrough = false;
+  bool m_doesResample = false;
+  bool m_planar = true;
+  int m_channels = 0;
+  int m_srcRate = 0;
+  int m_dstRate = 0;
+  SampleConfig m_srcConfig = {};
+  SampleConfig m_dstConfig = {};
+
+  // phase major, one row of m_taps coefficients per phase
+  int m_taps = 0;
+  int m_phases = 0;
+  std::vector<float> m_filter;
+  // difference to the next phase, used for interpolation
+  std::vector<float> m_filterDelta;
+
+  // converted input per channel, the filter window starts at m_position
+  std::vector<std::vector<float>> m_history;
+  int m_historySize = 0;
+  double m_position = 0.0;
+
+  std::vector<uint8_t*> m_convertPlanes;
+};
+
+}
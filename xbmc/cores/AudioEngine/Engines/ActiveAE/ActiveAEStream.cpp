@@ -63,22 +63,26 @@ CActiveAEStream::~CActiveAEStream()
 
 void CActiveAEStream::IncFreeBuffers()
 {
-  CSingleLock lock(m_streamLock);
   m_streamFreeBuffers++;
 }
 
 void CActiveAEStream::DecFreeBuffers()
 {
-  CSingleLock lock(m_streamLock);
   m_streamFreeBuffers--;
 }
 
 void CActiveAEStream::ResetFreeBuffers()
 {
-  CSingleLock lock(m_streamLock);
   m_streamFreeBuffers = 0;
 }
 
+void CActiveAEStream::SendBuffer(CSampleBuffer* buffer)
+{
+  // can't fail, the engine never hands out more buffers than the queue holds
+  m_filledBuffers.Push(buffer);
+  m_activeAE->m_outMsgEvent.Set();
+}
+
 void CActiveAEStream::InitRemapper()
 {
   // check if input format follows ffmpeg channel mask
@@ -224,7 +228,6 @@ int CActiveAEStream::GetErrorInterval()
 
 unsigned int CActiveAEStream::GetSpace()
 {
-  CSingleLock lock(m_streamLock);
   if (m_format.m_dataFormat == AE_FMT_RAW)
     return m_streamFreeBuffers;
   else
@@ -233,7 +236,6 @@ unsigned int CActiveAEStream::GetSpace()
 
 unsigned int CActiveAEStream::AddData(const uint8_t* const *data, unsigned int offset, unsigned int frames, ExtData *extData)
 {
-  Message *msg;
   unsigned int copied = 0;
   int sourceFrames = frames;
   const uint8_t* const *buf = data;
@@ -314,33 +316,19 @@ unsigned int CActiveAEStream::AddData(const uint8_t* const *data, unsigned int o
 
       if (m_currentBuffer->pkt->nb_samples == m_currentBuffer->pkt->max_nb_samples || rawPktComplete)
       {
-        MsgStreamSample msgData;
-        msgData.buffer = m_currentBuffer;
-        msgData.stream = this;
         RemapBuffer();
-        m_streamPort->SendOutMessage(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
+        SendBuffer(m_currentBuffer);
         m_currentBuffer = nullptr;
       }
       continue;
     }
-    else if (m_streamPort->ReceiveInMessage(&msg))
+    else if (m_emptyBuffers.Pop(m_currentBuffer))
     {
-      if (msg->signal == CActiveAEDataProtocol::STREAMBUFFER)
-      {
-        m_currentBuffer = *((CSampleBuffer**)msg->data);
-        m_currentBuffer->timestamp = 0;
-        m_currentBuffer->pkt->nb_samples = 0;
-        m_currentBuffer->pkt->pause_burst_ms = 0;
-        msg->Release();
-        DecFreeBuffers();
-        continue;
-      }
-      else
-      {
-        CLog::Log(LOGERROR, "CActiveAEStream::AddData - unknown signal");
-        msg->Release();
-        break;
-      }
+      m_currentBuffer->timestamp = 0;
+      m_currentBuffer->pkt->nb_samples = 0;
+      m_currentBuffer->pkt->pause_burst_ms = 0;
+      DecFreeBuffers();
+      continue;
     }
     if (!m_inMsgEvent.WaitMSec(200))
       break;
@@ -416,11 +404,8 @@ void CActiveAEStream::Drain(bool wait)
 
   if (m_currentBuffer)
   {
-    MsgStreamSample msgData;
-    msgData.buffer = m_currentBuffer;
-    msgData.stream = this;
     RemapBuffer();
-    m_streamPort->SendOutMessage(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
+    SendBuffer(m_currentBuffer);
     m_currentBuffer = NULL;
   }
 
@@ -430,18 +415,18 @@ void CActiveAEStream::Drain(bool wait)
   XbmcThreads::EndTime timer(2000);
   while (!timer.IsTimePast())
   {
-    if (m_streamPort->ReceiveInMessage(&msg))
+    CSampleBuffer* buffer;
+    if (m_emptyBuffers.Pop(buffer))
     {
-      if (msg->signal == CActiveAEDataProtocol::STREAMBUFFER)
-      {
-        MsgStreamSample msgData;
-        msgData.stream = this;
-        msgData.buffer = *((CSampleBuffer**)msg->data);
-        msg->Reply(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
-        DecFreeBuffers();
-        continue;
-      }
-      else if (msg->signal == CActiveAEDataProtocol::STREAMDRAINED)
+      // return unused buffers to the engine
+      buffer->pkt->nb_samples = 0;
+      SendBuffer(buffer);
+      DecFreeBuffers();
+      continue;
+    }
+    else if (m_streamPort->ReceiveInMessage(&msg))
+    {
+      if (msg->signal == CActiveAEDataProtocol::STREAMDRAINED)
       {
         msg->Release();
         return;
@@ -473,7 +458,12 @@ void CActiveAEStream::Flush()
   {
     m_currentBuffer = NULL;
     m_leftoverBytes = 0;
+    m_emptyBuffersFlushing = true;
     m_activeAE->FlushStream(this);
+    // only the consumer may pop, the engine doesn't provide new buffers until this is done
+    m_emptyBuffers.Clear();
+    m_emptyBuffersFlushing = false;
+    m_activeAE->m_outMsgEvent.Set();
     m_streamIsFlushed = true;
   }
 }
@@ -14,6 +14,7 @@
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Utils/AELimiter.h"
 #include "threads/Event.h"
+#include "threads/SPSCQueue.h"
 
 #include <atomic>
 #include <deque>
@@ -138,6 +139,7 @@ protected:
   void IncFreeBuffers();
   void DecFreeBuffers();
   void ResetFreeBuffers();
+  void SendBuffer(CSampleBuffer* buffer);
   void InitRemapper();
   void RemapBuffer();
   double CalcResampleRatio(double error);
@@ -197,7 +199,7 @@ protected:
   bool m_streamDraining;
   bool m_streamDrained;
   bool m_streamFading;
-  int m_streamFreeBuffers;
+  std::atomic_int m_streamFreeBuffers;
   bool m_streamIsBuffering;
   bool m_streamIsFlushed;
   IAEStream *m_streamSlave;
@@ -218,6 +220,13 @@ protected:
   std::deque<CSampleBuffer*> m_processingSamples;
   CActiveAEDataProtocol *m_streamPort;
   CEvent m_inMsgEvent;
+
+  // sample buffers are handed over without going through m_streamPort,
+  // the engine only provides as many buffers as the queues can hold
+  static constexpr size_t MAX_QUEUED_BUFFERS = 256;
+  CSPSCQueue<CSampleBuffer*> m_emptyBuffers{MAX_QUEUED_BUFFERS}; // engine -> stream
+  CSPSCQueue<CSampleBuffer*> m_filledBuffers{MAX_QUEUED_BUFFERS}; // stream -> engine
+  std::atomic_bool m_emptyBuffersFlushing{false}; // set by the stream while it flushes
   bool m_drain;
   bool m_paused;
   bool m_started;
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ActiveAEStreamWorkers.h"
+
+#include "ActiveAEStream.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+
+using namespace ActiveAE;
+
+CActiveAEStreamWorkers::~CActiveAEStreamWorkers()
+{
+  StopWorkers();
+}
+
+void CActiveAEStreamWorkers::SetWorkers(unsigned int count)
+{
+  if (count == m_workers.size())
+    return;
+
+  StopWorkers();
+
+  m_stop = false;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    m_workers.emplace_back(new CThread(this, "ActiveAEWorker"));
+    m_workers.back()->Create();
+  }
+
+  CLog::Log(LOGINFO, "CActiveAEStreamWorkers::{} - using {} worker threads", __FUNCTION__, count);
+}
+
+void CActiveAEStreamWorkers::StopWorkers()
+{
+  {
+    CSingleLock lock(m_lock);
+    m_stop = true;
+  }
+  m_workCond.notifyAll();
+
+  for (auto& worker : m_workers)
+    worker->StopThread(true);
+  m_workers.clear();
+}
+
+bool CActiveAEStreamWorkers::ProcessBuffers(const std::vector<CActiveAEStreamBuffers*>& streams)
+{
+  if (m_workers.empty() || streams.size() < 2)
+  {
+    bool busy = false;
+    for (auto& stream : streams)
+      busy |= stream->ProcessBuffers();
+    return busy;
+  }
+
+  {
+    CSingleLock lock(m_lock);
+    m_streams = &streams;
+    m_next = 0;
+    m_busy = false;
+    m_generation++;
+  }
+  m_workCond.notifyAll();
+
+  RunJobs();
+
+  CSingleLock lock(m_lock);
+  while (m_running > 0)
+    m_doneCond.wait(lock);
+  m_streams = nullptr;
+
+  return m_busy;
+}
+
+void CActiveAEStreamWorkers::RunJobs()
+{
+  size_t index;
+  while ((index = m_next++) < m_streams->size())
+  {
+    if ((*m_streams)[index]->ProcessBuffers())
+      m_busy = true;
+  }
+}
+
+void CActiveAEStreamWorkers::Run()
+{
+  unsigned int generation = 0;
+
+  CSingleLock lock(m_lock);
+  while (true)
+  {
+    while (!m_stop && generation == m_generation)
+      m_workCond.wait(lock);
+
+    if (m_stop)
+      return;
+
+    generation = m_generation;
+
+    // the engine thread may have done all the work already and returned
+    if (!m_streams || m_next >= m_streams->size())
+      continue;
+
+    m_running++;
+    lock.Leave();
+
+    RunJobs();
+
+    lock.Enter();
+    if (--m_running == 0)
+      m_doneCond.notifyAll();
+  }
+}
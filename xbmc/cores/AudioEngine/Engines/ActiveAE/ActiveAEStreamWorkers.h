@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/IRunnable.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class CThread;
+
+namespace ActiveAE
+{
+
+class CActiveAEStreamBuffers;
+
+/*!
+ \brief Runs the resample and tempo stages of several streams in parallel
+
+ Streams don't share any state in these stages, so each one can be processed
+ on a different thread. The engine thread takes part in the work and returns
+ once all streams are done, mixing then happens on the engine thread as before.
+ */
+class CActiveAEStreamWorkers : private IRunnable
+{
+public:
+  CActiveAEStreamWorkers() = default;
+  ~CActiveAEStreamWorkers() override;
+
+  /*!
+   \brief Sets the number of additional threads, 0 processes everything on the calling thread
+   */
+  void SetWorkers(unsigned int count);
+
+  /*!
+   \brief Calls ProcessBuffers of all given streams
+   \return true if any of the streams did some work
+   */
+  bool ProcessBuffers(const std::vector<CActiveAEStreamBuffers*>& streams);
+
+private:
+  void Run() override;
+  void RunJobs();
+  void StopWorkers();
+
+  std::vector<std::unique_ptr<CThread>> m_workers;
+
+  CCriticalSection m_lock;
+  XbmcThreads::ConditionVariable m_workCond;
+  XbmcThreads::ConditionVariable m_doneCond;
+  bool m_stop = false;
+  unsigned int m_generation = 0;
+  int m_running = 0; // workers inside RunJobs
+
+  const std::vector<CActiveAEStreamBuffers*>* m_streams = nullptr;
+  std::atomic<size_t> m_next{0};
+  std::atomic<bool> m_busy{false};
+};
+
+}
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResamplePolyphase.h"
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include <libavutil/channel_layout.h>
+}
+
+using namespace ActiveAE;
+
+namespace
+{
+
+const int CHANNELS = 2;
+const int BLOCK = 1024;
+
+SampleConfig MakeConfig(int rate)
+{
+  SampleConfig config;
+  config.fmt = AV_SAMPLE_FMT_FLTP;
+  config.channel_layout = AV_CH_LAYOUT_STEREO;
+  config.channels = CHANNELS;
+  config.sample_rate = rate;
+  config.bits_per_sample = 32;
+  config.dither_bits = 0;
+  return config;
+}
+
+/*!
+ \brief Feeds a sine through a resampler block by block
+ \return the first channel of the output
+ */
+std::vector<float> ResampleSine(ActiveAE::IAEResample& resampler,
+                                int srcRate,
+                                int dstRate,
+                                double frequency,
+                                int seconds,
+                                double ratio)
+{
+  std::vector<float> in[CHANNELS];
+  std::vector<float> out[CHANNELS];
+  const int dstBlock = resampler.CalcDstSampleCount(BLOCK, dstRate, srcRate) * 2;
+  for (int i = 0; i < CHANNELS; i++)
+  {
+    in[i].resize(BLOCK);
+    out[i].resize(dstBlock);
+  }
+  uint8_t* src[CHANNELS] = {reinterpret_cast<uint8_t*>(in[0].data()),
+                            reinterpret_cast<uint8_t*>(in[1].data())};
+  uint8_t* dst[CHANNELS] = {reinterpret_cast<uint8_t*>(out[0].data()),
+                            reinterpret_cast<uint8_t*>(out[1].data())};
+
+  std::vector<float> result;
+  int64_t n = 0;
+  for (int block = 0; block < seconds * srcRate / BLOCK; block++)
+  {
+    for (int i = 0; i < BLOCK; i++, n++)
+    {
+      const float value = static_cast<float>(0.5 * std::sin(2.0 * M_PI * frequency * n / srcRate));
+      in[0][i] = value;
+      in[1][i] = -value;
+    }
+
+    const int samples = resampler.Resample(dst, dstBlock, src, BLOCK, ratio);
+    EXPECT_GE(samples, 0);
+    result.insert(result.end(), out[0].begin(), out[0].begin() + samples);
+  }
+
+  return result;
+}
+
+/*!
+ \brief THD+N in dB of a sine with a known frequency, relative to the fundamental
+ */
+double THDN(const std::vector<float>& signal, double frequency, double rate, size_t skip)
+{
+  // least squares fit of the fundamental
+  double ss = 0, cc = 0, sc = 0, ys = 0, yc = 0;
+  for (size_t i = skip; i < signal.size(); i++)
+  {
+    const double s = std::sin(2.0 * M_PI * frequency * i / rate);
+    const double c = std::cos(2.0 * M_PI * frequency * i / rate);
+    ss += s * s;
+    cc += c * c;
+    sc += s * c;
+    ys += signal[i] * s;
+    yc += signal[i] * c;
+  }
+  const double det = ss * cc - sc * sc;
+  const double a = (ys * cc - yc * sc) / det;
+  const double b = (yc * ss - ys * sc) / det;
+
+  double fundamental = 0, residual = 0;
+  for (size_t i = skip; i < signal.size(); i++)
+  {
+    const double fit = a * std::sin(2.0 * M_PI * frequency * i / rate) +
+                       b * std::cos(2.0 * M_PI * frequency * i / rate);
+    fundamental += fit * fit;
+    residual += (signal[i] - fit) * (signal[i] - fit);
+  }
+
+  return 10.0 * std::log10(residual / fundamental);
+}
+
+} // unnamed namespace
+
+class TestActiveAEResampleQuality : public testing::TestWithParam<AEQuality>
+{
+};
+
+TEST_P(TestActiveAEResampleQuality, Upsample)
+{
+  CActiveAEResamplePolyphase resampler;
+  ASSERT_TRUE(resampler.Init(MakeConfig(48000), MakeConfig(44100), false, false, M_SQRT1_2,
+                             nullptr, GetParam(), false));
+
+  const std::vector<float> out = ResampleSine(resampler, 44100, 48000, 1000.0, 1, 1.0);
+  const int input = 44100 / BLOCK * BLOCK;
+  EXPECT_NEAR(input * 48000.0 / 44100.0, out.size() + resampler.GetBufferedSamples(), 2.0);
+
+  const double thdn = THDN(out, 1000.0, 48000.0, 1024);
+  EXPECT_LT(thdn, GetParam() == AE_QUALITY_LOW ? -60.0 : -80.0);
+}
+
+TEST_P(TestActiveAEResampleQuality, Downsample)
+{
+  CActiveAEResamplePolyphase resampler;
+  ASSERT_TRUE(resampler.Init(MakeConfig(44100), MakeConfig(96000), false, false, M_SQRT1_2,
+                             nullptr, GetParam(), false));
+
+  const std::vector<float> out = ResampleSine(resampler, 96000, 44100, 5000.0, 1, 1.0);
+  const double thdn = THDN(out, 5000.0, 44100.0, 1024);
+  EXPECT_LT(thdn, GetParam() == AE_QUALITY_LOW ? -60.0 : -80.0);
+}
+
+TEST_P(TestActiveAEResampleQuality, VariableRatio)
+{
+  CActiveAEResamplePolyphase resampler;
+  ASSERT_TRUE(resampler.Init(MakeConfig(48000), MakeConfig(48000), false, false, M_SQRT1_2,
+                             nullptr, GetParam(), false));
+
+  // starts without resampling and switches over seamlessly
+  std::vector<float> out = ResampleSine(resampler, 48000, 48000, 1000.0, 1, 1.0);
+  EXPECT_EQ(48000 / BLOCK * BLOCK, static_cast<int>(out.size()) + resampler.GetBufferedSamples());
+
+  resampler.Init(MakeConfig(48000), MakeConfig(48000), false, false, M_SQRT1_2, nullptr,
+                 GetParam(), false);
+  const double ratio = 1.002;
+  out = ResampleSine(resampler, 48000, 48000, 1000.0, 1, ratio);
+  EXPECT_NEAR(48000 / BLOCK * BLOCK * ratio, out.size() + resampler.GetBufferedSamples(), 2.0);
+
+  const double thdn = THDN(out, 1000.0 / ratio, 48000.0, 1024);
+  EXPECT_LT(thdn, GetParam() == AE_QUALITY_LOW ? -60.0 : -80.0);
+}
+
+TEST(TestActiveAEResamplePolyphase, SameRateIsExact)
+{
+  CActiveAEResamplePolyphase resampler;
+  ASSERT_TRUE(resampler.Init(MakeConfig(48000), MakeConfig(48000), false, false, M_SQRT1_2,
+                             nullptr, AE_QUALITY_MID, false));
+
+  float in[CHANNELS][BLOCK];
+  float out[CHANNELS][BLOCK];
+  for (int i = 0; i < BLOCK; i++)
+  {
+    in[0][i] = i / static_cast<float>(BLOCK);
+    in[1][i] = -in[0][i];
+  }
+  uint8_t* src[CHANNELS] = {reinterpret_cast<uint8_t*>(in[0]), reinterpret_cast<uint8_t*>(in[1])};
+  uint8_t* dst[CHANNELS] = {reinterpret_cast<uint8_t*>(out[0]),
+                            reinterpret_cast<uint8_t*>(out[1])};
+
+  ASSERT_EQ(BLOCK, resampler.Resample(dst, BLOCK, src, BLOCK, 1.0));
+  for (int i = 0; i < BLOCK; i++)
+  {
+    EXPECT_EQ(in[0][i], out[0][i]);
+    EXPECT_EQ(in[1][i], out[1][i]);
+  }
+  EXPECT_EQ(0, resampler.GetBufferedSamples());
+}
+
+INSTANTIATE_TEST_SUITE_P(Quality,
+                         TestActiveAEResampleQuality,
+                         testing::Values(AE_QUALITY_LOW, AE_QUALITY_MID, AE_QUALITY_HIGH));
@@ -234,4 +234,11 @@ public:
    * @return Returns true on success, else false.
    */
   virtual bool GetCurrentSinkFormat(AEAudioFormat &SinkFormat) { return false; }
+
+  /**
+   * Get processing statistics of the engine for debug overlays
+   *
+   * @return Returns a single line of text, empty if not supported
+   */
+  virtual std::string GetDebugInfo() { return ""; }
 };
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+// the kernels are compiled for AVX2 by function attributes, the rest of this file is not.
+// MSVC allows AVX2 intrinsics without special flags.
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define AE_KERNELS_AVX2
+
+#include <immintrin.h>
+#include <math.h>
+
+// after all system headers, their inline functions must not be built for AVX2
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "AEKernelsImpl.h"
+
+namespace
+{
+
+struct AVX2Ops
+{
+  using Type = __m256;
+  static constexpr unsigned int WIDTH = 8;
+
+  static Type Load(const float* p) { return _mm256_loadu_ps(p); }
+  static void Store(float* p, Type v) { _mm256_storeu_ps(p, v); }
+  static Type Set(float v) { return _mm256_set1_ps(v); }
+  static Type Add(Type a, Type b) { return _mm256_add_ps(a, b); }
+  static Type Mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+  static Type Div(Type a, Type b) { return _mm256_div_ps(a, b); }
+  static Type Min(Type a, Type b) { return _mm256_min_ps(a, b); }
+  static Type Max(Type a, Type b) { return _mm256_max_ps(a, b); }
+  static Type Abs(Type v) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v); }
+  static bool AnyGreater(Type a, Type b)
+  {
+    return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)) != 0;
+  }
+};
+
+constexpr CAEKernels::Table avx2Table = MakeTable<AVX2Ops>(CAEKernels::Implementation::AVX2);
+
+} // unnamed namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
+
+const CAEKernels::Table* CAEKernels::GetAVX2Table()
+{
+#if defined(AE_KERNELS_AVX2)
+  return &avx2Table;
+#else
+  return nullptr;
+#endif
+}
@@ -0,0 +1,219 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#include "AEKernelsImpl.h"
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <atomic>
+
+namespace
+{
+
+struct ScalarOps
+{
+  using Type = float;
+  static constexpr unsigned int WIDTH = 1;
+
+  static Type Load(const float* p) { return *p; }
+  static void Store(float* p, Type v) { *p = v; }
+  static Type Set(float v) { return v; }
+  static Type Add(Type a, Type b) { return a + b; }
+  static Type Mul(Type a, Type b) { return a * b; }
+  static Type Div(Type a, Type b) { return a / b; }
+  static Type Min(Type a, Type b) { return a < b ? a : b; }
+  static Type Max(Type a, Type b) { return a > b ? a : b; }
+  static Type Abs(Type v) { return fabsf(v); }
+  static bool AnyGreater(Type a, Type b) { return a > b; }
+};
+
+constexpr CAEKernels::Table genericTable = MakeTable<ScalarOps>(CAEKernels::Implementation::GENERIC);
+
+std::atomic<const CAEKernels::Table*> currentTable{nullptr};
+
+unsigned int GetCPUFeatures()
+{
+  std::shared_ptr<CCPUInfo> cpuInfo = CServiceBroker::GetCPUInfo();
+  if (!cpuInfo)
+    return 0;
+
+  unsigned int features = cpuInfo->GetCPUFeatures();
+#if defined(__aarch64__)
+  // NEON is mandatory on aarch64
+  features |= CPU_FEATURE_NEON;
+#endif
+  return features;
+}
+
+bool IsSupported(CAEKernels::Implementation implementation, unsigned int features)
+{
+  switch (implementation)
+  {
+    case CAEKernels::Implementation::SSE2:
+      return (features & CPU_FEATURE_SSE2) == CPU_FEATURE_SSE2;
+    case CAEKernels::Implementation::AVX2:
+      return (features & CPU_FEATURE_AVX2) == CPU_FEATURE_AVX2;
+    case CAEKernels::Implementation::NEON:
+      return (features & CPU_FEATURE_NEON) == CPU_FEATURE_NEON;
+    case CAEKernels::Implementation::GENERIC:
+    default:
+      return true;
+  }
+}
+
+} // unnamed namespace
+
+void CAEKernels::MulFrames(float* data,
+                           const float* gains,
+                           unsigned int frames,
+                           unsigned int channels)
+{
+  if (channels == 1)
+  {
+    Get().mulVector(data, gains, frames);
+    return;
+  }
+
+  for (unsigned int i = 0; i < frames; i++, data += channels)
+  {
+    for (unsigned int j = 0; j < channels; j++)
+      data[j] *= gains[i];
+  }
+}
+
+bool CAEKernels::MulAddFrames(float* dst,
+                              const float* src,
+                              const float* gains,
+                              unsigned int frames,
+                              unsigned int channels)
+{
+  if (channels == 1)
+    return Get().mulAddVector(dst, src, gains, frames);
+
+  bool clip = false;
+  for (unsigned int i = 0; i < frames; i++, dst += channels, src += channels)
+  {
+    for (unsigned int j = 0; j < channels; j++)
+    {
+      dst[j] += src[j] * gains[i];
+      clip |= fabsf(dst[j]) > 1.0f;
+    }
+  }
+
+  return clip;
+}
+
+void CAEKernels::FramePeaks(const float* const* planes,
+                            unsigned int planeCount,
+                            unsigned int channels,
+                            unsigned int frames,
+                            float* peaks)
+{
+  for (unsigned int i = 0; i < frames; i++)
+    peaks[i] = 0.0f;
+
+  const unsigned int channelsPerPlane = channels / planeCount;
+  if (channelsPerPlane == 1)
+  {
+    for (unsigned int i = 0; i < planeCount; i++)
+      Get().absMax(peaks, planes[i], frames);
+    return;
+  }
+
+  for (unsigned int i = 0; i < planeCount; i++)
+  {
+    const float* data = planes[i];
+    for (unsigned int j = 0; j < frames; j++)
+    {
+      for (unsigned int k = 0; k < channelsPerPlane; k++, data++)
+      {
+        const float value = fabsf(*data);
+        if (value > peaks[j])
+          peaks[j] = value;
+      }
+    }
+  }
+}
+
+const char* CAEKernels::GetImplementationName(Implementation implementation)
+{
+  switch (implementation)
+  {
+    case Implementation::SSE2:
+      return "SSE2";
+    case Implementation::AVX2:
+      return "AVX2";
+    case Implementation::NEON:
+      return "NEON";
+    case Implementation::GENERIC:
+    default:
+      return "generic";
+  }
+}
+
+const CAEKernels::Table* CAEKernels::GetTable(Implementation implementation)
+{
+  switch (implementation)
+  {
+    case Implementation::SSE2:
+      return GetSSE2Table();
+    case Implementation::AVX2:
+      return GetAVX2Table();
+    case Implementation::NEON:
+      return GetNEONTable();
+    case Implementation::GENERIC:
+    default:
+      return &genericTable;
+  }
+}
+
+bool CAEKernels::IsAvailable(Implementation implementation)
+{
+  return GetTable(implementation) && IsSupported(implementation, GetCPUFeatures());
+}
+
+bool CAEKernels::SetImplementation(Implementation implementation)
+{
+  if (!IsAvailable(implementation))
+    return false;
+
+  currentTable = GetTable(implementation);
+  return true;
+}
+
+const CAEKernels::Table& CAEKernels::Get()
+{
+  const Table* table = currentTable.load(std::memory_order_acquire);
+  if (table)
+    return *table;
+
+  // without CPU information (e.g. during startup) stick to the generic
+  // kernels and try again on the next call
+  const unsigned int features = GetCPUFeatures();
+  if (!features)
+    return genericTable;
+
+  table = &genericTable;
+  for (Implementation implementation :
+       {Implementation::AVX2, Implementation::SSE2, Implementation::NEON})
+  {
+    const Table* candidate = GetTable(implementation);
+    if (candidate && IsSupported(implementation, features))
+    {
+      table = candidate;
+      break;
+    }
+  }
+
+  CLog::Log(LOGINFO, "CAEKernels: using {} kernels", GetImplementationName(table->implementation));
+  currentTable = table;
+  return *table;
+}
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+/*!
+ \brief Float kernels used for mixing, volume, clamping and resampling in ActiveAE.
+
+ Every kernel exists in a plain C++ version and in SSE2, AVX2 and NEON
+ versions where the build supports them. The fastest version the CPU
+ supports (as reported by CCPUInfo) is picked on first use.
+ */
+class CAEKernels
+{
+public:
+  enum class Implementation
+  {
+    GENERIC,
+    SSE2,
+    AVX2,
+    NEON
+  };
+
+  struct Table
+  {
+    Implementation implementation;
+    //! data[i] *= gain
+    void (*mul)(float* data, float gain, unsigned int count);
+    //! dst[i] += src[i] * gain, returns true if any |dst[i]| > 1
+    bool (*mulAdd)(float* dst, const float* src, float gain, unsigned int count);
+    //! data[i] *= gains[i]
+    void (*mulVector)(float* data, const float* gains, unsigned int count);
+    //! dst[i] += src[i] * gains[i], returns true if any |dst[i]| > 1
+    bool (*mulAddVector)(float* dst, const float* src, const float* gains, unsigned int count);
+    //! peaks[i] = max(peaks[i], |src[i]|)
+    void (*absMax)(float* peaks, const float* src, unsigned int count);
+    //! soft clamps data to -1..1 (see CAEUtil::SoftClamp)
+    void (*clamp)(float* data, unsigned int count);
+    //! returns the sum of a[i] * b[i]
+    float (*dot)(const float* a, const float* b, unsigned int count);
+  };
+
+  static void Mul(float* data, float gain, unsigned int count) { Get().mul(data, gain, count); }
+
+  static bool MulAdd(float* dst, const float* src, float gain, unsigned int count)
+  {
+    return Get().mulAdd(dst, src, gain, count);
+  }
+
+  static void Clamp(float* data, unsigned int count) { Get().clamp(data, count); }
+
+  static float Dot(const float* a, const float* b, unsigned int count)
+  {
+    return Get().dot(a, b, count);
+  }
+
+  /*!
+   \brief Applies a gain per frame to a plane of interleaved samples
+   \param data the plane
+   \param gains one gain per frame
+   \param frames number of frames in the plane
+   \param channels number of channels in the plane (1 for planar formats)
+   */
+  static void MulFrames(float* data, const float* gains, unsigned int frames, unsigned int channels);
+
+  /*!
+   \brief Mixes a plane into another one applying a gain per frame
+   \return true if any of the mixed samples exceeds -1..1
+   \sa MulFrames
+   */
+  static bool MulAddFrames(float* dst,
+                           const float* src,
+                           const float* gains,
+                           unsigned int frames,
+                           unsigned int channels);
+
+  /*!
+   \brief Gets the highest absolute sample value of every frame
+   \param planes the planes of the packet
+   \param planeCount number of planes
+   \param channels number of channels of the packet
+   \param frames number of frames
+   \param peaks receives one value per frame
+   */
+  static void FramePeaks(const float* const* planes,
+                         unsigned int planeCount,
+                         unsigned int channels,
+                         unsigned int frames,
+                         float* peaks);
+
+  static Implementation GetImplementation() { return Get().implementation; }
+  static const char* GetImplementationName(Implementation implementation);
+
+  /*!
+   \brief Checks if an implementation is part of this build and supported by the CPU
+   */
+  static bool IsAvailable(Implementation implementation);
+
+  /*!
+   \brief Forces a specific implementation, used by tests and benchmarks
+   \return false if the implementation is not available in this build or on this CPU
+   */
+  static bool SetImplementation(Implementation implementation);
+
+  /*!
+   \brief Returns the table of an implementation
+   \return nullptr if the implementation is not available in this build
+   */
+  static const Table* GetTable(Implementation implementation);
+
+private:
+  static const Table& Get();
+
+  // implemented in AEKernels.<instruction set>.cpp, nullptr if not part of the build
+  static const Table* GetSSE2Table();
+  static const Table* GetAVX2Table();
+  static const Table* GetNEONTable();
+};
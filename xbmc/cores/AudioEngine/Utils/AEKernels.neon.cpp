@@ -0,0 +1,66 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define AE_KERNELS_NEON
+
+#include "AEKernelsImpl.h"
+
+#include <arm_neon.h>
+
+namespace
+{
+
+struct NEONOps
+{
+  using Type = float32x4_t;
+  static constexpr unsigned int WIDTH = 4;
+
+  static Type Load(const float* p) { return vld1q_f32(p); }
+  static void Store(float* p, Type v) { vst1q_f32(p, v); }
+  static Type Set(float v) { return vdupq_n_f32(v); }
+  static Type Add(Type a, Type b) { return vaddq_f32(a, b); }
+  static Type Mul(Type a, Type b) { return vmulq_f32(a, b); }
+  static Type Div(Type a, Type b)
+  {
+#if defined(__aarch64__)
+    return vdivq_f32(a, b);
+#else
+    // armv7 has no vector division, refine the reciprocal estimate twice
+    Type r = vrecpeq_f32(b);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    return vmulq_f32(a, r);
+#endif
+  }
+  static Type Min(Type a, Type b) { return vminq_f32(a, b); }
+  static Type Max(Type a, Type b) { return vmaxq_f32(a, b); }
+  static Type Abs(Type v) { return vabsq_f32(v); }
+  static bool AnyGreater(Type a, Type b)
+  {
+    const uint32x4_t mask = vcgtq_f32(a, b);
+    const uint32x2_t half = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+    return (vget_lane_u32(half, 0) | vget_lane_u32(half, 1)) != 0;
+  }
+};
+
+constexpr CAEKernels::Table neonTable = MakeTable<NEONOps>(CAEKernels::Implementation::NEON);
+
+} // unnamed namespace
+#endif
+
+const CAEKernels::Table* CAEKernels::GetNEONTable()
+{
+#if defined(AE_KERNELS_NEON)
+  return &neonTable;
+#else
+  return nullptr;
+#endif
+}
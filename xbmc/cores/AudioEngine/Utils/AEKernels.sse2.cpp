@@ -0,0 +1,50 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AE_KERNELS_SSE2
+
+#include "AEKernelsImpl.h"
+
+#include <emmintrin.h>
+
+namespace
+{
+
+struct SSE2Ops
+{
+  using Type = __m128;
+  static constexpr unsigned int WIDTH = 4;
+
+  static Type Load(const float* p) { return _mm_loadu_ps(p); }
+  static void Store(float* p, Type v) { _mm_storeu_ps(p, v); }
+  static Type Set(float v) { return _mm_set1_ps(v); }
+  static Type Add(Type a, Type b) { return _mm_add_ps(a, b); }
+  static Type Mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+  static Type Div(Type a, Type b) { return _mm_div_ps(a, b); }
+  static Type Min(Type a, Type b) { return _mm_min_ps(a, b); }
+  static Type Max(Type a, Type b) { return _mm_max_ps(a, b); }
+  static Type Abs(Type v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+  static bool AnyGreater(Type a, Type b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)) != 0; }
+};
+
+constexpr CAEKernels::Table sse2Table = MakeTable<SSE2Ops>(CAEKernels::Implementation::SSE2);
+
+} // unnamed namespace
+#endif
+
+const CAEKernels::Table* CAEKernels::GetSSE2Table()
+{
+#if defined(AE_KERNELS_SSE2)
+  return &sse2Table;
+#else
+  return nullptr;
+#endif
+}
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+// Only to be included by the AEKernels*.cpp files
+
+#include "AEKernels.h"
+
+#include <math.h>
+
+/*
+ * The kernels are written once against a small set of vector operations
+ * and instantiated for every instruction set in its own translation unit
+ * which enables the instruction set for them.
+ *
+ * Everything here lives in an anonymous namespace so the linker can't
+ * merge a copy built for one instruction set into another translation
+ * unit. For the same reason no STL templates must be used in here.
+ */
+namespace
+{
+
+inline float SoftClamp(float x)
+{
+  // see CAEUtil::SoftClamp
+  x = x < -3.0f ? -3.0f : (x > 3.0f ? 3.0f : x);
+  const float y = x * x;
+  return x * (27.0f + y) / (27.0f + 9.0f * y);
+}
+
+template<typename V>
+void Mul(float* data, float gain, unsigned int count)
+{
+  const typename V::Type g = V::Set(gain);
+
+  unsigned int i = 0;
+  for (; i + V::WIDTH <= count; i += V::WIDTH)
+    V::Store(data + i, V::Mul(V::Load(data + i), g));
+
+  for (; i < count; i++)
+    data[i] *= gain;
+}
+
+template<typename V>
+bool MulAdd(float* dst, const float* src, float gain, unsigned int count)
+{
+  const typename V::Type g = V::Set(gain);
+  typename V::Type peak = V::Set(0.0f);
+
+  unsigned int i = 0;
+  for (; i + V::WIDTH <= count; i += V::WIDTH)
+  {
+    const typename V::Type out = V::Add(V::Load(dst + i), V::Mul(V::Load(src + i), g));
+    peak = V::Max(peak, V::Abs(out));
+    V::Store(dst + i, out);
+  }
+
+  bool clip = V::AnyGreater(peak, V::Set(1.0f));
+  for (; i < count; i++)
+  {
+    dst[i] += src[i] * gain;
+    clip |= fabsf(dst[i]) > 1.0f;
+  }
+
+  return clip;
+}
+
+template<typename V>
+void MulVector(float* data, const float* gains, unsigned int count)
+{
+  unsigned int i = 0;
+  for (; i + V::WIDTH <= count; i += V::WIDTH)
+    V::Store(data + i, V::Mul(V::Load(data + i), V::Load(gains + i)));
+
+  for (; i < count; i++)
+    data[i] *= gains[i];
+}
+
+template<typename V>
+bool MulAddVector(float* dst, const float* src, const float* gains, unsigned int count)
+{
+  typename V::Type peak = V::Set(0.0f);
+
+  unsigned int i = 0;
+  for (; i + V::WIDTH <= count; i += V::WIDTH)
+  {
+    const typename V::Type out =
+        V::Add(V::Load(dst + i), V::Mul(V::Load(src + i), V::Load(gains + i)));
+    peak = V::Max(peak, V::Abs(out));
+    V::Store(dst + i, out);
+  }
+
+  bool clip = V::AnyGreater(peak, V::Set(1.0f));
+  for (; i < count; i++)
+  {
+    dst[i] += src[i] * gains[i];
+    clip |= fabsf(dst[i]) > 1.0f;
+  }
+
+  return clip;
+}
+
+template<typename V>
+void AbsMax(float* peaks, const float* src, unsigned int count)
+{
+  unsigned int i = 0;
+  for (; i + V::WIDTH <= count; i += V::WIDTH)
+    V::Store(peaks + i, V::Max(V::Load(peaks + i), V::Abs(V::Load(src + i))));
+
+  for (; i < count; i++)
+  {
+    const float value = fabsf(src[i]);
+    if (value > peaks[i])
+      peaks[i] = value;
+  }
+}
+
+template<typename V>
+void Clamp(float* data, unsigned int count)
+{
+  const typename V::Type low = V::Set(-3.0f);
+  const typename V::Type high = V::Set(3.0f);
+  const typename V::Type c1 = V::Set(27.0f);
+  const typename V::Type c2 = V::Set(9.0f);
+
+  unsigned int i = 0;
+  for (; i + V::WIDTH <= count; i += V::WIDTH)
+  {
+    const typename V::Type x = V::Min(V::Max(V::Load(data + i), low), high);
+    const typename V::Type y = V::Mul(x, x);
+    V::Store(data + i, V::Div(V::Mul(x, V::Add(c1, y)), V::Add(c1, V::Mul(c2, y))));
+  }
+
+  for (; i < count; i++)
+    data[i] = SoftClamp(data[i]);
+}
+
+template<typename V>
+float Dot(const float* a, const float* b, unsigned int count)
+{
+  typename V::Type sum = V::Set(0.0f);
+
+  unsigned int i = 0;
+  for (; i + V::WIDTH <= count; i += V::WIDTH)
+    sum = V::Add(sum, V::Mul(V::Load(a + i), V::Load(b + i)));
+
+  float lanes[V::WIDTH];
+  V::Store(lanes, sum);
+  float result = 0.0f;
+  for (unsigned int j = 0; j < V::WIDTH; j++)
+    result += lanes[j];
+
+  for (; i < count; i++)
+    result += a[i] * b[i];
+
+  return result;
+}
+
+// constexpr, the tables must not need code running at load time. that code could use
+// instructions the cpu doesn't support.
+template<typename V>
+constexpr CAEKernels::Table MakeTable(CAEKernels::Implementation implementation)
+{
+  return {implementation, Mul<V>,   MulAdd<V>, MulVector<V>, MulAddVector<V>,
+          AbsMax<V>,      Clamp<V>, Dot<V>};
+}
+
+} // unnamed namespace
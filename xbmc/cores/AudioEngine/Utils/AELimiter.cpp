@@ -43,12 +43,30 @@ float CAELimiter::Run(float* frame[AE_CH_MAX], int channels, int offset /*= 0*/,
     }
   }
 
+  const std::shared_ptr<CAdvancedSettings> settings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  return Step(highest, settings->m_limiterHold, settings->m_limiterRelease);
+}
+
+void CAELimiter::Run(const float* peaks, float* gains, int frames)
+{
+  const std::shared_ptr<CAdvancedSettings> settings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const float hold = settings->m_limiterHold;
+  const float release = settings->m_limiterRelease;
+
+  for (int i = 0; i < frames; i++)
+    gains[i] *= Step(peaks[i], hold, release);
+}
+
+float CAELimiter::Step(float highest, float hold, float release)
+{
   float sample = highest * m_amplify;
   if (sample * m_attenuation > 1.0f)
   {
     m_attenuation = 1.0f / sample;
-    m_holdcounter = MathUtils::round_int(m_samplerate * CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_limiterHold);
-    m_increase = powf(std::min(sample, 10000.0f), 1.0f / (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_limiterRelease * m_samplerate));
+    m_holdcounter = MathUtils::round_int(m_samplerate * hold);
+    m_increase = powf(std::min(sample, 10000.0f), 1.0f / (release * m_samplerate));
   }
 
   float attenuation = m_attenuation;
@@ -21,6 +21,8 @@ class CAELimiter
     int   m_holdcounter;
     float m_increase;
 
+    float Step(float highest, float hold, float release);
+
   public:
     CAELimiter();
 
@@ -40,4 +42,12 @@ class CAELimiter
     }
 
     float Run(float* frame[AE_CH_MAX], int channels, int offset = 0, bool planar = false);
+
+    /*!
+     \brief Runs the limiter over a whole packet
+     \param peaks highest absolute sample value of every frame
+     \param gains gain of every frame, gets multiplied with the limiter gain
+     \param frames number of frames
+     */
+    void Run(const float* peaks, float* gains, int frames);
 };
@@ -0,0 +1,200 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "cores/AudioEngine/Utils/AEKernels.h"
+#include "utils/CPUInfo.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+const CAEKernels::Implementation implementations[] = {
+    CAEKernels::Implementation::SSE2, CAEKernels::Implementation::AVX2,
+    CAEKernels::Implementation::NEON};
+
+std::vector<float> RandomSamples(unsigned int count, float range, unsigned int seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<float> distribution(-range, range);
+  std::vector<float> samples(count);
+  for (auto& sample : samples)
+    sample = distribution(generator);
+  return samples;
+}
+
+void ExpectNear(const std::vector<float>& expected, const std::vector<float>& actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++)
+    EXPECT_NEAR(expected[i], actual[i], 1e-5f) << "at index " << i;
+}
+
+} // unnamed namespace
+
+class TestAEKernels : public testing::TestWithParam<CAEKernels::Implementation>
+{
+protected:
+  TestAEKernels() { CServiceBroker::RegisterCPUInfo(CCPUInfo::GetCPUInfo()); }
+
+  ~TestAEKernels() override { CServiceBroker::UnregisterCPUInfo(); }
+
+  void SetUp() override
+  {
+    if (!CAEKernels::IsAvailable(GetParam()))
+      GTEST_SKIP() << CAEKernels::GetImplementationName(GetParam()) << " not available";
+
+    m_table = CAEKernels::GetTable(GetParam());
+    m_generic = CAEKernels::GetTable(CAEKernels::Implementation::GENERIC);
+  }
+
+  const CAEKernels::Table* m_table = nullptr;
+  const CAEKernels::Table* m_generic = nullptr;
+};
+
+TEST_P(TestAEKernels, Mul)
+{
+  // odd sizes and offsets to cover tails and unaligned buffers
+  for (unsigned int count : {0u, 1u, 3u, 7u, 16u, 33u, 1031u})
+  {
+    std::vector<float> expected = RandomSamples(count + 1, 1.0f, count);
+    std::vector<float> actual = expected;
+    m_generic->mul(expected.data() + 1, 0.7f, count);
+    m_table->mul(actual.data() + 1, 0.7f, count);
+    ExpectNear(expected, actual);
+  }
+}
+
+TEST_P(TestAEKernels, MulAdd)
+{
+  for (unsigned int count : {0u, 1u, 5u, 9u, 17u, 1029u})
+  {
+    const std::vector<float> src = RandomSamples(count, 1.0f, count);
+    std::vector<float> expected = RandomSamples(count, 0.4f, count + 1);
+    std::vector<float> actual = expected;
+    EXPECT_FALSE(m_generic->mulAdd(expected.data(), src.data(), 0.5f, count));
+    EXPECT_FALSE(m_table->mulAdd(actual.data(), src.data(), 0.5f, count));
+    ExpectNear(expected, actual);
+
+    if (count)
+    {
+      // a single sample out of range has to be reported
+      std::vector<float> clipped = actual;
+      std::vector<float> zero(count, 0.0f);
+      clipped[count / 2] = 1.5f;
+      EXPECT_TRUE(m_table->mulAdd(clipped.data(), zero.data(), 1.0f, count));
+    }
+  }
+}
+
+TEST_P(TestAEKernels, MulVector)
+{
+  for (unsigned int count : {1u, 6u, 15u, 64u, 1027u})
+  {
+    const std::vector<float> gains = RandomSamples(count, 1.0f, count + 2);
+    const std::vector<float> src = RandomSamples(count, 1.0f, count + 3);
+    std::vector<float> expected = RandomSamples(count, 1.0f, count);
+    std::vector<float> actual = expected;
+
+    m_generic->mulVector(expected.data(), gains.data(), count);
+    m_table->mulVector(actual.data(), gains.data(), count);
+    ExpectNear(expected, actual);
+
+    EXPECT_EQ(m_generic->mulAddVector(expected.data(), src.data(), gains.data(), count),
+              m_table->mulAddVector(actual.data(), src.data(), gains.data(), count));
+    ExpectNear(expected, actual);
+  }
+}
+
+TEST_P(TestAEKernels, AbsMax)
+{
+  for (unsigned int count : {1u, 7u, 8u, 13u, 1025u})
+  {
+    const std::vector<float> src = RandomSamples(count, 2.0f, count);
+    std::vector<float> expected = RandomSamples(count, 1.0f, count + 1);
+    for (auto& peak : expected)
+      peak = std::abs(peak);
+    std::vector<float> actual = expected;
+
+    m_generic->absMax(expected.data(), src.data(), count);
+    m_table->absMax(actual.data(), src.data(), count);
+    ExpectNear(expected, actual);
+  }
+}
+
+TEST_P(TestAEKernels, Clamp)
+{
+  for (unsigned int count : {1u, 3u, 12u, 31u, 1024u})
+  {
+    std::vector<float> expected = RandomSamples(count, 5.0f, count);
+    std::vector<float> actual = expected;
+
+    m_generic->clamp(expected.data(), count);
+    m_table->clamp(actual.data(), count);
+    ExpectNear(expected, actual);
+
+    for (float sample : actual)
+    {
+      EXPECT_LE(sample, 1.0f);
+      EXPECT_GE(sample, -1.0f);
+    }
+  }
+}
+
+TEST_P(TestAEKernels, Dot)
+{
+  for (unsigned int count : {0u, 1u, 4u, 11u, 32u, 257u})
+  {
+    const std::vector<float> a = RandomSamples(count, 1.0f, count);
+    const std::vector<float> b = RandomSamples(count, 1.0f, count + 1);
+    EXPECT_NEAR(m_generic->dot(a.data(), b.data(), count), m_table->dot(a.data(), b.data(), count),
+                1e-4f);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Implementations, TestAEKernels, testing::ValuesIn(implementations));
+
+TEST(TestAEKernelsFrames, MulFramesInterleaved)
+{
+  const unsigned int frames = 5;
+  const unsigned int channels = 3;
+  std::vector<float> data(frames * channels, 1.0f);
+  const float gains[frames] = {0.0f, 0.25f, 0.5f, 0.75f, 1.0f};
+
+  CAEKernels::MulFrames(data.data(), gains, frames, channels);
+  for (unsigned int i = 0; i < frames; i++)
+  {
+    for (unsigned int j = 0; j < channels; j++)
+      EXPECT_FLOAT_EQ(gains[i], data[i * channels + j]);
+  }
+}
+
+TEST(TestAEKernelsFrames, FramePeaks)
+{
+  const unsigned int frames = 4;
+  const float left[frames] = {0.1f, -0.9f, 0.3f, 0.0f};
+  const float right[frames] = {-0.2f, 0.5f, -0.4f, 0.0f};
+  const float interleaved[frames * 2] = {0.1f, -0.2f, -0.9f, 0.5f, 0.3f, -0.4f, 0.0f, 0.0f};
+  const float expected[frames] = {0.2f, 0.9f, 0.4f, 0.0f};
+  float peaks[frames];
+
+  const float* planes[] = {left, right};
+  CAEKernels::FramePeaks(planes, 2, 2, frames, peaks);
+  for (unsigned int i = 0; i < frames; i++)
+    EXPECT_FLOAT_EQ(expected[i], peaks[i]);
+
+  const float* packed[] = {interleaved};
+  CAEKernels::FramePeaks(packed, 1, 2, frames, peaks);
+  for (unsigned int i = 0; i < frames; i++)
+    EXPECT_FLOAT_EQ(expected[i], peaks[i]);
+}
@@ -42,6 +42,7 @@ void CDataCacheCore::Reset()
     m_stateInfo.m_renderGuiLayer = false;
     m_stateInfo.m_renderVideoLayer = false;
     m_playerStateChanged = false;
+    m_timeInfo.m_timeToFirstFrame = 0;
   }
 
   {
@@ -111,6 +112,20 @@ std::string CDataCacheCore::GetVideoDeintMethod()
   return m_playerVideoInfo.deintMethod;
 }
 
+void CDataCacheCore::SetVideoDecoderThreads(std::string threads)
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  m_playerVideoInfo.decoderThreads = std::move(threads);
+}
+
+std::string CDataCacheCore::GetVideoDecoderThreads()
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  return m_playerVideoInfo.decoderThreads;
+}
+
 void CDataCacheCore::SetVideoPixelFormat(std::string pixFormat)
 {
   CSingleLock lock(m_videoPlayerSection);
@@ -418,6 +433,18 @@ int64_t CDataCacheCore::GetMaxTime()
   return m_timeInfo.m_timeMax;
 }
 
+void CDataCacheCore::SetTimeToFirstFrame(int64_t ms)
+{
+  CSingleLock lock(m_stateSection);
+  m_timeInfo.m_timeToFirstFrame = ms;
+}
+
+int64_t CDataCacheCore::GetTimeToFirstFrame()
+{
+  CSingleLock lock(m_stateSection);
+  return m_timeInfo.m_timeToFirstFrame;
+}
+
 float CDataCacheCore::GetPlayPercentage()
 {
   CSingleLock lock(m_stateSection);
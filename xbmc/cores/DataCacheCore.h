@@ -37,6 +37,8 @@ public:
   bool IsVideoHwDecoder();
   void SetVideoDeintMethod(std::string method);
   std::string GetVideoDeintMethod();
+  void SetVideoDecoderThreads(std::string threads);
+  std::string GetVideoDecoderThreads();
   void SetVideoPixelFormat(std::string pixFormat);
   std::string GetVideoPixelFormat();
   void SetVideoStereoMode(std::string mode);
@@ -126,6 +128,16 @@ public:
    */
   int64_t GetMaxTime();
 
+  void SetTimeToFirstFrame(int64_t ms);
+
+  /*!
+   * \brief Get the time to first frame
+   *
+   * This is the time, in ms, from opening the file until the streams started
+   * to play. Zero until playback has started.
+   */
+  int64_t GetTimeToFirstFrame();
+
 protected:
   std::atomic_bool m_hasAVInfoChanges;
 
@@ -135,6 +147,7 @@ protected:
     std::string decoderName;
     bool isHwDecoder;
     std::string deintMethod;
+    std::string decoderThreads;
     std::string pixFormat;
     std::string stereoMode;
     int width;
@@ -183,5 +196,6 @@ protected:
     int64_t m_time;
     int64_t m_timeMax;
     int64_t m_timeMin;
+    int64_t m_timeToFirstFrame;
   } m_timeInfo = {};
 };
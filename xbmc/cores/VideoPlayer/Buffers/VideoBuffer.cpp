@@ -9,10 +9,21 @@
 #include "VideoBuffer.h"
 
 #include "threads/SingleLock.h"
+#include "utils/MemUtils.h"
 
+#include <algorithm>
 #include <string.h>
 #include <utility>
 
+namespace
+{
+// idle pools kept for reuse after a stream change
+constexpr size_t MAX_SPARE_POOLS = 2;
+constexpr unsigned int SPARE_POOL_TIMEOUT = 30000; // ms
+// start of buffers and planes, suits simd code in decoders and uploads
+constexpr size_t BUFFER_ALIGNMENT = 64;
+}
+
 //-----------------------------------------------------------------------------
 // CVideoBuffer
 //-----------------------------------------------------------------------------
@@ -182,7 +193,7 @@ CVideoBufferSysMem::CVideoBufferSysMem(IVideoBufferPool &pool, int id, AVPixelFo
 
 CVideoBufferSysMem::~CVideoBufferSysMem()
 {
-  delete[] m_data;
+  KODI::MEMORY::AlignedFree(m_data);
 }
 
 uint8_t* CVideoBufferSysMem::GetMemPtr()
@@ -268,8 +279,8 @@ void CVideoBufferSysMem::SetDimensions(int width, int height, const int (&stride
 
 bool CVideoBufferSysMem::Alloc()
 {
-  m_data = new uint8_t[m_size];
-  return true;
+  m_data = static_cast<uint8_t*>(KODI::MEMORY::AlignedMalloc(m_size, BUFFER_ALIGNMENT));
+  return m_data != nullptr;
 }
 
 
@@ -303,7 +314,11 @@ CVideoBuffer* CVideoBufferPoolSysMem::Get()
   {
     int id = m_all.size();
     buf = new CVideoBufferSysMem(*this, id, m_pixFormat, m_size);
-    buf->Alloc();
+    if (!buf->Alloc())
+    {
+      delete buf;
+      return nullptr;
+    }
     m_all.push_back(buf);
     m_used.push_back(id);
   }
@@ -338,7 +353,7 @@ void CVideoBufferPoolSysMem::Return(int id)
 void CVideoBufferPoolSysMem::Configure(AVPixelFormat format, int size)
 {
   m_pixFormat = format;
-  m_size = size;
+  m_size = GetSizeClass(size);
   m_configured = true;
 }
 
@@ -350,7 +365,7 @@ inline bool CVideoBufferPoolSysMem::IsConfigured()
 bool CVideoBufferPoolSysMem::IsCompatible(AVPixelFormat format, int size)
 {
   if (m_pixFormat == format &&
-      m_size == size)
+      m_size == GetSizeClass(size))
     return true;
 
   return false;
@@ -366,16 +381,40 @@ void CVideoBufferPoolSysMem::Discard(CVideoBufferManager *bm, ReadyToDispose cb)
     (m_bm->*m_cbDispose)(this);
 }
 
+bool CVideoBufferPoolSysMem::Recycle()
+{
+  CSingleLock lock(m_critSection);
+  m_bm = nullptr;
+  return true;
+}
+
+void CVideoBufferPoolSysMem::GetCounts(int& buffers, int& used)
+{
+  CSingleLock lock(m_critSection);
+  buffers += m_all.size();
+  used += m_used.size();
+}
+
 std::shared_ptr<IVideoBufferPool> CVideoBufferPoolSysMem::CreatePool()
 {
   return std::make_shared<CVideoBufferPoolSysMem>();
 }
 
+int CVideoBufferPoolSysMem::GetSizeClass(int size)
+{
+  // four to eight classes between powers of two waste at most a quarter of a buffer
+  int step = BUFFER_ALIGNMENT;
+  while (step * 8 < size)
+    step <<= 1;
+
+  return (size + step - 1) / step * step;
+}
+
 //-----------------------------------------------------------------------------
 // CVideoBufferManager
 //-----------------------------------------------------------------------------
 
-CVideoBufferManager::CVideoBufferManager()
+CVideoBufferManager::CVideoBufferManager() : m_spareTimer([this]() { TrimSparePools(); })
 {
   CSingleLock lock(m_critSection);
   RegisterPoolFactory("SysMem", &CVideoBufferPoolSysMem::CreatePool);
@@ -432,7 +471,16 @@ void CVideoBufferManager::ReadyForDisposal(IVideoBufferPool *pool)
   {
     if ((*it).get() == pool)
     {
-      pool->Released(*this);
+      if (pool->Recycle())
+      {
+        m_sparePools.emplace_front(*it, XbmcThreads::EndTime(SPARE_POOL_TIMEOUT));
+        if (m_sparePools.size() > MAX_SPARE_POOLS)
+          m_sparePools.pop_back();
+        if (!m_spareTimer.IsRunning())
+          m_spareTimer.Start(SPARE_POOL_TIMEOUT);
+      }
+      else
+        pool->Released(*this);
       m_discardedPools.erase(it);
       break;
     }
@@ -454,10 +502,25 @@ CVideoBuffer* CVideoBufferManager::Get(AVPixelFormat format, int size, IVideoBuf
     }
   }
 
+  for (auto it = m_sparePools.begin(); it != m_sparePools.end(); ++it)
+  {
+    if ((*it).first->IsCompatible(format, size))
+    {
+      std::shared_ptr<IVideoBufferPool> pool = (*it).first;
+      m_sparePools.erase(it);
+      m_pools.push_front(pool);
+      m_reusedPools++;
+      if (pPool)
+        *pPool = pool.get();
+      return pool->Get();
+    }
+  }
+
   for (const auto& fact : m_poolFactories)
   {
     std::shared_ptr<IVideoBufferPool> pool = fact.second();
     m_pools.push_front(pool);
+    m_createdPools++;
     pool->Configure(format, size);
     if (pPool)
       *pPool = pool.get();
@@ -465,3 +528,28 @@ CVideoBuffer* CVideoBufferManager::Get(AVPixelFormat format, int size, IVideoBuf
   }
   return nullptr;
 }
+
+void CVideoBufferManager::TrimSparePools()
+{
+  CSingleLock lock(m_critSection);
+
+  // the oldest pools are at the back
+  while (!m_sparePools.empty() && m_sparePools.back().second.IsTimePast())
+    m_sparePools.pop_back();
+
+  // keep the timer running until the remaining pools expired as well
+  if (!m_sparePools.empty())
+    m_spareTimer.RestartAsync(std::max(1u, m_sparePools.back().second.MillisLeft()));
+}
+
+CVideoBufferManager::Stats CVideoBufferManager::GetStats()
+{
+  CSingleLock lock(m_critSection);
+
+  Stats stats;
+  for (const auto& pool : m_pools)
+    pool->GetCounts(stats.buffers, stats.used);
+  stats.createdPools = m_createdPools;
+  stats.reusedPools = m_reusedPools;
+  return stats;
+}
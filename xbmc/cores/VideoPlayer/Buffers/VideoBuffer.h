@@ -9,6 +9,9 @@
 #pragma once
 
 #include "threads/CriticalSection.h"
+#include "threads/SystemClock.h"
+#include "threads/Timer.h"
+
 #include <atomic>
 #include <deque>
 #include <list>
@@ -78,6 +81,13 @@ public:
   // pool calls back when all buffers are back home
   virtual void Discard(CVideoBufferManager *bm, ReadyToDispose cb) { (bm->*cb)(this); };
 
+  // called by BM when a discarded pool is ready for disposal
+  // pools returning true are kept and handed to the next codec asking for a compatible pool
+  virtual bool Recycle() { return false; };
+
+  // number of allocated buffers and how many of them are in use
+  virtual void GetCounts(int& buffers, int& used) {};
+
   // call on Get() before returning buffer to caller
   std::shared_ptr<IVideoBufferPool> GetPtr() { return shared_from_this(); };
 };
@@ -145,9 +155,15 @@ public:
   bool IsConfigured() override;
   bool IsCompatible(AVPixelFormat format, int size) override;
   void Discard(CVideoBufferManager *bm, ReadyToDispose cb) override;
+  bool Recycle() override;
+  void GetCounts(int& buffers, int& used) override;
 
   static std::shared_ptr<IVideoBufferPool> CreatePool();
 
+  // buffer sizes are rounded up to size classes, this lets a pool serve
+  // streams with slightly different dimensions
+  static int GetSizeClass(int size);
+
 protected:
   int m_width = 0;
   int m_height = 0;
@@ -180,11 +196,27 @@ public:
   CVideoBuffer* Get(AVPixelFormat format, int size, IVideoBufferPool **pPool);
   void ReadyForDisposal(IVideoBufferPool *pool);
 
+  struct Stats
+  {
+    int buffers = 0; // allocated by active pools
+    int used = 0; // held by decoder or renderer
+    unsigned int createdPools = 0;
+    unsigned int reusedPools = 0;
+  };
+  Stats GetStats();
+
 protected:
+  void TrimSparePools();
+
   CCriticalSection m_critSection;
   std::list<std::shared_ptr<IVideoBufferPool>> m_pools;
   std::list<std::shared_ptr<IVideoBufferPool>> m_discardedPools;
+  // pools kept for the next stream, newest first, freed when they expire unused
+  std::list<std::pair<std::shared_ptr<IVideoBufferPool>, XbmcThreads::EndTime>> m_sparePools;
+  unsigned int m_createdPools = 0;
+  unsigned int m_reusedPools = 0;
   std::map<std::string, CreatePoolFunc> m_poolFactories;
+  CTimer m_spareTimer;
 
 private:
   CVideoBufferManager (const CVideoBufferManager&) = delete;
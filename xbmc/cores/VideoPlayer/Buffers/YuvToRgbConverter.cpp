@@ -0,0 +1,383 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "YuvToRgbConverter.h"
+
+#include "ServiceBroker.h"
+#include "threads/Event.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YUV2RGB_SSE2
+#include <emmintrin.h>
+#endif
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+}
+
+namespace
+{
+
+// smaller bands are not worth a job
+constexpr int MIN_BAND_HEIGHT = 64;
+
+// Q13 fixed point factors, products are taken with a 16 bit high multiply of
+// Q6 samples which leaves Q3 results. round also carries the luma offset of
+// limited range output.
+struct Coefficients
+{
+  int yOffset;
+  int round;
+  int y;
+  int rv;
+  int gu;
+  int gv;
+  int bu;
+};
+
+Coefficients GetCoefficients(AVColorSpace colorSpace, bool fullRange, bool dstFullRange)
+{
+  double kr = 0.299;
+  double kb = 0.114;
+  if (colorSpace == AVCOL_SPC_BT709)
+  {
+    kr = 0.2126;
+    kb = 0.0722;
+  }
+  else if (colorSpace == AVCOL_SPC_BT2020_NCL || colorSpace == AVCOL_SPC_BT2020_CL)
+  {
+    kr = 0.2627;
+    kb = 0.0593;
+  }
+  const double kg = 1.0 - kr - kb;
+  const double dstScale = dstFullRange ? 255.0 : 219.0;
+  const double yScale = dstScale / (fullRange ? 255.0 : 219.0);
+  const double cScale = dstScale / (fullRange ? 255.0 : 224.0);
+
+  auto q13 = [](double value) { return static_cast<int>(std::lround(value * (1 << 13))); };
+
+  Coefficients c;
+  c.yOffset = fullRange ? 0 : 16;
+  c.round = dstFullRange ? 4 : 4 + (16 << 3);
+  c.y = q13(yScale);
+  c.rv = q13(2.0 * (1.0 - kr) * cScale);
+  c.gu = q13(2.0 * (1.0 - kb) * kb / kg * cScale);
+  c.gv = q13(2.0 * (1.0 - kr) * kr / kg * cScale);
+  c.bu = q13(2.0 * (1.0 - kb) * cScale);
+  return c;
+}
+
+inline int MulHi(int a, int b)
+{
+  return (a * b) >> 16;
+}
+
+inline uint8_t Clamp(int value)
+{
+  return static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+}
+
+/*!
+ \brief Converts one row, chroma is shared by two horizontal pixels
+ \param uvStep 1 for planar chroma, 2 for interleaved chroma
+ \param simd use SSE2 if it is part of the build, the results are the same
+ */
+void ConvertRow(const uint8_t* srcY,
+                const uint8_t* srcU,
+                const uint8_t* srcV,
+                int uvStep,
+                uint8_t* dst,
+                int width,
+                const Coefficients& c,
+                bool simd)
+{
+  int x = 0;
+
+#if defined(YUV2RGB_SSE2)
+  const int simdWidth = simd ? width : 0;
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alpha = _mm_set1_epi8(-1);
+  const __m128i round = _mm_set1_epi16(c.round);
+  const __m128i yOffset = _mm_set1_epi16(c.yOffset);
+  const __m128i uvOffset = _mm_set1_epi16(128);
+  const __m128i cy = _mm_set1_epi16(c.y);
+  const __m128i crv = _mm_set1_epi16(c.rv);
+  const __m128i cgu = _mm_set1_epi16(c.gu);
+  const __m128i cgv = _mm_set1_epi16(c.gv);
+  const __m128i cbu = _mm_set1_epi16(c.bu);
+
+  for (; x + 8 <= simdWidth; x += 8)
+  {
+    __m128i y = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(srcY + x));
+    y = _mm_unpacklo_epi8(y, zero);
+
+    __m128i u;
+    __m128i v;
+    if (uvStep == 2)
+    {
+      // u0 v0 u1 v1 .. to u0 u0 u1 u1 .. and v0 v0 v1 v1 ..
+      const __m128i uv =
+          _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(srcU + x)), zero);
+      u = _mm_and_si128(uv, _mm_set1_epi32(0xFFFF));
+      v = _mm_srli_epi32(uv, 16);
+      u = _mm_or_si128(u, _mm_slli_epi32(u, 16));
+      v = _mm_or_si128(v, _mm_slli_epi32(v, 16));
+    }
+    else
+    {
+      int32_t u4;
+      int32_t v4;
+      memcpy(&u4, srcU + x / 2, 4);
+      memcpy(&v4, srcV + x / 2, 4);
+      u = _mm_cvtsi32_si128(u4);
+      v = _mm_cvtsi32_si128(v4);
+      u = _mm_unpacklo_epi8(_mm_unpacklo_epi8(u, u), zero);
+      v = _mm_unpacklo_epi8(_mm_unpacklo_epi8(v, v), zero);
+    }
+
+    y = _mm_slli_epi16(_mm_sub_epi16(y, yOffset), 6);
+    u = _mm_slli_epi16(_mm_sub_epi16(u, uvOffset), 6);
+    v = _mm_slli_epi16(_mm_sub_epi16(v, uvOffset), 6);
+
+    const __m128i yy = _mm_mulhi_epi16(y, cy);
+    __m128i b = _mm_add_epi16(yy, _mm_mulhi_epi16(u, cbu));
+    __m128i g = _mm_sub_epi16(_mm_sub_epi16(yy, _mm_mulhi_epi16(u, cgu)), _mm_mulhi_epi16(v, cgv));
+    __m128i r = _mm_add_epi16(yy, _mm_mulhi_epi16(v, crv));
+    b = _mm_srai_epi16(_mm_add_epi16(b, round), 3);
+    g = _mm_srai_epi16(_mm_add_epi16(g, round), 3);
+    r = _mm_srai_epi16(_mm_add_epi16(r, round), 3);
+
+    const __m128i bg = _mm_unpacklo_epi8(_mm_packus_epi16(b, b), _mm_packus_epi16(g, g));
+    const __m128i ra = _mm_unpacklo_epi8(_mm_packus_epi16(r, r), alpha);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_unpacklo_epi16(bg, ra));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4 + 16), _mm_unpackhi_epi16(bg, ra));
+  }
+#else
+  (void)simd;
+#endif
+
+  for (; x < width; x++)
+  {
+    const int y = MulHi((srcY[x] - c.yOffset) * 64, c.y);
+    const int u = (srcU[(x >> 1) * uvStep] - 128) * 64;
+    const int v = (srcV[(x >> 1) * uvStep] - 128) * 64;
+
+    uint8_t* pixel = dst + x * 4;
+    pixel[0] = Clamp((y + MulHi(u, c.bu) + c.round) >> 3);
+    pixel[1] = Clamp((y - MulHi(u, c.gu) - MulHi(v, c.gv) + c.round) >> 3);
+    pixel[2] = Clamp((y + MulHi(v, c.rv) + c.round) >> 3);
+    pixel[3] = 0xFF;
+  }
+}
+
+} // unnamed namespace
+
+CYuvToRgbConverter::~CYuvToRgbConverter()
+{
+  for (auto context : m_contexts)
+    sws_freeContext(context);
+}
+
+bool CYuvToRgbConverter::Convert(AVPixelFormat format,
+                                 AVColorSpace colorSpace,
+                                 bool fullRange,
+                                 uint8_t* const src[],
+                                 const int srcStride[],
+                                 int srcWidth,
+                                 int srcHeight,
+                                 uint8_t* dst,
+                                 int dstStride,
+                                 int dstWidth,
+                                 int dstHeight,
+                                 bool dstFullRange)
+{
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+  if (!desc || srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0)
+    return false;
+
+  if (format == AV_PIX_FMT_YUVJ420P)
+    fullRange = true;
+
+  const std::vector<Band> bands = GetBands(srcHeight, dstHeight, desc->log2_chroma_h);
+
+  if (srcWidth == dstWidth && srcHeight == dstHeight && HasFastPath(format))
+  {
+    RunParallel(bands.size(), [&](int index) {
+      ConvertFast(format, colorSpace, fullRange, dstFullRange, src, srcStride, srcWidth,
+                  bands[index], dst, dstStride, true);
+    });
+    return true;
+  }
+
+  m_contexts.resize(std::max(m_contexts.size(), bands.size()), nullptr);
+  for (size_t i = 0; i < bands.size(); i++)
+  {
+    m_contexts[i] = sws_getCachedContext(m_contexts[i], srcWidth, bands[i].srcHeight, format,
+                                         dstWidth, bands[i].dstHeight, AV_PIX_FMT_BGRA,
+                                         SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+    if (!m_contexts[i])
+    {
+      CLog::Log(LOGERROR, "CYuvToRgbConverter::{} - unable to convert from {}", __FUNCTION__,
+                desc->name);
+      return false;
+    }
+
+    sws_setColorspaceDetails(m_contexts[i], sws_getCoefficients(colorSpace), fullRange,
+                             sws_getCoefficients(AVCOL_SPC_BT709), dstFullRange, 0, 1 << 16,
+                             1 << 16);
+  }
+
+  const int planes = std::min(av_pix_fmt_count_planes(format), 3);
+
+  RunParallel(bands.size(), [&](int index) {
+    const Band& band = bands[index];
+
+    const uint8_t* srcBand[4] = {};
+    int srcBandStride[4] = {};
+    for (int p = 0; p < planes; p++)
+    {
+      const int shift = (p == 1 || p == 2) ? desc->log2_chroma_h : 0;
+      srcBand[p] = src[p] + (band.srcY >> shift) * srcStride[p];
+      srcBandStride[p] = srcStride[p];
+    }
+    uint8_t* dstBand[4] = {dst + band.dstY * dstStride};
+    const int dstBandStride[4] = {dstStride};
+
+    sws_scale(m_contexts[index], srcBand, srcBandStride, 0, band.srcHeight, dstBand,
+              dstBandStride);
+  });
+
+  return true;
+}
+
+void CYuvToRgbConverter::ConvertUnscaled(AVPixelFormat format,
+                                         AVColorSpace colorSpace,
+                                         bool fullRange,
+                                         bool dstFullRange,
+                                         uint8_t* const src[],
+                                         const int srcStride[],
+                                         int width,
+                                         int height,
+                                         uint8_t* dst,
+                                         int dstStride,
+                                         bool simd)
+{
+  if (format == AV_PIX_FMT_YUVJ420P)
+    fullRange = true;
+
+  const Band band = {0, height, 0, height};
+  ConvertFast(format, colorSpace, fullRange, dstFullRange, src, srcStride, width, band, dst,
+              dstStride, simd);
+}
+
+bool CYuvToRgbConverter::HasFastPath(AVPixelFormat format)
+{
+  return format == AV_PIX_FMT_YUV420P || format == AV_PIX_FMT_YUVJ420P ||
+         format == AV_PIX_FMT_NV12;
+}
+
+std::vector<CYuvToRgbConverter::Band> CYuvToRgbConverter::GetBands(int srcHeight,
+                                                                   int dstHeight,
+                                                                   int chromaShift)
+{
+  const int cpus = CServiceBroker::GetCPUInfo()->GetCPUCount();
+  const int count = std::max(1, std::min(cpus, dstHeight / MIN_BAND_HEIGHT));
+  const int mask = ~((1 << chromaShift) - 1);
+
+  // bands start on chroma rows in both source and destination
+  auto dstStart = [&](int i) {
+    return i == count ? dstHeight : (static_cast<int64_t>(dstHeight) * i / count) & mask;
+  };
+  auto srcStart = [&](int i) {
+    return i == count ? srcHeight
+                      : static_cast<int>(static_cast<int64_t>(dstStart(i)) * srcHeight /
+                                         dstHeight) &
+                            mask;
+  };
+
+  std::vector<Band> bands;
+  for (int i = 0; i < count; i++)
+  {
+    Band band;
+    band.srcY = srcStart(i);
+    band.srcHeight = srcStart(i + 1) - band.srcY;
+    band.dstY = dstStart(i);
+    band.dstHeight = dstStart(i + 1) - band.dstY;
+    if (band.srcHeight > 0 && band.dstHeight > 0)
+      bands.push_back(band);
+  }
+  return bands;
+}
+
+void CYuvToRgbConverter::RunParallel(int count, const std::function<void(int)>& func)
+{
+  // jobs which start after the caller took the last band return without
+  // touching func, the shared state keeps them safe after Convert returned
+  struct Work
+  {
+    std::atomic<int> next{0};
+    std::atomic<int> done{0};
+    CEvent finished{true, false};
+    int count = 0;
+    const std::function<void(int)>* func = nullptr;
+  };
+
+  auto work = std::make_shared<Work>();
+  work->count = count;
+  work->func = &func;
+
+  auto run = [](Work& work) {
+    int index;
+    while ((index = work.next++) < work.count)
+    {
+      (*work.func)(index);
+      if (++work.done == work.count)
+        work.finished.Set();
+    }
+  };
+
+  for (int i = 1; i < count; i++)
+    CJobManager::GetInstance().Submit([work, run]() { run(*work); }, CJob::PRIORITY_HIGH);
+
+  run(*work);
+  work->finished.Wait();
+}
+
+void CYuvToRgbConverter::ConvertFast(AVPixelFormat format,
+                                     AVColorSpace colorSpace,
+                                     bool fullRange,
+                                     bool dstFullRange,
+                                     uint8_t* const src[],
+                                     const int srcStride[],
+                                     int width,
+                                     const Band& band,
+                                     uint8_t* dst,
+                                     int dstStride,
+                                     bool simd)
+{
+  const Coefficients c = GetCoefficients(colorSpace, fullRange, dstFullRange);
+  const bool nv12 = format == AV_PIX_FMT_NV12;
+
+  for (int row = band.srcY; row < band.srcY + band.srcHeight; row++)
+  {
+    const uint8_t* srcU = src[1] + (row >> 1) * srcStride[1];
+    const uint8_t* srcV = nv12 ? srcU + 1 : src[2] + (row >> 1) * srcStride[2];
+    ConvertRow(src[0] + row * srcStride[0], srcU, srcV, nv12 ? 2 : 1, dst + row * dstStride,
+               width, c, simd);
+  }
+}
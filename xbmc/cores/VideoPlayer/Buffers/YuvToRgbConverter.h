@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+}
+
+struct SwsContext;
+
+/*!
+ \brief Converts software decoded pictures to BGRA in parallel
+
+ The picture is split into horizontal bands which are converted on job manager
+ workers and the calling thread. Unscaled 8 bit YUV420P and NV12 pictures take
+ a fixed point fast path, everything else goes through one swscale context per
+ band. Bands of scaled pictures start at slightly rounded source rows, this is
+ not noticeable at thumbnail sizes.
+ */
+class CYuvToRgbConverter
+{
+public:
+  CYuvToRgbConverter() = default;
+  ~CYuvToRgbConverter();
+
+  CYuvToRgbConverter(const CYuvToRgbConverter&) = delete;
+  CYuvToRgbConverter& operator=(const CYuvToRgbConverter&) = delete;
+
+  /*!
+   \brief Converts a picture to BGRA, scaling it if the sizes differ
+   \param src up to three planes, as returned by CVideoBuffer::GetPlanes
+   \param dstFullRange false to keep the luma of the output in 16..235
+   \return false if the format is not supported
+   */
+  bool Convert(AVPixelFormat format,
+               AVColorSpace colorSpace,
+               bool fullRange,
+               uint8_t* const src[],
+               const int srcStride[],
+               int srcWidth,
+               int srcHeight,
+               uint8_t* dst,
+               int dstStride,
+               int dstWidth,
+               int dstHeight,
+               bool dstFullRange = true);
+
+  /*!
+   \brief Converts an unscaled YUV420P or NV12 picture with the fixed point kernel on the
+   calling thread
+   \param simd use SSE2 if it is part of the build, false to test the scalar kernel
+   */
+  static void ConvertUnscaled(AVPixelFormat format,
+                              AVColorSpace colorSpace,
+                              bool fullRange,
+                              bool dstFullRange,
+                              uint8_t* const src[],
+                              const int srcStride[],
+                              int width,
+                              int height,
+                              uint8_t* dst,
+                              int dstStride,
+                              bool simd = true);
+
+private:
+  struct Band
+  {
+    int srcY;
+    int srcHeight;
+    int dstY;
+    int dstHeight;
+  };
+
+  static bool HasFastPath(AVPixelFormat format);
+  static std::vector<Band> GetBands(int srcHeight, int dstHeight, int chromaShift);
+  static void RunParallel(int count, const std::function<void(int)>& func);
+
+  static void ConvertFast(AVPixelFormat format,
+                          AVColorSpace colorSpace,
+                          bool fullRange,
+                          bool dstFullRange,
+                          uint8_t* const src[],
+                          const int srcStride[],
+                          int width,
+                          const Band& band,
+                          uint8_t* dst,
+                          int dstStride,
+                          bool simd);
+
+  std::vector<SwsContext*> m_contexts;
+};
@@ -0,0 +1,207 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/Buffers/YuvToRgbConverter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct Picture
+{
+  Picture(AVPixelFormat format, int width, int height, unsigned int seed)
+    : format(format), width(width), height(height)
+  {
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+
+    // padded strides, the kernels must not depend on them
+    stride[0] = width + 13;
+    if (format == AV_PIX_FMT_NV12)
+    {
+      stride[1] = chromaWidth * 2 + 7;
+      stride[2] = 0;
+    }
+    else
+    {
+      stride[1] = chromaWidth + 5;
+      stride[2] = chromaWidth + 9;
+    }
+
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> distribution(0, 255);
+    auto fill = [&](std::vector<uint8_t>& plane, int size) {
+      plane.resize(size);
+      for (auto& sample : plane)
+        sample = static_cast<uint8_t>(distribution(generator));
+    };
+    fill(planes[0], stride[0] * height);
+    fill(planes[1], stride[1] * chromaHeight);
+    fill(planes[2], stride[2] * chromaHeight);
+
+    data[0] = planes[0].data();
+    data[1] = planes[1].data();
+    data[2] = format == AV_PIX_FMT_NV12 ? nullptr : planes[2].data();
+  }
+
+  uint8_t Y(int x, int y) const { return data[0][y * stride[0] + x]; }
+  uint8_t U(int x, int y) const
+  {
+    if (format == AV_PIX_FMT_NV12)
+      return data[1][(y / 2) * stride[1] + (x / 2) * 2];
+    return data[1][(y / 2) * stride[1] + x / 2];
+  }
+  uint8_t V(int x, int y) const
+  {
+    if (format == AV_PIX_FMT_NV12)
+      return data[1][(y / 2) * stride[1] + (x / 2) * 2 + 1];
+    return data[2][(y / 2) * stride[2] + x / 2];
+  }
+
+  AVPixelFormat format;
+  int width;
+  int height;
+  std::vector<uint8_t> planes[3];
+  uint8_t* data[3] = {};
+  int stride[3] = {};
+};
+
+std::vector<uint8_t> Convert(
+    const Picture& picture, AVColorSpace colorSpace, bool fullRange, bool dstFullRange, bool simd)
+{
+  const int stride = picture.width * 4;
+  std::vector<uint8_t> bgra(stride * picture.height);
+  CYuvToRgbConverter::ConvertUnscaled(picture.format, colorSpace, fullRange, dstFullRange,
+                                      picture.data, picture.stride, picture.width,
+                                      picture.height, bgra.data(), stride, simd);
+  return bgra;
+}
+
+// floating point reference, BGRA like the converter
+std::vector<uint8_t> Reference(const Picture& picture,
+                               AVColorSpace colorSpace,
+                               bool fullRange,
+                               bool dstFullRange)
+{
+  const double kr = colorSpace == AVCOL_SPC_BT709 ? 0.2126 : 0.299;
+  const double kb = colorSpace == AVCOL_SPC_BT709 ? 0.0722 : 0.114;
+  const double kg = 1.0 - kr - kb;
+  const double dstScale = dstFullRange ? 255.0 : 219.0;
+  const double dstOffset = dstFullRange ? 0.0 : 16.0;
+
+  auto clamp = [](double value) {
+    return static_cast<uint8_t>(std::min(std::max(std::lround(value), 0L), 255L));
+  };
+
+  std::vector<uint8_t> bgra(picture.width * 4 * picture.height);
+  for (int y = 0; y < picture.height; y++)
+  {
+    for (int x = 0; x < picture.width; x++)
+    {
+      double luma = picture.Y(x, y);
+      double cb = picture.U(x, y) - 128.0;
+      double cr = picture.V(x, y) - 128.0;
+      if (fullRange)
+      {
+        luma /= 255.0;
+        cb /= 255.0;
+        cr /= 255.0;
+      }
+      else
+      {
+        luma = (luma - 16.0) / 219.0;
+        cb /= 224.0;
+        cr /= 224.0;
+      }
+
+      const double r = luma + 2.0 * (1.0 - kr) * cr;
+      const double g = luma - 2.0 * (1.0 - kb) * kb / kg * cb - 2.0 * (1.0 - kr) * kr / kg * cr;
+      const double b = luma + 2.0 * (1.0 - kb) * cb;
+
+      uint8_t* pixel = bgra.data() + (y * picture.width + x) * 4;
+      pixel[0] = clamp(b * dstScale + dstOffset);
+      pixel[1] = clamp(g * dstScale + dstOffset);
+      pixel[2] = clamp(r * dstScale + dstOffset);
+      pixel[3] = 0xFF;
+    }
+  }
+  return bgra;
+}
+
+struct Params
+{
+  AVPixelFormat format;
+  AVColorSpace colorSpace;
+  bool fullRange;
+  bool dstFullRange;
+};
+
+const Params params[] = {
+    {AV_PIX_FMT_YUV420P, AVCOL_SPC_BT470BG, false, true},
+    {AV_PIX_FMT_YUV420P, AVCOL_SPC_BT709, false, true},
+    {AV_PIX_FMT_YUV420P, AVCOL_SPC_BT470BG, true, true},
+    {AV_PIX_FMT_YUV420P, AVCOL_SPC_BT709, true, true},
+    {AV_PIX_FMT_YUV420P, AVCOL_SPC_BT709, false, false},
+    {AV_PIX_FMT_YUV420P, AVCOL_SPC_BT470BG, true, false},
+    {AV_PIX_FMT_NV12, AVCOL_SPC_BT470BG, false, true},
+    {AV_PIX_FMT_NV12, AVCOL_SPC_BT709, false, true},
+    {AV_PIX_FMT_NV12, AVCOL_SPC_BT709, true, true},
+    {AV_PIX_FMT_NV12, AVCOL_SPC_BT709, false, false},
+};
+
+// even, odd, narrower than one SIMD block and with a scalar tail
+const int sizes[][2] = {{64, 32}, {67, 33}, {5, 3}, {1, 1}, {23, 9}};
+
+} // namespace
+
+class TestYuvToRgbConverter : public ::testing::TestWithParam<Params>
+{
+};
+
+TEST_P(TestYuvToRgbConverter, SimdMatchesScalar)
+{
+  const Params& p = GetParam();
+  for (const auto& size : sizes)
+  {
+    const Picture picture(p.format, size[0], size[1], size[0] * 31 + size[1]);
+    EXPECT_EQ(Convert(picture, p.colorSpace, p.fullRange, p.dstFullRange, true),
+              Convert(picture, p.colorSpace, p.fullRange, p.dstFullRange, false))
+        << size[0] << "x" << size[1];
+  }
+}
+
+TEST_P(TestYuvToRgbConverter, MatchesReference)
+{
+  const Params& p = GetParam();
+  for (const auto& size : sizes)
+  {
+    const Picture picture(p.format, size[0], size[1], size[0] * 17 + size[1]);
+    const auto reference = Reference(picture, p.colorSpace, p.fullRange, p.dstFullRange);
+
+    for (bool simd : {true, false})
+    {
+      const auto bgra = Convert(picture, p.colorSpace, p.fullRange, p.dstFullRange, simd);
+      ASSERT_EQ(bgra.size(), reference.size());
+      for (size_t i = 0; i < bgra.size(); i++)
+      {
+        ASSERT_LE(std::abs(bgra[i] - reference[i]), 1)
+            << size[0] << "x" << size[1] << " pixel " << i / 4 << " channel " << i % 4
+            << (simd ? " simd" : " scalar");
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(YuvToRgbConverter, TestYuvToRgbConverter, ::testing::ValuesIn(params));
@@ -243,6 +243,154 @@ void CDVDVideoCodecFFmpeg::CDropControl::Process(int64_t pts, bool drop)
   m_lastPTS = pts;
 }
 
+namespace
+{
+constexpr int THREAD_WARMUP_FRAMES = 10; // frame threading needs to fill its pipeline first
+constexpr double THREAD_LOAD_HIGH = 0.7; // of the frame duration spent in the decoder
+constexpr double THREAD_LOAD_LOW = 0.2;
+constexpr int THREAD_MAX_REOPENS = 3;
+}
+
+void CDVDVideoCodecFFmpeg::CThreadControl::Init(const AVCodec* codec, const CDVDStreamInfo& hints)
+{
+  // keep the state of the tuning over reopens
+  if (!m_configs.empty())
+    return;
+
+  const int cpus = CServiceBroker::GetCPUInfo()->GetCPUCount();
+  const int maxThreads = std::max(1, std::min(cpus * 3 / 2, 16));
+  const bool frameThreads = codec->capabilities & AV_CODEC_CAP_FRAME_THREADS;
+  const bool sliceThreads = codec->capabilities & AV_CODEC_CAP_SLICE_THREADS;
+
+  m_auto = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoDecoderThreading == "auto";
+  if (!m_auto || (!frameThreads && !sliceThreads))
+  {
+    m_auto = false;
+    m_configs.push_back({FF_THREAD_FRAME | FF_THREAD_SLICE, maxThreads});
+    return;
+  }
+
+  if (sliceThreads)
+    m_configs.push_back({FF_THREAD_SLICE, std::max(1, std::min(cpus, 16))});
+  if (frameThreads)
+  {
+    for (int count = 2; count < maxThreads; count *= 2)
+      m_configs.push_back({FF_THREAD_FRAME, count});
+    m_configs.push_back({FF_THREAD_FRAME, maxThreads});
+  }
+
+  // start with what usually suffices: slice threading adds neither latency nor memory
+  // and works for most large hevc streams as they use wavefront parallel processing,
+  // otherwise two frame threads per 1080p worth of pixels
+  const double pixels = static_cast<double>(hints.width) * hints.height;
+  const bool large = pixels > 1920.0 * 1088.0;
+  m_current = 0;
+  if (frameThreads && !(sliceThreads && large && hints.codec == AV_CODEC_ID_HEVC))
+  {
+    const int wanted = std::max(2, static_cast<int>(std::ceil(2.0 * pixels / (1920.0 * 1080.0))));
+    m_current = m_configs.size() - 1;
+    for (size_t i = 0; i < m_configs.size(); i++)
+    {
+      if (m_configs[i].type == FF_THREAD_FRAME && m_configs[i].count >= wanted)
+      {
+        m_current = i;
+        break;
+      }
+    }
+  }
+
+  m_next = m_current;
+  m_frameTime = 1000000.0 / 25.0;
+  if (hints.fpsrate > 0 && hints.fpsscale > 0)
+    m_frameTime = 1000000.0 * hints.fpsscale / hints.fpsrate;
+  m_windowFrames = std::max(48, static_cast<int>(2000000.0 / m_frameTime));
+}
+
+void CDVDVideoCodecFFmpeg::CThreadControl::Apply(AVCodecContext* avctx)
+{
+  m_current = m_next;
+  const Config& config = m_configs[m_current];
+  avctx->thread_type = config.type;
+  avctx->thread_count = config.count;
+  Restart();
+}
+
+void CDVDVideoCodecFFmpeg::CThreadControl::Restart()
+{
+  m_frames = -THREAD_WARMUP_FRAMES;
+  m_busyTime = std::chrono::steady_clock::duration::zero();
+}
+
+bool CDVDVideoCodecFFmpeg::CThreadControl::AddFrame()
+{
+  if (!IsMeasuring() || ++m_frames < m_windowFrames)
+    return false;
+
+  const double busy = std::chrono::duration<double, std::micro>(m_busyTime).count();
+  m_load = busy / (m_frames * m_frameTime);
+
+  size_t next = m_current;
+  if (m_load > THREAD_LOAD_HIGH && m_current + 1 < m_configs.size())
+  {
+    next = m_current + 1;
+    m_wentUp = true;
+  }
+  else if (m_load < THREAD_LOAD_LOW && m_current > 0 && !m_wentUp)
+    next = m_current - 1;
+
+  if (next == m_current || m_reopens >= THREAD_MAX_REOPENS)
+  {
+    m_tuned = true;
+    CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg::CThreadControl - keeping {}", GetDescription());
+    return false;
+  }
+
+  CLog::Log(LOGDEBUG,
+            "CDVDVideoCodecFFmpeg::CThreadControl - load {:.0f}% with {}, switching at the next "
+            "keyframe",
+            m_load * 100.0, GetDescription());
+  m_next = next;
+  m_reopens++;
+  return true;
+}
+
+void CDVDVideoCodecFFmpeg::CThreadControl::CancelSwitch()
+{
+  m_next = m_current;
+  m_tuned = true;
+}
+
+std::string CDVDVideoCodecFFmpeg::CThreadControl::GetDescription() const
+{
+  if (m_configs.empty())
+    return "";
+
+  const Config& config = m_configs[m_current];
+  std::string description;
+  if (config.type == FF_THREAD_SLICE)
+    description = StringUtils::Format("slice:{}", config.count);
+  else
+    description = StringUtils::Format("frame:{}", config.count);
+
+  if (m_auto)
+    description += m_tuned ? StringUtils::Format(" load:{:.0f}%", m_load * 100.0) : " tuning";
+
+  return description;
+}
+
+CDVDVideoCodecFFmpeg::CThreadControl::CBusyTimer::CBusyTimer(CThreadControl& ctrl)
+  : m_ctrl(ctrl), m_active(ctrl.IsMeasuring() && ctrl.m_frames >= 0)
+{
+  if (m_active)
+    m_start = std::chrono::steady_clock::now();
+}
+
+CDVDVideoCodecFFmpeg::CThreadControl::CBusyTimer::~CBusyTimer()
+{
+  if (m_active)
+    m_ctrl.m_busyTime += std::chrono::steady_clock::now() - m_start;
+}
+
 enum AVPixelFormat CDVDVideoCodecFFmpeg::GetFormat(struct AVCodecContext * avctx, const AVPixelFormat * fmt)
 {
   ICallbackHWAccel *cb = static_cast<ICallbackHWAccel*>(avctx->opaque);
@@ -353,12 +501,7 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
   if (!m_pCodecContext)
     return false;
 
-  m_pCodecContext->opaque = static_cast<ICallbackHWAccel*>(this);
-  m_pCodecContext->debug_mv = 0;
-  m_pCodecContext->debug = 0;
-  m_pCodecContext->workaround_bugs = FF_BUG_AUTODETECT;
-  m_pCodecContext->get_format = GetFormat;
-  m_pCodecContext->codec_tag = hints.codec_tag;
+  SetupContext(m_pCodecContext);
 
   // setup threading model
   if (!(hints.codecOptions & CODEC_FORCE_SOFTWARE))
@@ -369,43 +512,17 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     }
     else
     {
-      int num_threads = CServiceBroker::GetCPUInfo()->GetCPUCount() * 3 / 2;
-      num_threads = std::max(1, std::min(num_threads, 16));
-      m_pCodecContext->thread_count = num_threads;
+      m_threadCtrl.Init(pCodec, hints);
+      m_threadCtrl.Apply(m_pCodecContext);
       m_pCodecContext->thread_safe_callbacks = 1;
       m_decoderState = STATE_SW_MULTI;
-      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open frame threaded with %d threads", num_threads);
+      m_processInfo.SetVideoDecoderThreads(m_threadCtrl.GetDescription());
+      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open threaded, {}", m_threadCtrl.GetDescription());
     }
   }
   else
     m_decoderState = STATE_SW_SINGLE;
 
-  // if we don't do this, then some codecs seem to fail.
-  m_pCodecContext->coded_height = hints.height;
-  m_pCodecContext->coded_width = hints.width;
-  m_pCodecContext->bits_per_coded_sample = hints.bitsperpixel;
-
-  if( hints.extradata && hints.extrasize > 0 )
-  {
-    m_pCodecContext->extradata_size = hints.extrasize;
-    m_pCodecContext->extradata = (uint8_t*)av_mallocz(hints.extrasize + AV_INPUT_BUFFER_PADDING_SIZE);
-    memcpy(m_pCodecContext->extradata, hints.extradata, hints.extrasize);
-  }
-
-  // advanced setting override for skip loop filter (see avcodec.h for valid options)
-  //! @todo allow per video setting?
-  int iSkipLoopFilter = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iSkipLoopFilter;
-  if (iSkipLoopFilter != 0)
-  {
-    m_pCodecContext->skip_loop_filter = static_cast<AVDiscard>(iSkipLoopFilter);
-  }
-
-  // set any special options
-  for(std::vector<CDVDCodecOption>::iterator it = options.m_keys.begin(); it != options.m_keys.end(); ++it)
-  {
-    av_opt_set(m_pCodecContext, it->m_name.c_str(), it->m_value.c_str(), 0);
-  }
-
   if (avcodec_open2(m_pCodecContext, pCodec, nullptr) < 0)
   {
     CLog::Log(LOGDEBUG,"CDVDVideoCodecFFmpeg::Open() Unable to open codec");
@@ -447,11 +564,77 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
   return true;
 }
 
+void CDVDVideoCodecFFmpeg::SetupContext(AVCodecContext* context)
+{
+  context->opaque = static_cast<ICallbackHWAccel*>(this);
+  context->debug_mv = 0;
+  context->debug = 0;
+  context->workaround_bugs = FF_BUG_AUTODETECT;
+  context->get_format = GetFormat;
+  context->codec_tag = m_hints.codec_tag;
+
+  // if we don't do this, then some codecs seem to fail.
+  context->coded_height = m_hints.height;
+  context->coded_width = m_hints.width;
+  context->bits_per_coded_sample = m_hints.bitsperpixel;
+
+  if (m_hints.extradata && m_hints.extrasize > 0)
+  {
+    context->extradata_size = m_hints.extrasize;
+    context->extradata = (uint8_t*)av_mallocz(m_hints.extrasize + AV_INPUT_BUFFER_PADDING_SIZE);
+    memcpy(context->extradata, m_hints.extradata, m_hints.extrasize);
+  }
+
+  // advanced setting override for skip loop filter (see avcodec.h for valid options)
+  //! @todo allow per video setting?
+  int iSkipLoopFilter = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iSkipLoopFilter;
+  if (iSkipLoopFilter != 0)
+  {
+    context->skip_loop_filter = static_cast<AVDiscard>(iSkipLoopFilter);
+  }
+
+  // set any special options
+  for (const auto& option : m_options.m_keys)
+  {
+    av_opt_set(context, option.m_name.c_str(), option.m_value.c_str(), 0);
+  }
+}
+
+void CDVDVideoCodecFFmpeg::SwitchThreads()
+{
+  AVCodecContext* context = avcodec_alloc_context3(m_pCodecContext->codec);
+  if (context)
+  {
+    SetupContext(context);
+    m_threadCtrl.Apply(context);
+    context->thread_safe_callbacks = 1;
+    context->skip_frame = m_pCodecContext->skip_frame;
+    context->skip_idct = m_pCodecContext->skip_idct;
+    context->skip_loop_filter = m_pCodecContext->skip_loop_filter;
+
+    if (avcodec_open2(context, m_pCodecContext->codec, nullptr) < 0)
+      avcodec_free_context(&context);
+  }
+
+  if (!context)
+  {
+    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::SwitchThreads - unable to open codec");
+    m_threadCtrl.CancelSwitch();
+    return;
+  }
+
+  // the current decoder outputs the frames it holds, then the new one takes over
+  avcodec_send_packet(m_pCodecContext, nullptr);
+  m_pNextCodecContext = context;
+  m_processInfo.SetVideoDecoderThreads(m_threadCtrl.GetDescription());
+}
+
 void CDVDVideoCodecFFmpeg::Dispose()
 {
   av_frame_free(&m_pFrame);
   av_frame_free(&m_pDecodedFrame);
   av_frame_free(&m_pFilterFrame);
+  avcodec_free_context(&m_pNextCodecContext);
   avcodec_free_context(&m_pCodecContext);
   SAFE_RELEASE(m_pHardware);
 
@@ -555,11 +738,20 @@ bool CDVDVideoCodecFFmpeg::AddData(const DemuxPacket &packet)
     Reset();
   }
 
+  CThreadControl::CBusyTimer busyTimer(m_threadCtrl);
+
+  // a new thread config starts decoding at a keyframe, no packets have to be decoded twice
+  if (m_threadCtrl.IsSwitchPending() && !m_pNextCodecContext &&
+      (packet.keyframe || packet.recoveryPoint))
+    SwitchThreads();
+
+  AVCodecContext* context = m_pNextCodecContext ? m_pNextCodecContext : m_pCodecContext;
+
   if (packet.recoveryPoint)
     m_started = true;
 
   m_dts = packet.dts;
-  m_pCodecContext->reordered_opaque = pts_dtoi(packet.pts);
+  context->reordered_opaque = pts_dtoi(packet.pts);
 
   AVPacket avpkt;
   av_init_packet(&avpkt);
@@ -570,7 +762,7 @@ bool CDVDVideoCodecFFmpeg::AddData(const DemuxPacket &packet)
   avpkt.side_data = static_cast<AVPacketSideData*>(packet.pSideData);
   avpkt.side_data_elems = packet.iSideDataElems;
 
-  int ret = avcodec_send_packet(m_pCodecContext, &avpkt);
+  int ret = avcodec_send_packet(context, &avpkt);
 
   // try again
   if (ret == AVERROR(EAGAIN))
@@ -612,6 +804,8 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
     return VC_EOF;
   }
 
+  CThreadControl::CBusyTimer busyTimer(m_threadCtrl);
+
   // handle hw accelerators first, they may have frames ready
   if (m_pHardware)
   {
@@ -660,6 +854,17 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
 
   int ret = avcodec_receive_frame(m_pCodecContext, m_pDecodedFrame);
 
+  // the decoder of the previous thread config is drained, continue with the new one
+  if (ret == AVERROR_EOF && m_pNextCodecContext)
+  {
+    avcodec_free_context(&m_pCodecContext);
+    m_pCodecContext = m_pNextCodecContext;
+    m_pNextCodecContext = nullptr;
+    if (m_codecControlFlags & DVD_CODEC_CTRL_DRAIN)
+      avcodec_send_packet(m_pCodecContext, nullptr);
+    ret = avcodec_receive_frame(m_pCodecContext, m_pDecodedFrame);
+  }
+
   if (m_decoderState == STATE_HW_FAILED && !m_pHardware)
     return VC_REOPEN;
 
@@ -798,6 +1003,11 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
   // process filters for sw decoding
   else
   {
+    // switch threads if the decoder turned out to be too slow or unnecessarily heavy
+    const bool measuring = m_threadCtrl.IsMeasuring();
+    if (!m_threadCtrl.AddFrame() && measuring && !m_threadCtrl.IsMeasuring())
+      m_processInfo.SetVideoDecoderThreads(m_threadCtrl.GetDescription());
+
     SetFilters();
 
     bool need_scale = std::find(m_formats.begin(),
@@ -882,6 +1092,15 @@ void CDVDVideoCodecFFmpeg::Reset()
   m_skippedDeint = 0;
   m_droppedFrames = 0;
   m_eof = false;
+
+  // the next decoder got packets already, its thread config is the current one now
+  if (m_pNextCodecContext)
+  {
+    avcodec_free_context(&m_pCodecContext);
+    m_pCodecContext = m_pNextCodecContext;
+    m_pNextCodecContext = nullptr;
+  }
+
   m_iLastKeyframe = m_pCodecContext->has_b_frames;
   avcodec_flush_buffers(m_pCodecContext);
   av_frame_unref(m_pFrame);
@@ -892,6 +1111,7 @@ void CDVDVideoCodecFFmpeg::Reset()
   m_filters = "";
   FilterClose();
   m_dropCtrl.Reset(false);
+  m_threadCtrl.Restart();
 }
 
 void CDVDVideoCodecFFmpeg::Reopen()
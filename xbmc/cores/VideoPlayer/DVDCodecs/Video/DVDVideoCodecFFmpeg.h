@@ -12,6 +12,7 @@
 #include "cores/VideoPlayer/DVDStreamInfo.h"
 #include "DVDVideoCodec.h"
 #include "DVDVideoPPFFmpeg.h"
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -55,6 +56,8 @@ protected:
   void SetFilters();
   void UpdateName();
   bool SetPictureParams(VideoPicture* pVideoPicture);
+  void SetupContext(AVCodecContext* context);
+  void SwitchThreads();
 
   bool HasHardware() { return m_pHardware != nullptr; };
   void SetHardware(IHardwareDecoder *hardware);
@@ -62,6 +65,7 @@ protected:
   AVFrame* m_pFrame = nullptr;;
   AVFrame* m_pDecodedFrame = nullptr;;
   AVCodecContext* m_pCodecContext = nullptr;;
+  AVCodecContext* m_pNextCodecContext = nullptr; // gets packets while m_pCodecContext is drained
   std::shared_ptr<CVideoBufferPoolFFmpeg> m_videoBufferPool;
 
   std::string m_filters;
@@ -114,4 +118,47 @@ protected:
       VALID
     } m_state;
   } m_dropCtrl;
+
+  // picks thread type and count for software decoding, in auto mode the decode time
+  // of the first frames decides whether the decoder switches to another config
+  struct CThreadControl
+  {
+    void Init(const AVCodec* codec, const CDVDStreamInfo& hints);
+    void Apply(AVCodecContext* avctx);
+    void Restart();
+    bool AddFrame();
+    void CancelSwitch();
+    std::string GetDescription() const;
+    bool IsMeasuring() const { return m_auto && !m_tuned && !IsSwitchPending(); }
+    bool IsSwitchPending() const { return m_next != m_current; }
+
+    struct Config
+    {
+      int type;
+      int count;
+    };
+    std::vector<Config> m_configs; // ordered by resource usage
+    size_t m_current = 0;
+    size_t m_next = 0; // applied at the next keyframe
+    bool m_auto = false;
+    bool m_tuned = false;
+    bool m_wentUp = false;
+    int m_reopens = 0;
+    int m_frames = 0;
+    int m_windowFrames = 0;
+    double m_frameTime = 0.0; // us
+    double m_load = 0.0;
+    std::chrono::steady_clock::duration m_busyTime{};
+
+    class CBusyTimer
+    {
+    public:
+      explicit CBusyTimer(CThreadControl& ctrl);
+      ~CBusyTimer();
+    private:
+      CThreadControl& m_ctrl;
+      bool m_active;
+      std::chrono::steady_clock::time_point m_start;
+    };
+  } m_threadCtrl;
 };
@@ -18,6 +18,7 @@ struct DemuxPacket;
 struct DemuxCryptoSession;
 
 class CDVDInputStream;
+class CDemuxKeyframeIndex;
 
 namespace ADDON
 {
@@ -349,6 +350,12 @@ public:
    */
   virtual void SetVideoResolution(int width, int height){};
 
+  /*
+   * sets the keyframe index of the file
+   * demuxers of containers without an index can use it for seeking and extend it while reading
+   */
+  virtual void SetKeyframeIndex(std::shared_ptr<CDemuxKeyframeIndex> index) {}
+
   /*
   * return the id of the demuxer
   */
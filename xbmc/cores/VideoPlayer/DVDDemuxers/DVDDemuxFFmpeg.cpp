@@ -9,6 +9,8 @@
 #include "DVDDemuxFFmpeg.h"
 
 #include "DVDDemuxUtils.h"
+#include "DemuxKeyframeIndex.h"
+#include "DemuxReadAhead.h"
 #include "DVDInputStreams/DVDInputStream.h"
 #include "DVDInputStreams/DVDInputStreamFFmpeg.h"
 #include "ServiceBroker.h"
@@ -26,6 +28,7 @@
 #include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "utils/StringUtils.h"
+#include "utils/StreamDetails.h"
 #include "utils/URIUtils.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
@@ -93,6 +96,10 @@ bool AttachmentIsFont(const AVDictionaryEntry* dict)
   }
   return false;
 }
+
+// limits of stream analysis if the streams of a file are known from a previous run
+constexpr int64_t FAST_START_ANALYZE_DURATION = 500000; // us
+constexpr int64_t FAST_START_PROBE_SIZE = 2 * 1024 * 1024;
 } // namespace
 
 #define FF_MAX_EXTRADATA_SIZE ((1 << 28) - AV_INPUT_BUFFER_PADDING_SIZE)
@@ -225,7 +232,9 @@ bool CDVDDemuxFFmpeg::Aborted()
   return false;
 }
 
-bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool fileinfo)
+bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput,
+                           bool fileinfo,
+                           const CStreamDetails* knownStreams)
 {
   AVInputFormat* iformat = NULL;
   std::string strFile;
@@ -534,14 +543,40 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
   m_bAVI = strcmp(m_pFormatContext->iformat->name, "avi") == 0;
   m_bSup = strcmp(m_pFormatContext->iformat->name, "sup") == 0;
 
+  // the streams are known from a previous run, only analyse until the primary streams
+  // are found. anything not found yet is filled in by the codecs when they see data.
+  // falling back to a full analysis rewinds the input, so it has to be seekable.
+  const bool fastStart = knownStreams && knownStreams->HasItems() && !fileinfo &&
+                         !m_checkTransportStream && !isBluray &&
+                         !m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD) &&
+                         (!m_ioContext || m_ioContext->seekable);
+
   if (m_streaminfo)
   {
     /* to speed up dvd switches, only analyse very short */
     if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD))
       av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
 
+    if (fastStart)
+    {
+      av_opt_set_int(m_pFormatContext, "analyzeduration", FAST_START_ANALYZE_DURATION, 0);
+      av_opt_set_int(m_pFormatContext, "probesize", FAST_START_PROBE_SIZE, 0);
+    }
+
     CLog::Log(LOGDEBUG, "%s - avformat_find_stream_info starting", __FUNCTION__);
     int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+    if (fastStart && (iErr < 0 || !HasPrimaryStreams(*knownStreams)))
+    {
+      CLog::Log(LOGDEBUG, "%s - short stream analysis incomplete, reopening with full analysis",
+                __FUNCTION__);
+      std::shared_ptr<CDVDInputStream> pInputStream = m_pInput;
+      bool isFFmpegStream = m_pInput->IsStreamType(DVDSTREAM_TYPE_FFMPEG);
+      Dispose();
+      if (!isFFmpegStream && pInputStream->Seek(0, SEEK_SET) < 0)
+        return false;
+      return Open(pInputStream, fileinfo);
+    }
+
     if (iErr < 0)
     {
       CLog::Log(LOGWARNING,"could not find codec parameters for %s", CURL::GetRedacted(strFile).c_str());
@@ -650,6 +685,14 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
   m_startTime = 0;
   m_seekStream = -1;
 
+  // mpeg transport and program streams have no index, seeks bisect the file
+  m_keyframeIndexSupported =
+      (strcmp(m_pFormatContext->iformat->name, "mpegts") == 0 ||
+       strcmp(m_pFormatContext->iformat->name, "mpeg") == 0) &&
+      m_ioContext && m_ioContext->seekable && !m_pInput->IsRealtime() &&
+      !(m_pFormatContext->iformat->flags & AVFMT_NO_BYTE_SEEK);
+  m_keyframeIndexStream = -1;
+
   if (m_checkTransportStream && m_streaminfo)
   {
     int64_t duration = m_pFormatContext->duration;
@@ -661,11 +704,45 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     m_pFormatContext->duration = duration;
   }
 
+  UpdateFormatInfo();
+
+  if (!fileinfo && !m_readAhead)
+    StartReadAhead();
+
   return true;
 }
 
+void CDVDDemuxFFmpeg::StartReadAhead()
+{
+  // only plain files of network shares, other inputs don't stall or have their
+  // own buffering
+  if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoDemuxAhead ||
+      !m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) || m_pInput->IsRealtime() ||
+      URIUtils::IsInternetStream(m_pInput->GetFileName()) ||
+      !URIUtils::IsRemote(m_pInput->GetFileName()))
+    return;
+
+  m_readAhead = std::make_unique<CDemuxReadAhead>(
+      [this](CDemuxStream*& stream) {
+        DemuxPacket* packet = ReadPacket();
+        UpdateFormatInfo();
+        stream = packet && packet->iStreamId >= 0 ? GetStream(packet->iStreamId) : nullptr;
+        return packet;
+      },
+      [this](bool interrupt) {
+        if (interrupt)
+          m_timeout.SetExpired();
+        else
+          m_timeout.SetInfinite();
+      });
+  m_readAhead->Start();
+}
+
 void CDVDDemuxFFmpeg::Dispose()
 {
+  m_readAhead.reset();
+  m_readAheadStream = nullptr;
+
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
@@ -688,8 +765,11 @@ void CDVDDemuxFFmpeg::Dispose()
   m_ioContext = NULL;
   m_pFormatContext = NULL;
   m_speed = DVD_PLAYSPEED_NORMAL;
+  m_programCount = 0;
+  m_programPlaying = UINT_MAX;
 
   DisposeStreams();
+  DeleteReleasedStreams(UINT64_MAX);
 
   m_pInput = NULL;
 }
@@ -703,6 +783,9 @@ bool CDVDDemuxFFmpeg::Reset()
 
 void CDVDDemuxFFmpeg::Flush()
 {
+  CDemuxReadAhead::CHold hold(m_readAhead.get());
+  hold.Flush();
+
   if (m_pFormatContext)
   {
     if (m_pFormatContext->pb)
@@ -730,6 +813,11 @@ void CDVDDemuxFFmpeg::SetSpeed(int iSpeed)
   if (!m_pFormatContext)
     return;
 
+  Post([this, iSpeed]() { ApplySpeed(iSpeed); });
+}
+
+void CDVDDemuxFFmpeg::ApplySpeed(int iSpeed)
+{
   if (m_speed == iSpeed)
     return;
 
@@ -739,8 +827,13 @@ void CDVDDemuxFFmpeg::SetSpeed(int iSpeed)
     av_read_play(m_pFormatContext);
   m_speed = iSpeed;
 
+  // in trick play the player decodes keyframes only
+  const bool trickPlay =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoTrickPlayFps > 0;
+
   AVDiscard discard = AVDISCARD_NONE;
-  if (m_speed > 4 * DVD_PLAYSPEED_NORMAL)
+  if (m_speed > 4 * DVD_PLAYSPEED_NORMAL ||
+      (trickPlay && m_speed > 2 * DVD_PLAYSPEED_NORMAL))
     discard = AVDISCARD_NONKEY;
   else if (m_speed > 2 * DVD_PLAYSPEED_NORMAL)
     discard = AVDISCARD_BIDIR;
@@ -985,6 +1078,21 @@ double CDVDDemuxFFmpeg::ConvertTimestamp(int64_t pts, int den, int num)
 }
 
 DemuxPacket* CDVDDemuxFFmpeg::Read()
+{
+  if (!m_readAhead)
+  {
+    DemuxPacket* packet = ReadPacket();
+    UpdateFormatInfo();
+    return packet;
+  }
+
+  // the player is done with the packets it got before
+  DeleteReleasedStreams(m_readAhead->GetConsumedCount());
+
+  return m_readAhead->Read(m_readAheadStream);
+}
+
+DemuxPacket* CDVDDemuxFFmpeg::ReadPacket()
 {
   DemuxPacket* pPacket = NULL;
   // on some cases where the received packet is invalid we will need to return an empty packet (0 length) otherwise the main loop (in CVideoPlayer)
@@ -1103,6 +1211,10 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
         pPacket->pts = ConvertTimestamp(m_pkt.pkt.pts, stream->time_base.den, stream->time_base.num);
         pPacket->dts = ConvertTimestamp(m_pkt.pkt.dts, stream->time_base.den, stream->time_base.num);
         pPacket->duration =  DVD_SEC_TO_TIME((double)m_pkt.pkt.duration * stream->time_base.num / stream->time_base.den);
+        pPacket->keyframe = (m_pkt.pkt.flags & AV_PKT_FLAG_KEY) != 0;
+
+        if (m_keyframeIndex && m_keyframeIndexSupported)
+          AddKeyframe(stream);
 
         CDVDDemuxUtils::StoreSideData(pPacket, &m_pkt.pkt);
 
@@ -1198,6 +1310,8 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
   if (!m_pInput)
     return false;
 
+  CDemuxReadAhead::CHold hold(m_readAhead.get());
+
   if (time < 0)
   {
     time = 0;
@@ -1237,7 +1351,7 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 
     while (!IsTransportStreamReady())
     {
-      DemuxPacket* pkt = Read();
+      DemuxPacket* pkt = ReadPacket();
       if (pkt)
         CDVDDemuxUtils::FreeDemuxPacket(pkt);
       else
@@ -1259,6 +1373,26 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
   else if (m_pFormatContext->start_time != (int64_t)AV_NOPTS_VALUE && !ismp3 && !m_bSup)
     seek_pts += m_pFormatContext->start_time;
 
+  if (m_keyframeIndex && m_keyframeIndexSupported && !hitEnd)
+  {
+    int64_t timestamp = seek_pts / (AV_TIME_BASE / 1000);
+    if (m_checkTransportStream)
+      timestamp = av_rescale_q(seek_pts, m_pFormatContext->streams[m_seekStream]->time_base,
+                               AVRational{1, 1000});
+
+    CDemuxKeyframeIndex::Entry keyframe;
+    if (m_keyframeIndex->Find(timestamp, backwards, keyframe) && SeekByte(keyframe.pos))
+    {
+      CLog::Log(LOGDEBUG, "%s - seek to keyframe at %lld ms from index", __FUNCTION__,
+                static_cast<long long>(keyframe.timestamp));
+
+      if (startpts)
+        *startpts = DVD_MSEC_TO_TIME(time);
+
+      return true;
+    }
+  }
+
   int ret;
   {
     CSingleLock lock(m_critSection);
@@ -1309,6 +1443,7 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 
   if (ret >= 0)
   {
+    hold.Flush();
     if (!hitEnd)
       return true;
     else
@@ -1320,11 +1455,15 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 
 bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
 {
+  CDemuxReadAhead::CHold hold(m_readAhead.get());
   CSingleLock lock(m_critSection);
   int ret = av_seek_frame(m_pFormatContext, -1, pos, AVSEEK_FLAG_BYTE);
 
   if (ret >= 0)
+  {
+    hold.Flush();
     UpdateCurrentPTS();
+  }
 
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
@@ -1332,6 +1471,32 @@ bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
   return (ret >= 0);
 }
 
+void CDVDDemuxFFmpeg::SetKeyframeIndex(std::shared_ptr<CDemuxKeyframeIndex> index)
+{
+  Post([this, index]() { m_keyframeIndex = index; });
+}
+
+void CDVDDemuxFFmpeg::AddKeyframe(const AVStream* stream)
+{
+  if (!(m_pkt.pkt.flags & AV_PKT_FLAG_KEY) || m_pkt.pkt.pos < 0 ||
+      stream->codecpar->codec_type != AVMEDIA_TYPE_VIDEO ||
+      (stream->disposition & AV_DISPOSITION_ATTACHED_PIC))
+    return;
+
+  // index the first video stream only
+  if (m_keyframeIndexStream < 0)
+    m_keyframeIndexStream = stream->index;
+  else if (m_keyframeIndexStream != stream->index)
+    return;
+
+  int64_t timestamp = m_pkt.pkt.pts != AV_NOPTS_VALUE ? m_pkt.pkt.pts : m_pkt.pkt.dts;
+  if (timestamp == AV_NOPTS_VALUE)
+    return;
+
+  m_keyframeIndex->Add(av_rescale_q(timestamp, stream->time_base, AVRational{1, 1000}),
+                       m_pkt.pkt.pos);
+}
+
 void CDVDDemuxFFmpeg::UpdateCurrentPTS()
 {
   m_currentPts = DVD_NOPTS_VALUE;
@@ -1350,14 +1515,53 @@ void CDVDDemuxFFmpeg::UpdateCurrentPTS()
 
 int CDVDDemuxFFmpeg::GetStreamLength()
 {
-  if (!m_pFormatContext)
-    return 0;
+  CSingleLock lock(m_streamsSection);
+  return m_streamLength;
+}
 
-  if (m_pFormatContext->duration < 0 ||
-      m_pFormatContext->duration == AV_NOPTS_VALUE)
-    return 0;
+void CDVDDemuxFFmpeg::UpdateFormatInfo()
+{
+  int streamLength = 0;
+  if (m_pFormatContext && m_pFormatContext->duration >= 0 &&
+      m_pFormatContext->duration != AV_NOPTS_VALUE)
+    streamLength = static_cast<int>(m_pFormatContext->duration / (AV_TIME_BASE / 1000));
+
+  // program names only change with the programs
+  const unsigned int programCount = m_pFormatContext ? m_pFormatContext->nb_programs : 0;
+  if (programCount != m_programCount || m_program != m_programPlaying)
+  {
+    m_programCount = programCount;
+    m_programPlaying = m_program;
+    UpdatePrograms();
+  }
+
+  CSingleLock lock(m_streamsSection);
+  m_streamLength = streamLength;
 
-  return (int)(m_pFormatContext->duration / (AV_TIME_BASE / 1000));
+  const unsigned int chapterCount = m_pFormatContext ? m_pFormatContext->nb_chapters : 0;
+  if (m_chapters.size() == chapterCount)
+    return;
+
+  m_chapters.clear();
+  for (unsigned int i = 0; i < chapterCount; i++)
+  {
+    const AVChapter* chapter = m_pFormatContext->chapters[i];
+    const AVDictionaryEntry* titleTag = av_dict_get(chapter->metadata, "title", NULL, 0);
+    m_chapters.push_back(
+        {ConvertTimestamp(chapter->start, chapter->time_base.den, chapter->time_base.num),
+         ConvertTimestamp(chapter->end, chapter->time_base.den, chapter->time_base.num),
+         static_cast<int64_t>(chapter->start * av_q2d(chapter->time_base)),
+         titleTag ? titleTag->value : ""});
+  }
+}
+
+CDemuxStream* CDVDDemuxFFmpeg::GetStream(int64_t demuxerId, int iStreamId) const
+{
+  // the stream may have changed since the last packet from the read ahead was demuxed
+  if (m_readAheadStream && m_readAheadStream->uniqueId == iStreamId)
+    return m_readAheadStream;
+
+  return GetStream(iStreamId);
 }
 
 /**
@@ -1365,6 +1569,7 @@ int CDVDDemuxFFmpeg::GetStreamLength()
  */
 CDemuxStream* CDVDDemuxFFmpeg::GetStream(int iStreamId) const
 {
+  CSingleLock lock(m_streamsSection);
   auto it = m_streams.find(iStreamId);
   if (it != m_streams.end())
     return it->second;
@@ -1376,6 +1581,7 @@ std::vector<CDemuxStream*> CDVDDemuxFFmpeg::GetStreams() const
 {
   std::vector<CDemuxStream*> streams;
 
+  CSingleLock lock(m_streamsSection);
   for (auto& iter : m_streams)
     streams.push_back(iter.second);
 
@@ -1384,16 +1590,23 @@ std::vector<CDemuxStream*> CDVDDemuxFFmpeg::GetStreams() const
 
 int CDVDDemuxFFmpeg::GetNrOfStreams() const
 {
+  CSingleLock lock(m_streamsSection);
   return static_cast<int>(m_streams.size());
 }
 
 int CDVDDemuxFFmpeg::GetPrograms(std::vector<ProgramInfo>& programs)
 {
-  programs.clear();
-  if (!m_pFormatContext || m_pFormatContext->nb_programs <= 1)
-    return 0;
+  CSingleLock lock(m_streamsSection);
+  programs = m_programs;
+  return static_cast<int>(programs.size());
+}
 
-  for (unsigned int i = 0; i < m_pFormatContext->nb_programs; i++)
+void CDVDDemuxFFmpeg::UpdatePrograms()
+{
+  std::vector<ProgramInfo> programs;
+  const unsigned int programCount =
+      m_pFormatContext && m_pFormatContext->nb_programs > 1 ? m_pFormatContext->nb_programs : 0;
+  for (unsigned int i = 0; i < programCount; i++)
   {
     std::ostringstream os;
     ProgramInfo prog;
@@ -1415,12 +1628,22 @@ int CDVDDemuxFFmpeg::GetPrograms(std::vector<ProgramInfo>& programs)
     prog.name = os.str();
     programs.push_back(prog);
   }
-  return static_cast<int>(programs.size());
+
+  CSingleLock lock(m_streamsSection);
+  m_programs = std::move(programs);
 }
 
 void CDVDDemuxFFmpeg::SetProgram(int progId)
 {
-  m_newProgram = progId;
+  Post([this, progId]() { m_newProgram = progId; });
+}
+
+void CDVDDemuxFFmpeg::Post(std::function<void()> call)
+{
+  if (m_readAhead)
+    m_readAhead->Post(std::move(call));
+  else
+    call();
 }
 
 double CDVDDemuxFFmpeg::SelectAspect(AVStream* st, bool& forced)
@@ -1523,13 +1746,32 @@ void CDVDDemuxFFmpeg::CreateStreams(unsigned int program)
 
 void CDVDDemuxFFmpeg::DisposeStreams()
 {
+  CSingleLock lock(m_streamsSection);
   std::map<int, CDemuxStream*>::iterator it;
   for(it = m_streams.begin(); it != m_streams.end(); ++it)
-    delete it->second;
+    ReleaseStream(it->second);
   m_streams.clear();
   m_parsers.clear();
 }
 
+void CDVDDemuxFFmpeg::ReleaseStream(CDemuxStream* stream)
+{
+  if (m_readAhead)
+    m_releasedStreams.emplace_back(m_readAhead->GetReadCount(), stream);
+  else
+    delete stream;
+}
+
+void CDVDDemuxFFmpeg::DeleteReleasedStreams(uint64_t consumedCount)
+{
+  CSingleLock lock(m_streamsSection);
+  auto it = m_releasedStreams.begin();
+  for (; it != m_releasedStreams.end() && it->first <= consumedCount; ++it)
+    delete it->second;
+
+  m_releasedStreams.erase(m_releasedStreams.begin(), it);
+}
+
 CDemuxStream* CDVDDemuxFFmpeg::AddStream(int streamIdx)
 {
   AVStream* pStream = m_pFormatContext->streams[streamIdx];
@@ -1847,6 +2089,7 @@ void CDVDDemuxFFmpeg::AddStream(int streamIdx, CDemuxStream* stream)
 {
   std::pair<std::map<int, CDemuxStream*>::iterator, bool> res;
 
+  CSingleLock lock(m_streamsSection);
   res = m_streams.insert(std::make_pair(streamIdx, stream));
   if (res.second)
   {
@@ -1855,7 +2098,7 @@ void CDVDDemuxFFmpeg::AddStream(int streamIdx, CDemuxStream* stream)
   }
   else
   {
-    delete res.first->second;
+    ReleaseStream(res.first->second);
     res.first->second = stream;
   }
   CLog::Log(LOGDEBUG, "CDVDDemuxFFmpeg::AddStream ID: %d", streamIdx);
@@ -1876,10 +2119,8 @@ int CDVDDemuxFFmpeg::GetChapterCount()
   if (ich)
     return ich->GetChapterCount();
 
-  if (m_pFormatContext == NULL)
-    return 0;
-
-  return m_pFormatContext->nb_chapters;
+  CSingleLock lock(m_streamsSection);
+  return static_cast<int>(m_chapters.size());
 }
 
 int CDVDDemuxFFmpeg::GetChapter()
@@ -1888,16 +2129,15 @@ int CDVDDemuxFFmpeg::GetChapter()
   if (ich)
     return ich->GetChapter();
 
-  if (m_pFormatContext == NULL
-  || m_currentPts == DVD_NOPTS_VALUE)
+  const double currentPts = m_currentPts;
+  if (currentPts == DVD_NOPTS_VALUE)
     return 0;
 
-  for(unsigned i = 0; i < m_pFormatContext->nb_chapters; i++)
+  CSingleLock lock(m_streamsSection);
+  for (size_t i = 0; i < m_chapters.size(); i++)
   {
-    AVChapter* chapter = m_pFormatContext->chapters[i];
-    if (m_currentPts >= ConvertTimestamp(chapter->start, chapter->time_base.den, chapter->time_base.num)
-    && m_currentPts <  ConvertTimestamp(chapter->end,   chapter->time_base.den, chapter->time_base.num))
-      return i + 1;
+    if (currentPts >= m_chapters[i].start && currentPts < m_chapters[i].end)
+      return static_cast<int>(i) + 1;
   }
 
   return 0;
@@ -1915,10 +2155,10 @@ void CDVDDemuxFFmpeg::GetChapterName(std::string& strChapterName, int chapterIdx
     if (chapterIdx <= 0)
       return;
 
-    AVDictionaryEntry* titleTag = av_dict_get(m_pFormatContext->chapters[chapterIdx - 1]->metadata,
-                                                          "title", NULL, 0);
-    if (titleTag)
-      strChapterName = titleTag->value;
+    CSingleLock lock(m_streamsSection);
+    if (chapterIdx <= static_cast<int>(m_chapters.size()) &&
+        !m_chapters[chapterIdx - 1].name.empty())
+      strChapterName = m_chapters[chapterIdx - 1].name;
   }
 }
 
@@ -1933,11 +2173,17 @@ int64_t CDVDDemuxFFmpeg::GetChapterPos(int chapterIdx)
   if (ich)
     return ich->GetChapterPos(chapterIdx);
 
-  return static_cast<int64_t>(m_pFormatContext->chapters[chapterIdx - 1]->start * av_q2d(m_pFormatContext->chapters[chapterIdx - 1]->time_base));
+  CSingleLock lock(m_streamsSection);
+  if (chapterIdx > static_cast<int>(m_chapters.size()))
+    return 0;
+
+  return m_chapters[chapterIdx - 1].pos;
 }
 
 bool CDVDDemuxFFmpeg::SeekChapter(int chapter, double* startpts)
 {
+  CDemuxReadAhead::CHold hold(m_readAhead.get());
+
   if (chapter < 1)
     chapter = 1;
 
@@ -1970,6 +2216,8 @@ bool CDVDDemuxFFmpeg::SeekChapter(int chapter, double* startpts)
 
 std::string CDVDDemuxFFmpeg::GetStreamCodecName(int iStreamId)
 {
+  // streams are replaced, not changed, while packets are read ahead
+  CSingleLock lock(m_streamsSection);
   CDemuxStream* stream = GetStream(iStreamId);
   std::string strName;
   if (stream)
@@ -2355,6 +2603,33 @@ void CDVDDemuxFFmpeg::ResetVideoStreams()
   }
 }
 
+bool CDVDDemuxFFmpeg::HasPrimaryStreams(const CStreamDetails& knownStreams) const
+{
+  bool hasVideo = knownStreams.GetVideoStreamCount() == 0;
+  bool hasAudio = knownStreams.GetAudioStreamCount() == 0;
+
+  for (unsigned int i = 0; i < m_pFormatContext->nb_streams; i++)
+  {
+    const AVStream* st = m_pFormatContext->streams[i];
+    const AVCodecParameters* par = st->codecpar;
+    if (par->codec_id == AV_CODEC_ID_NONE)
+      continue;
+
+    if (par->codec_type == AVMEDIA_TYPE_VIDEO && !(st->disposition & AV_DISPOSITION_ATTACHED_PIC))
+    {
+      if (par->width > 0 && par->height > 0)
+        hasVideo = true;
+    }
+    else if (par->codec_type == AVMEDIA_TYPE_AUDIO)
+    {
+      if (par->sample_rate > 0 && par->channels > 0)
+        hasAudio = true;
+    }
+  }
+
+  return hasVideo && hasAudio;
+}
+
 void CDVDDemuxFFmpeg::GetL16Parameters(int &channels, int &samplerate)
 {
   std::string content;
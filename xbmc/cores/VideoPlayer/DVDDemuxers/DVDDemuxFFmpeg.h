@@ -11,6 +11,8 @@
 #include "DVDDemux.h"
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
@@ -75,6 +77,8 @@ public:
 
 #define FFMPEG_DVDNAV_BUFFER_SIZE 2048  // for dvd's
 
+class CDemuxReadAhead;
+class CStreamDetails;
 struct StereoModeConversionMap;
 
 class CDVDDemuxFFmpeg : public CDVDDemux
@@ -83,7 +87,14 @@ public:
   CDVDDemuxFFmpeg();
   ~CDVDDemuxFFmpeg() override;
 
-  bool Open(const std::shared_ptr<CDVDInputStream>& pInput, bool fileinfo);
+  /*!
+   \brief Open the demuxer
+   \param knownStreams stream details of the file from a previous run, if set stream
+   analysis stops as soon as the primary streams are found
+   */
+  bool Open(const std::shared_ptr<CDVDInputStream>& pInput,
+            bool fileinfo,
+            const CStreamDetails* knownStreams = nullptr);
   void Dispose();
   bool Reset() override ;
   void Flush() override;
@@ -95,7 +106,9 @@ public:
 
   bool SeekTime(double time, bool backwards = false, double* startpts = NULL) override;
   bool SeekByte(int64_t pos);
+  void SetKeyframeIndex(std::shared_ptr<CDemuxKeyframeIndex> index) override;
   int GetStreamLength() override;
+  CDemuxStream* GetStream(int64_t demuxerId, int iStreamId) const override;
   CDemuxStream* GetStream(int iStreamId) const override;
   std::vector<CDemuxStream*> GetStreams() const override;
   int GetNrOfStreams() const override;
@@ -119,19 +132,29 @@ protected:
   friend class CDemuxStreamVideoFFmpeg;
   friend class CDemuxStreamSubtitleFFmpeg;
 
+  DemuxPacket* ReadPacket();
+  void StartReadAhead();
+  void Post(std::function<void()> call);
+  void ApplySpeed(int iSpeed);
+  void UpdateFormatInfo();
+  void UpdatePrograms();
   CDemuxStream* AddStream(int streamIdx);
   void AddStream(int streamIdx, CDemuxStream* stream);
   void CreateStreams(unsigned int program = UINT_MAX);
   void DisposeStreams();
+  void ReleaseStream(CDemuxStream* stream);
+  void DeleteReleasedStreams(uint64_t consumedCount);
   void ParsePacket(AVPacket* pkt);
   TRANSPORT_STREAM_STATE TransportStreamAudioState();
   TRANSPORT_STREAM_STATE TransportStreamVideoState();
   bool IsTransportStreamReady();
   void ResetVideoStreams();
+  bool HasPrimaryStreams(const CStreamDetails& knownStreams) const;
+  void AddKeyframe(const AVStream* stream);
   AVDictionary* GetFFMpegOptionsFromInput();
   double ConvertTimestamp(int64_t pts, int den, int num);
   void UpdateCurrentPTS();
-  bool IsProgramChange();
+  bool IsProgramChange(); // called by the thread reading the packets only
   unsigned int HLSSelectProgram();
 
   std::string GetStereoModeFromMetadata(AVDictionary* pMetadata);
@@ -141,12 +164,13 @@ protected:
   double SelectAspect(AVStream* st, bool& forced);
 
   CCriticalSection m_critSection;
+  mutable CCriticalSection m_streamsSection;
   std::map<int, CDemuxStream*> m_streams;
   std::map<int, std::unique_ptr<CDemuxParserFFmpeg>> m_parsers;
 
   AVIOContext* m_ioContext;
 
-  double   m_currentPts; // used for stream length estimation
+  std::atomic<double> m_currentPts; // used for stream length estimation
   bool     m_bMatroska;
   bool     m_bAVI;
   bool     m_bSup;
@@ -175,5 +199,30 @@ protected:
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
   double m_startTime = 0;
+
+  std::shared_ptr<CDemuxKeyframeIndex> m_keyframeIndex;
+  bool m_keyframeIndexSupported = false;
+  int m_keyframeIndexStream = -1;
+
+  // packets are read on the read ahead thread, the player may use a stream until
+  // it consumed all packets read before the stream was released
+  std::unique_ptr<CDemuxReadAhead> m_readAhead;
+
+  // chapters, programs and length as of the last packet read, the format context must not
+  // be used by the player while packets are read ahead. guarded by m_streamsSection.
+  struct ChapterInfo
+  {
+    double start;
+    double end;
+    int64_t pos; // seconds
+    std::string name;
+  };
+  std::vector<ChapterInfo> m_chapters;
+  std::vector<ProgramInfo> m_programs;
+  unsigned int m_programCount = 0; // programs and playing program of m_programs
+  unsigned int m_programPlaying = UINT_MAX;
+  int m_streamLength = 0;
+  CDemuxStream* m_readAheadStream = nullptr;
+  std::vector<std::pair<uint64_t, CDemuxStream*>> m_releasedStreams;
 };
 
@@ -18,7 +18,8 @@
 #include "utils/log.h"
 
 CDVDDemux* CDVDFactoryDemuxer::CreateDemuxer(const std::shared_ptr<CDVDInputStream>& pInputStream,
-                                             bool fileinfo)
+                                             bool fileinfo,
+                                             const CStreamDetails* knownStreams)
 {
   if (!pInputStream)
     return NULL;
@@ -72,7 +73,7 @@ CDVDDemux* CDVDFactoryDemuxer::CreateDemuxer(const std::shared_ptr<CDVDInputStre
   }
 
   std::unique_ptr<CDVDDemuxFFmpeg> demuxer(new CDVDDemuxFFmpeg());
-  if (demuxer->Open(pInputStream, fileinfo))
+  if (demuxer->Open(pInputStream, fileinfo, knownStreams))
     return demuxer.release();
   else
     return NULL;
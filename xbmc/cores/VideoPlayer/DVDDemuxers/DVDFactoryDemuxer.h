@@ -12,10 +12,12 @@
 
 class CDVDDemux;
 class CDVDInputStream;
+class CStreamDetails;
 
 class CDVDFactoryDemuxer
 {
 public:
   static CDVDDemux* CreateDemuxer(const std::shared_ptr<CDVDInputStream>& pInputStream,
-                                  bool fileinfo = false);
+                                  bool fileinfo = false,
+                                  const CStreamDetails* knownStreams = nullptr);
 };
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxKeyframeIndex.h"
+
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+// one keyframe per second is precise enough for seeking and keeps the index small
+constexpr int64_t MIN_INTERVAL = 1000;
+// keyframes further apart than this are not from a continuously read part of the file
+constexpr int64_t MAX_GAP = 10000;
+// keeps the serialized index within the size of a text column on all database backends
+constexpr size_t MAX_STORED_ENTRIES = 4000;
+
+bool ParseInt(const std::string& str, int64_t& value)
+{
+  if (str.empty())
+    return false;
+
+  char* end = nullptr;
+  value = std::strtoll(str.c_str(), &end, 10);
+  return *end == '\0';
+}
+} // unnamed namespace
+
+void CDemuxKeyframeIndex::Add(int64_t timestamp, int64_t pos)
+{
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), timestamp,
+                             [](const Entry& entry, int64_t ts) { return entry.timestamp < ts; });
+
+  // timestamps and positions have to grow together, anything else is a timestamp
+  // wrap or discontinuity we can't seek by
+  if (it != m_entries.begin())
+  {
+    const Entry& prev = *(it - 1);
+    if (timestamp - prev.timestamp < MIN_INTERVAL || pos <= prev.pos)
+      return;
+  }
+  if (it != m_entries.end())
+  {
+    if (it->timestamp - timestamp < MIN_INTERVAL || pos >= it->pos)
+      return;
+  }
+
+  m_entries.insert(it, {timestamp, pos});
+  m_changed = true;
+}
+
+bool CDemuxKeyframeIndex::Find(int64_t timestamp, bool backwards, Entry& entry) const
+{
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), timestamp,
+                             [](const Entry& entry, int64_t ts) { return entry.timestamp < ts; });
+
+  if (it != m_entries.end() && it->timestamp == timestamp)
+  {
+    entry = *it;
+    return true;
+  }
+
+  // the timestamp has to lie between two keyframes of a continuously indexed part
+  if (it == m_entries.begin() || it == m_entries.end())
+    return false;
+
+  auto prev = it - 1;
+  if (it->timestamp - prev->timestamp > GetMaxGap())
+    return false;
+
+  entry = backwards ? *prev : *it;
+  return true;
+}
+
+std::string CDemuxKeyframeIndex::Serialize() const
+{
+  // thin out by timestamp distance, keyframes kept from an earlier store are kept again. every
+  // second keyframe kept is more than one interval after the one before the last, hence twice
+  // the span per interval keeps the continuously indexed parts within the limit.
+  int64_t interval = m_interval;
+  if (m_entries.size() > MAX_STORED_ENTRIES)
+  {
+    const int64_t span = m_entries.back().timestamp - m_entries.front().timestamp;
+    const int64_t maxEntries = static_cast<int64_t>(MAX_STORED_ENTRIES);
+    interval = std::max({interval, MIN_INTERVAL, (2 * span + maxEntries - 1) / maxEntries});
+  }
+
+  const int64_t maxGap = GetMaxGap();
+  std::string data = StringUtils::Format("{};", interval);
+
+  // deltas to the previous entry keep the string short
+  Entry last = {0, 0};
+  size_t stored = 0;
+  for (size_t i = 0; i < m_entries.size() && stored < MAX_STORED_ENTRIES; i++)
+  {
+    const Entry& entry = m_entries[i];
+
+    // keep the first and last keyframe of every continuously indexed part and the last
+    // keyframe before the distance to the previously kept one exceeds the interval
+    if (interval > 0 && i > 0 && i + 1 < m_entries.size())
+    {
+      const Entry& prev = m_entries[i - 1];
+      const Entry& next = m_entries[i + 1];
+      if (entry.timestamp - prev.timestamp <= maxGap && next.timestamp - entry.timestamp <= maxGap &&
+          next.timestamp - last.timestamp <= interval)
+        continue;
+    }
+
+    if (stored > 0)
+      data += ',';
+    data += StringUtils::Format("{}:{}", entry.timestamp - last.timestamp, entry.pos - last.pos);
+    last = entry;
+    stored++;
+  }
+  return data;
+}
+
+bool CDemuxKeyframeIndex::Deserialize(const std::string& data)
+{
+  m_entries.clear();
+  m_interval = 0;
+  m_changed = false;
+
+  std::string entries = data;
+  const size_t separator = data.find(';');
+  if (separator != std::string::npos)
+  {
+    int64_t interval;
+    if (!ParseInt(data.substr(0, separator), interval) || interval < 0)
+      return false;
+    m_interval = interval;
+    entries = data.substr(separator + 1);
+  }
+
+  Entry last = {0, 0};
+  for (const std::string& item : StringUtils::Split(entries, ","))
+  {
+    const std::vector<std::string> fields = StringUtils::Split(item, ":");
+    int64_t timestamp;
+    int64_t pos;
+    if (fields.size() != 2 || !ParseInt(fields[0], timestamp) || !ParseInt(fields[1], pos) ||
+        (!m_entries.empty() && (timestamp <= 0 || pos <= 0)))
+    {
+      m_entries.clear();
+      return false;
+    }
+
+    last.timestamp += timestamp;
+    last.pos += pos;
+    m_entries.push_back(last);
+  }
+  return true;
+}
+
+int64_t CDemuxKeyframeIndex::GetMaxGap() const
+{
+  return MAX_GAP + m_interval;
+}
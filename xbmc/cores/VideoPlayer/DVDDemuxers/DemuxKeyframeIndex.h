@@ -0,0 +1,58 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Keyframe positions of a file whose container has no index
+
+ The demuxer adds the keyframes it reads during playback, the index is stored
+ in the video database and loaded again the next time the file is played.
+ Seeks within the indexed parts of the file go straight to the byte position
+ of a keyframe instead of bisecting the file.
+
+ Timestamps are absolute stream timestamps in ms. The index is not thread safe,
+ it is used by the thread reading the demuxer while it is set on the demuxer.
+ */
+class CDemuxKeyframeIndex
+{
+public:
+  struct Entry
+  {
+    int64_t timestamp;
+    int64_t pos;
+  };
+
+  void Add(int64_t timestamp, int64_t pos);
+
+  /*!
+   \brief Find the keyframe closest to a timestamp
+   \param backwards find the keyframe before instead of after the timestamp
+   \return false if the timestamp is not within an indexed part of the file
+   */
+  bool Find(int64_t timestamp, bool backwards, Entry& entry) const;
+
+  bool IsEmpty() const { return m_entries.empty(); }
+  bool IsChanged() const { return m_changed; }
+
+  std::string Serialize() const;
+  bool Deserialize(const std::string& data);
+
+private:
+  int64_t GetMaxGap() const;
+
+  std::vector<Entry> m_entries;
+  // smallest distance between the keyframes of a long index that was thinned out to be stored,
+  // the keyframes of continuously indexed parts are up to this much further apart
+  int64_t m_interval = 0;
+  bool m_changed = false;
+};
@@ -0,0 +1,262 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxReadAhead.h"
+
+#include "DVDDemuxUtils.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+// enough to bridge network hiccups, the stream queues of the player hold the rest
+constexpr size_t MAX_PACKETS = 1000;
+constexpr size_t MAX_BYTES = 4 * 1024 * 1024;
+// longest time the player waits for a packet before it handles its messages again
+constexpr unsigned int READ_WAIT = 20;
+constexpr unsigned int SLOW_READ_TIME = 100;
+constexpr unsigned int LOG_STALL_TIME = 100;
+} // unnamed namespace
+
+CDemuxReadAhead::CDemuxReadAhead(std::function<DemuxPacket*(CDemuxStream*& stream)> read,
+                                 std::function<void(bool)> interrupt)
+  : CThread("DemuxReadAhead"), m_read(std::move(read)), m_interrupt(std::move(interrupt))
+{
+}
+
+CDemuxReadAhead::~CDemuxReadAhead()
+{
+  Stop();
+}
+
+void CDemuxReadAhead::Start()
+{
+  Create();
+}
+
+void CDemuxReadAhead::Stop()
+{
+  if (IsRunning())
+  {
+    m_bStop = true;
+    m_wakeup.Set();
+
+    // the thread may be stuck in a slow read
+    while (!Join(10))
+      m_interrupt(true);
+
+    StopThread();
+    m_interrupt(false);
+  }
+
+  CSingleLock lock(m_section);
+  Clear();
+
+  if (m_stalls > 0)
+    CLog::Log(LOGDEBUG,
+              "CDemuxReadAhead::Stop - player waited %u times for %u ms in total, longest %u ms, "
+              "%u slow reads",
+              m_stalls, m_stallTime, m_maxStallTime, m_slowReads);
+}
+
+DemuxPacket* CDemuxReadAhead::Read(CDemuxStream*& stream)
+{
+  stream = nullptr;
+
+  CSingleLock lock(m_section);
+  if (m_packets.empty() && !m_eof)
+  {
+    if (m_stallStart == 0)
+      m_stallStart = XbmcThreads::SystemClockMillis();
+
+    lock.Leave();
+    m_packetReady.WaitMSec(READ_WAIT);
+    lock.Enter();
+  }
+
+  if (m_packets.empty())
+  {
+    if (!m_eof)
+      return CDVDDemuxUtils::AllocateDemuxPacket(0);
+
+    // the player decides what to do at the end, try again with its next call
+    m_eof = false;
+    m_wakeup.Set();
+    return nullptr;
+  }
+
+  if (m_stallStart != 0)
+  {
+    const unsigned int stallTime = XbmcThreads::SystemClockMillis() - m_stallStart;
+    m_stallStart = 0;
+    m_stalls++;
+    m_stallTime += stallTime;
+    m_maxStallTime = std::max(m_maxStallTime, stallTime);
+
+    if (stallTime >= LOG_STALL_TIME)
+      CLog::Log(LOGDEBUG, "CDemuxReadAhead::Read - player waited %u ms for the demuxer", stallTime);
+  }
+
+  const Packet packet = m_packets.front();
+  m_packets.pop_front();
+  m_bytes -= packet.packet->iSize;
+  m_consumedCount++;
+  m_wakeup.Set();
+
+  stream = packet.stream;
+  return packet.packet;
+}
+
+void CDemuxReadAhead::Post(std::function<void()> call)
+{
+  CSingleLock lock(m_section);
+  if (m_reading && !IsCurrentThread())
+  {
+    m_calls.emplace_back(std::move(call));
+    return;
+  }
+
+  // keep the thread from starting a read while the call runs
+  m_holds++;
+  lock.Leave();
+  call();
+  lock.Enter();
+  m_holds--;
+  m_wakeup.Set();
+}
+
+uint64_t CDemuxReadAhead::GetReadCount() const
+{
+  CSingleLock lock(m_section);
+  return m_readCount;
+}
+
+uint64_t CDemuxReadAhead::GetConsumedCount() const
+{
+  CSingleLock lock(m_section);
+  return m_consumedCount;
+}
+
+void CDemuxReadAhead::Process()
+{
+  while (!m_bStop)
+  {
+    {
+      CSingleLock lock(m_section);
+      const bool full = m_packets.size() >= MAX_PACKETS || m_bytes >= MAX_BYTES;
+      if (m_holds > 0 || m_eof || full)
+      {
+        lock.Leave();
+        AbortableWait(m_wakeup, 100);
+        continue;
+      }
+      m_reading = true;
+    }
+
+    const unsigned int start = XbmcThreads::SystemClockMillis();
+    CDemuxStream* stream = nullptr;
+    DemuxPacket* packet = m_read(stream);
+    const unsigned int readTime = XbmcThreads::SystemClockMillis() - start;
+
+    {
+      CSingleLock lock(m_section);
+      if (packet)
+      {
+        m_packets.push_back({packet, stream});
+        m_bytes += packet->iSize;
+        m_readCount++;
+      }
+      else if (!m_interrupted)
+        m_eof = true;
+      m_interrupted = false;
+
+      if (readTime >= SLOW_READ_TIME)
+        m_slowReads++;
+
+      // calls posted during the read, holds wait for them too
+      while (!m_calls.empty())
+      {
+        std::vector<std::function<void()>> calls;
+        calls.swap(m_calls);
+        lock.Leave();
+        for (const auto& call : calls)
+          call();
+        lock.Enter();
+      }
+      m_reading = false;
+    }
+    m_readDone.Set();
+    m_packetReady.Set();
+  }
+}
+
+void CDemuxReadAhead::Clear()
+{
+  for (const Packet& packet : m_packets)
+    CDVDDemuxUtils::FreeDemuxPacket(packet.packet);
+
+  m_packets.clear();
+  m_bytes = 0;
+  m_eof = false;
+  m_stallStart = 0;
+
+  // dropped packets won't reach the player, their streams may be released
+  m_consumedCount = m_readCount;
+}
+
+CDemuxReadAhead::CHold::CHold(CDemuxReadAhead* readAhead) : m_readAhead(readAhead)
+{
+  // the demuxer calls itself while reading
+  if (m_readAhead && m_readAhead->IsCurrentThread())
+    m_readAhead = nullptr;
+
+  if (!m_readAhead)
+    return;
+
+  CSingleLock lock(m_readAhead->m_section);
+  m_readAhead->m_holds++;
+
+  bool interrupted = false;
+  while (m_readAhead->m_reading)
+  {
+    // an aborted read returns no packet, that is not the end of the input
+    m_readAhead->m_interrupted = true;
+    m_readAhead->m_interrupt(true);
+    interrupted = true;
+
+    lock.Leave();
+    m_readAhead->m_readDone.WaitMSec(10);
+    lock.Enter();
+  }
+
+  if (interrupted)
+    m_readAhead->m_interrupt(false);
+}
+
+void CDemuxReadAhead::CHold::Flush()
+{
+  if (!m_readAhead)
+    return;
+
+  CSingleLock lock(m_readAhead->m_section);
+  m_readAhead->Clear();
+}
+
+CDemuxReadAhead::CHold::~CHold()
+{
+  if (!m_readAhead)
+    return;
+
+  CSingleLock lock(m_readAhead->m_section);
+  m_readAhead->m_holds--;
+  m_readAhead->m_wakeup.Set();
+}
@@ -0,0 +1,131 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <deque>
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+class CDemuxStream;
+struct DemuxPacket;
+
+/*!
+ \brief Reads demux packets ahead on its own thread
+
+ A slow read of the input stream no longer blocks the player thread, it keeps
+ handling messages while the packets it gets are buffered here. Each packet is
+ buffered together with the stream it was demuxed for.
+
+ The demuxer must not be used by the player thread while a read is in progress.
+ Seeks and flushes are made under a CHold. Other calls are passed to Post, or
+ only use state the reading thread updates under a lock after each packet.
+ */
+class CDemuxReadAhead : private CThread
+{
+public:
+  /*!
+   \param read reads the next packet and its stream, returns nullptr at the end of the input
+   \param interrupt interrupt(true) interrupts a read in progress, interrupt(false) allows
+   reading again
+   */
+  CDemuxReadAhead(std::function<DemuxPacket*(CDemuxStream*& stream)> read,
+                  std::function<void(bool)> interrupt);
+  ~CDemuxReadAhead() override;
+
+  void Start();
+  void Stop();
+
+  /*!
+   \brief Returns the next buffered packet
+   \return an empty packet if none arrived in time, nullptr at the end of the input
+   */
+  DemuxPacket* Read(CDemuxStream*& stream);
+
+  /*!
+   \brief Makes a call on the demuxer without waiting for a read in progress
+
+   The call runs right away if no read is in progress or if it is made by the
+   reading thread. Otherwise the reading thread runs it once the read finished,
+   before it reads the next packet.
+   */
+  void Post(std::function<void()> call);
+
+  /*!
+   \brief Number of packets read from the demuxer, called by the reading thread
+   */
+  uint64_t GetReadCount() const;
+
+  /*!
+   \brief Number of packets returned to or flushed by the player
+   */
+  uint64_t GetConsumedCount() const;
+
+  /*!
+   \brief Stops reading while the player thread seeks or flushes the demuxer
+
+   Aborts a read in progress and waits for it. The buffered packets are kept
+   until Flush is called, a seek that failed continues where reading stopped.
+   */
+  class CHold
+  {
+  public:
+    explicit CHold(CDemuxReadAhead* readAhead);
+    ~CHold();
+
+    CHold(const CHold&) = delete;
+    CHold& operator=(const CHold&) = delete;
+
+    /*!
+     \brief Drops all buffered packets, after the demuxer changed its position
+     */
+    void Flush();
+
+  private:
+    CDemuxReadAhead* m_readAhead;
+  };
+
+private:
+  struct Packet
+  {
+    DemuxPacket* packet;
+    CDemuxStream* stream;
+  };
+
+  void Process() override;
+  void Clear();
+
+  std::function<DemuxPacket*(CDemuxStream*& stream)> m_read;
+  std::function<void(bool)> m_interrupt;
+
+  mutable CCriticalSection m_section;
+  CEvent m_wakeup;
+  CEvent m_packetReady;
+  CEvent m_readDone;
+  std::deque<Packet> m_packets;
+  std::vector<std::function<void()>> m_calls;
+  size_t m_bytes = 0;
+  bool m_eof = false;
+  bool m_reading = false;
+  bool m_interrupted = false;
+  int m_holds = 0;
+  uint64_t m_readCount = 0;
+  uint64_t m_consumedCount = 0;
+
+  // time the player waited for packets
+  unsigned int m_stallStart = 0;
+  unsigned int m_stalls = 0;
+  unsigned int m_stallTime = 0;
+  unsigned int m_maxStallTime = 0;
+  unsigned int m_slowReads = 0;
+};
@@ -31,6 +31,8 @@
 #include "DVDCodecs/Video/DVDVideoCodec.h"
 #include "DVDCodecs/Video/DVDVideoCodecFFmpeg.h"
 #include "DVDDemuxers/DVDDemuxVobsub.h"
+#include "Buffers/YuvToRgbConverter.h"
+#include "Interface/TimingConstants.h"
 #include "Process/ProcessInfo.h"
 
 #include <libavcodec/avcodec.h>
@@ -41,8 +43,10 @@
 #include "Util.h"
 #include "utils/LangCodeExpander.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
+#include <utility>
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -86,10 +90,66 @@ int DegreeToOrientation(int degrees)
   }
 }
 
+namespace
+{
+// targets closer than this to the last decoded picture are reached by decoding forward
+constexpr int64_t FORWARD_DECODE_LIMIT_MS = 2000;
+
+bool CacheThumb(const VideoPicture& picture,
+                const CDVDStreamInfo& hint,
+                CYuvToRgbConverter& converter,
+                CTextureDetails& details)
+{
+  unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
+  double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+  if(hint.forced_aspect && hint.aspect != 0)
+    aspect = hint.aspect;
+  unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
+
+  // We pass the buffers to sws_scale uses 16 aligned widths when using intrinsics
+  int sizeNeeded = FFALIGN(nWidth, 16) * nHeight * 4;
+  uint8_t *pOutBuf = static_cast<uint8_t*>(av_malloc(sizeNeeded));
+
+  uint8_t *planes[YuvImage::MAX_PLANES];
+  int stride[YuvImage::MAX_PLANES];
+  picture.videoBuffer->GetPlanes(planes);
+  picture.videoBuffer->GetStrides(stride);
+
+  bool bOk = false;
+  if (converter.Convert(AV_PIX_FMT_YUV420P,
+                        static_cast<AVColorSpace>(picture.color_space),
+                        picture.color_range == 1, planes, stride, picture.iWidth,
+                        picture.iHeight, pOutBuf, nWidth * 4, nWidth, nHeight))
+  {
+    int orientation = DegreeToOrientation(hint.orientation);
+
+    details.width = nWidth;
+    details.height = nHeight;
+    CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
+    bOk = true;
+  }
+  av_free(pOutBuf);
+
+  return bOk;
+}
+} // unnamed namespace
+
 bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
                                 CTextureDetails &details,
                                 CStreamDetails *pStreamDetails,
                                 int64_t pos)
+{
+  std::vector<CTextureDetails> thumbs{details};
+  const bool bOk = ExtractThumbs(fileItem, {pos}, thumbs, pStreamDetails) > 0;
+  details = thumbs.front();
+  return bOk;
+}
+
+int CDVDFileInfo::ExtractThumbs(const CFileItem& fileItem,
+                                const std::vector<int64_t>& positions,
+                                std::vector<CTextureDetails>& details,
+                                CStreamDetails* pStreamDetails,
+                                const std::function<bool(size_t index, bool extracted)>& callback)
 {
   const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
   unsigned int nTime = XbmcThreads::SystemClockMillis();
@@ -100,13 +160,13 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
   if (!pInputStream)
   {
     CLog::Log(LOGERROR, "InputStream: Error creating stream for %s", redactPath.c_str());
-    return false;
+    return 0;
   }
 
   if (!pInputStream->Open())
   {
     CLog::Log(LOGERROR, "InputStream: Error opening, %s", redactPath.c_str());
-    return false;
+    return 0;
   }
 
   CDVDDemux *pDemuxer = NULL;
@@ -117,7 +177,7 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     if(!pDemuxer)
     {
       CLog::Log(LOGERROR, "%s - Error creating demuxer", __FUNCTION__);
-      return false;
+      return 0;
     }
   }
   catch(...)
@@ -126,7 +186,7 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     if (pDemuxer)
       delete pDemuxer;
 
-    return false;
+    return 0;
   }
 
   if (pStreamDetails)
@@ -181,7 +241,8 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     }
   }
 
-  bool bOk = false;
+  int extracted = 0;
+  size_t attempted = 0;
   int packetsTried = 0;
 
   if (nVideoStream != -1)
@@ -200,14 +261,19 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     if (pVideoCodec)
     {
       int nTotalLen = pDemuxer->GetStreamLength();
-      int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
 
-      CLog::Log(LOGDEBUG, "%s - seeking to pos %lldms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
-      if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
-      {
-        CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
-        VideoPicture picture = {};
+      // visit the positions in presentation order
+      std::vector<std::pair<int64_t, size_t>> targets;
+      for (size_t i = 0; i < positions.size(); i++)
+        targets.emplace_back(positions[i] == -1 ? nTotalLen / 3 : positions[i], i);
+      std::stable_sort(targets.begin(), targets.end());
+
+      CYuvToRgbConverter converter;
+      VideoPicture picture = {};
+      bool decoded = false;
 
+      // decodes until a picture at or after minPts, DVD_NOPTS_VALUE takes the first one
+      auto decodePicture = [&](double minPts) {
         // num streams * 160 frames, should get a valid frame, if not abort.
         int abort_index = pDemuxer->GetNrOfStreams() * 160;
         do
@@ -227,62 +293,66 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
           pVideoCodec->AddData(*pPacket);
           CDVDDemuxUtils::FreeDemuxPacket(pPacket);
 
-          iDecoderState = CDVDVideoCodec::VC_NONE;
-          while (iDecoderState == CDVDVideoCodec::VC_NONE)
-          {
-            iDecoderState = pVideoCodec->GetPicture(&picture);
-          }
-
-          if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+          CDVDVideoCodec::VCReturn iDecoderState;
+          while ((iDecoderState = pVideoCodec->GetPicture(&picture)) == CDVDVideoCodec::VC_NONE ||
+                 iDecoderState == CDVDVideoCodec::VC_PICTURE)
           {
-            if(!(picture.iFlags & DVP_FLAG_DROPPED))
-              break;
+            if (iDecoderState == CDVDVideoCodec::VC_PICTURE &&
+                !(picture.iFlags & DVP_FLAG_DROPPED) &&
+                (minPts == DVD_NOPTS_VALUE || picture.pts == DVD_NOPTS_VALUE ||
+                 picture.pts >= minPts))
+              return true;
           }
 
         } while (abort_index--);
 
-        if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
+        return false;
+      };
+
+      for (const auto& target : targets)
+      {
+        const int64_t nSeekTo = target.first;
+        const size_t index = target.second;
+        attempted++;
+
+        bool bOk = false;
+        const int64_t lastPos = decoded && picture.pts != DVD_NOPTS_VALUE ? DVD_TIME_TO_MSEC(picture.pts) : -1;
+        if (lastPos >= 0 && nSeekTo >= lastPos && nSeekTo - lastPos <= FORWARD_DECODE_LIMIT_MS)
+        {
+          CLog::Log(LOGDEBUG, "%s - decoding forward to pos %lldms in %s", __FUNCTION__, nSeekTo, redactPath.c_str());
+          bOk = nSeekTo == lastPos || decodePicture(DVD_MSEC_TO_TIME(nSeekTo));
+        }
+        else
         {
+          CLog::Log(LOGDEBUG, "%s - seeking to pos %lldms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
+          if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
           {
-            unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
-            double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-            if(hint.forced_aspect && hint.aspect != 0)
-              aspect = hint.aspect;
-            unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
-
-            // We pass the buffers to sws_scale uses 16 aligned widths when using intrinsics
-            int sizeNeeded = FFALIGN(nWidth, 16) * nHeight * 4;
-            uint8_t *pOutBuf = static_cast<uint8_t*>(av_malloc(sizeNeeded));
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
-            {
-              uint8_t *planes[YuvImage::MAX_PLANES];
-              int stride[YuvImage::MAX_PLANES];
-              picture.videoBuffer->GetPlanes(planes);
-              picture.videoBuffer->GetStrides(stride);
-              uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
-              int srcStride[] = { stride[0], stride[1], stride[2], 0 };
-              uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
-              int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
-
-              details.width = nWidth;
-              details.height = nHeight;
-              CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
-            }
-            av_free(pOutBuf);
+            if (decoded)
+              pVideoCodec->Reset();
+            bOk = decodePicture(DVD_NOPTS_VALUE);
           }
         }
+        decoded = bOk;
+
+        if (bOk)
+          bOk = CacheThumb(picture, hint, converter, details[index]);
         else
-        {
           CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
+
+        if (bOk)
+          extracted++;
+        else
+        {
+          XFILE::CFile file;
+          if(file.OpenForWrite(CTextureCache::GetCachedPath(details[index].file)))
+            file.Close();
         }
+
+        if (callback && !callback(index, bOk))
+          break;
       }
+
+      picture.Reset();
       delete pVideoCodec;
     }
   }
@@ -290,16 +360,20 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
   if (pDemuxer)
     delete pDemuxer;
 
-  if(!bOk)
+  // mark positions which could not be tried, so they are not retried over and over
+  if (attempted == 0)
   {
-    XFILE::CFile file;
-    if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
-      file.Close();
+    for (const auto& thumb : details)
+    {
+      XFILE::CFile file;
+      if(file.OpenForWrite(CTextureCache::GetCachedPath(thumb.file)))
+        file.Close();
+    }
   }
 
   unsigned int nTotalTime = XbmcThreads::SystemClockMillis() - nTime;
-  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract thumb from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, redactPath.c_str(), packetsTried);
-  return bOk;
+  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract %d of %zu thumbs from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, extracted, positions.size(), redactPath.c_str(), packetsTried);
+  return extracted;
 }
 
 /**
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,6 +29,23 @@ public:
                            CStreamDetails *pStreamDetails,
                            int64_t pos);
 
+  /*!
+   \brief Extract thumbnail images at several positions of the media referenced by fileItem
+
+   The file is opened and the decoder set up only once. Positions are visited in
+   presentation order, positions close behind the previous one are reached by
+   decoding forward instead of seeking.
+   \param positions in ms, -1 picks a frame at a third of the duration
+   \param details one per position with the file set, width and height are filled in
+   \param callback called with the index of each position once it is done, return false to stop
+   \return number of extracted thumbs
+   */
+  static int ExtractThumbs(const CFileItem& fileItem,
+                           const std::vector<int64_t>& positions,
+                           std::vector<CTextureDetails>& details,
+                           CStreamDetails* pStreamDetails,
+                           const std::function<bool(size_t index, bool extracted)>& callback = nullptr);
+
   // Probe the files streams and store the info in the VideoInfoTag
   static bool GetFileStreamDetails(CFileItem *pItem);
   static bool DemuxerToStreamDetails(const std::shared_ptr<CDVDInputStream>& pInputStream,
@@ -13,6 +13,7 @@
 #include "filesystem/IFile.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
@@ -32,7 +33,8 @@ CDVDInputStreamFile::~CDVDInputStreamFile()
 
 bool CDVDInputStreamFile::IsEOF()
 {
-  return !m_pFile || m_eof;
+  CSingleLock lock(m_statusSection);
+  return m_eof;
 }
 
 bool CDVDInputStreamFile::Open()
@@ -93,6 +95,8 @@ bool CDVDInputStreamFile::Open()
   if (m_pFile->GetImplementation() && (content.empty() || content == "application/octet-stream"))
     m_content = m_pFile->GetImplementation()->GetProperty(XFILE::FILE_PROPERTY_CONTENT_TYPE);
 
+  CSingleLock lock(m_statusSection);
+  UpdateStatus();
   m_eof = false;
   return true;
 }
@@ -108,7 +112,11 @@ void CDVDInputStreamFile::Close()
 
   CDVDInputStream::Close();
   m_pFile = NULL;
+
+  CSingleLock lock(m_statusSection);
   m_eof = true;
+  m_length = 0;
+  m_position = 0;
 }
 
 int CDVDInputStreamFile::Read(uint8_t* buf, int buf_size)
@@ -120,6 +128,9 @@ int CDVDInputStreamFile::Read(uint8_t* buf, int buf_size)
   if (ret < 0)
     return -1; // player will retry read in case of error until playback is stopped
 
+  CSingleLock lock(m_statusSection);
+  UpdateStatus();
+
   /* we currently don't support non completing reads */
   if (ret == 0)
     m_eof = true;
@@ -134,23 +145,44 @@ int64_t CDVDInputStreamFile::Seek(int64_t offset, int whence)
   if(whence == SEEK_POSSIBLE)
     return m_pFile->IoControl(IOCTRL_SEEK_POSSIBLE, NULL);
 
+  // the position only changes on reads and seeks, the player asks for it while the
+  // demuxer may be reading on its own thread
+  if (whence == SEEK_CUR && offset == 0)
+  {
+    CSingleLock lock(m_statusSection);
+    return m_position;
+  }
+
   int64_t ret = m_pFile->Seek(offset, whence);
 
+  CSingleLock lock(m_statusSection);
+  UpdateStatus();
+
   /* if we succeed, we are not eof anymore */
-  if( ret >= 0 ) m_eof = false;
+  if (ret >= 0)
+    m_eof = false;
 
   return ret;
 }
 
+void CDVDInputStreamFile::UpdateStatus()
+{
+  m_length = m_pFile->GetLength();
+  m_position = m_pFile->GetPosition();
+  if (m_pFile->GetBitstreamStats())
+    m_stats = *m_pFile->GetBitstreamStats();
+}
+
 int64_t CDVDInputStreamFile::GetLength()
 {
-  if (m_pFile)
-    return m_pFile->GetLength();
-  return 0;
+  CSingleLock lock(m_statusSection);
+  return m_length;
 }
 
 bool CDVDInputStreamFile::GetCacheStatus(XFILE::SCacheStatus *status)
 {
+  // the file cache fills on its own thread and synchronizes the status itself,
+  // a copy taken by the reading thread would go stale while it waits
   if(m_pFile && m_pFile->IoControl(IOCTRL_CACHE_STATUS, status) >= 0)
     return true;
   else
@@ -159,13 +191,8 @@ bool CDVDInputStreamFile::GetCacheStatus(XFILE::SCacheStatus *status)
 
 BitstreamStats CDVDInputStreamFile::GetBitstreamStats() const
 {
-  if (!m_pFile)
-    return m_stats; // dummy return. defined in CDVDInputStream
-
-  if(m_pFile->GetBitstreamStats())
-    return *m_pFile->GetBitstreamStats();
-  else
-    return m_stats;
+  CSingleLock lock(m_statusSection);
+  return m_stats;
 }
 
 int CDVDInputStreamFile::GetBlockSize()
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DVDInputStream.h"
+#include "threads/CriticalSection.h"
 
 class CDVDInputStreamFile : public CDVDInputStream
 {
@@ -27,7 +28,17 @@ public:
   bool GetCacheStatus(XFILE::SCacheStatus *status) override;
 
 protected:
+  // copies the state of the file after a read or seek, m_statusSection must be held. the file
+  // calls are cheap and never do I/O.
+  void UpdateStatus();
+
   XFILE::CFile* m_pFile = nullptr;
-  bool m_eof = false;
   unsigned int m_flags = 0;
+
+  // the demuxer may read on its own thread while the player queries the file. the player
+  // gets the state as of the last read or seek and never waits for a read in progress.
+  mutable CCriticalSection m_statusSection;
+  bool m_eof = false;
+  int64_t m_length = 0;
+  int64_t m_position = 0;
 };
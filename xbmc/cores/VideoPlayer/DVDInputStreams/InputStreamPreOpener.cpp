@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "InputStreamPreOpener.h"
+
+#include "DVDFactoryInputStream.h"
+#include "DVDInputStream.h"
+#include "FileItem.h"
+#include "URL.h"
+#include "filesystem/IFileTypes.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstdio>
+
+CInputStreamPreOpener& CInputStreamPreOpener::GetInstance()
+{
+  static CInputStreamPreOpener preOpener;
+  return preOpener;
+}
+
+size_t CInputStreamPreOpener::Open(const std::vector<CFileItem>& items)
+{
+  unsigned int iGeneration;
+  std::vector<std::pair<std::string, std::shared_ptr<CDVDInputStream>>> oldStreams;
+
+  {
+    CSingleLock lock(m_critSection);
+    iGeneration = ++m_iGeneration;
+    oldStreams.swap(m_streams);
+  }
+
+  // close the old streams before opening new ones, the source may limit the number of connections
+  oldStreams.clear();
+
+  std::vector<std::pair<std::string, std::shared_ptr<CDVDInputStream>>> streams;
+  for (const auto& item : items)
+  {
+    std::shared_ptr<CDVDInputStream> stream =
+        CDVDFactoryInputStream::CreateInputStream(nullptr, item);
+
+    // other input streams do not read ahead or are bound to the player
+    if (!stream || !stream->IsStreamType(DVDSTREAM_TYPE_FILE))
+      continue;
+
+    if (!stream->Open())
+    {
+      CLog::Log(LOGDEBUG, "CInputStreamPreOpener::{} - unable to open [{}]", __FUNCTION__,
+                CURL::GetRedacted(item.GetDynPath()));
+      continue;
+    }
+
+    CLog::Log(LOGDEBUG, "CInputStreamPreOpener::{} - opened [{}]", __FUNCTION__,
+              CURL::GetRedacted(item.GetDynPath()));
+    streams.emplace_back(item.GetDynPath(), stream);
+  }
+
+  CSingleLock lock(m_critSection);
+  if (iGeneration != m_iGeneration)
+    return 0; // replaced or cleared meanwhile, the streams get closed after the lock is released
+
+  m_streams = std::move(streams);
+  return m_streams.size();
+}
+
+std::shared_ptr<CDVDInputStream> CInputStreamPreOpener::Take(const CFileItem& item)
+{
+  std::shared_ptr<CDVDInputStream> stream;
+
+  {
+    CSingleLock lock(m_critSection);
+
+    const auto it = std::find_if(m_streams.begin(), m_streams.end(),
+                                 [&item](const auto& entry) { return entry.first == item.GetDynPath(); });
+    if (it == m_streams.end())
+      return {};
+
+    stream = std::move((*it).second);
+    m_streams.erase(it);
+  }
+
+  // the cache holds all data received since the last drain, playback has to start at the live edge
+  if (!SkipToLiveEdge(*stream, item.GetDynPath()))
+    return {};
+
+  return stream;
+}
+
+void CInputStreamPreOpener::Drain()
+{
+  std::vector<std::pair<std::string, std::shared_ptr<CDVDInputStream>>> outdatedStreams;
+
+  {
+    CSingleLock lock(m_critSection);
+
+    // the lock keeps Take() from handing out a stream while it is skipped
+    for (auto it = m_streams.begin(); it != m_streams.end();)
+    {
+      if (SkipToLiveEdge(*(*it).second, (*it).first))
+      {
+        ++it;
+        continue;
+      }
+
+      outdatedStreams.emplace_back(std::move(*it));
+      it = m_streams.erase(it);
+    }
+  }
+
+  // closing may block, the outdated streams get closed after the lock is released
+}
+
+bool CInputStreamPreOpener::SkipToLiveEdge(CDVDInputStream& stream, const std::string& path)
+{
+  // a full cache stopped reading from the source, its data is outdated
+  XFILE::SCacheStatus status;
+  if (!stream.GetCacheStatus(&status) || status.full)
+  {
+    CLog::Log(LOGDEBUG, "CInputStreamPreOpener::{} - buffered data of [{}] is outdated",
+              __FUNCTION__, CURL::GetRedacted(path));
+    return false;
+  }
+
+  // keep about a second of data, the demuxer can probe the stream without waiting for the source
+  const int64_t skip = std::max<int64_t>(0, static_cast<int64_t>(status.forward) - status.currate);
+  if (skip > 0 && stream.Seek(skip, SEEK_CUR) < 0)
+  {
+    CLog::Log(LOGDEBUG, "CInputStreamPreOpener::{} - unable to skip buffered data of [{}]",
+              __FUNCTION__, CURL::GetRedacted(path));
+    return false;
+  }
+
+  return true;
+}
+
+void CInputStreamPreOpener::Clear()
+{
+  std::vector<std::pair<std::string, std::shared_ptr<CDVDInputStream>>> streams;
+
+  {
+    CSingleLock lock(m_critSection);
+    ++m_iGeneration;
+    streams.swap(m_streams);
+  }
+}
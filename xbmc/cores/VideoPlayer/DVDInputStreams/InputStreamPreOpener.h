@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CDVDInputStream;
+class CFileItem;
+
+/*!
+ * @brief Live input streams opened ahead of playback, e.g. for the channels next to the playing one.
+ *
+ * Only items the player reads through its own file input stream are opened. For those, the file
+ * cache keeps buffering in the background until the player takes the stream or it gets closed.
+ * Drain() has to be called periodically meanwhile, a full cache stops reading from the source.
+ */
+class CInputStreamPreOpener
+{
+public:
+  static CInputStreamPreOpener& GetInstance();
+
+  /*!
+   * @brief Open the input streams of the given items, replacing all streams opened before.
+   * Blocks while the streams are opened.
+   * @param items The items, with their dynamic paths set.
+   * @return The number of opened streams.
+   */
+  size_t Open(const std::vector<CFileItem>& items);
+
+  /*!
+   * @brief Take the opened input stream of an item, positioned close to the live edge.
+   * @param item The item.
+   * @return The stream, nullptr if no stream was opened for the dynamic path of the item or if its
+   * buffered data is outdated. The stream has to be opened again in that case.
+   */
+  std::shared_ptr<CDVDInputStream> Take(const CFileItem& item);
+
+  /*!
+   * @brief Drop the buffered data of all opened input streams, except for the data closest to the
+   * live edge. Closes streams whose buffered data is outdated.
+   */
+  void Drain();
+
+  /*!
+   * @brief Close all opened input streams.
+   */
+  void Clear();
+
+private:
+  CInputStreamPreOpener() = default;
+
+  static bool SkipToLiveEdge(CDVDInputStream& stream, const std::string& path);
+
+  CCriticalSection m_critSection;
+  std::vector<std::pair<std::string, std::shared_ptr<CDVDInputStream>>> m_streams;
+  unsigned int m_iGeneration = 0;
+};
@@ -13,9 +13,11 @@
 #include "cores/IPlayer.h"
 
 #include <atomic>
+#include <memory>
 #include <string.h>
 #include <string>
 
+class CDVDInputStream;
 struct DemuxPacket;
 
 class CDVDMsg : public IDVDResourceCounted<CDVDMsg>
@@ -256,6 +258,7 @@ public:
   {
     CFileItem m_item;
     CPlayerOptions m_options;
+    std::shared_ptr<CDVDInputStream> m_inputStream; // opened ahead of playback, if any
   };
 
   explicit CDVDMsgOpenFile(const FileParams &params)
@@ -265,6 +268,7 @@ public:
 
   CFileItem& GetItem() { return m_params.m_item; }
   CPlayerOptions& GetOptions() { return m_params.m_options; }
+  std::shared_ptr<CDVDInputStream>& GetInputStream() { return m_params.m_inputStream; }
 
 private:
 
@@ -39,7 +39,11 @@ extern "C"
       recoveryPoint = false;
 
       cryptoInfo = nullptr;
+      keyframe = false;
     }
+
+    //! set by demuxers that know the packet starts a keyframe, trick play only skips those
+    bool keyframe;
   };
 
 #ifdef __cplusplus
@@ -65,6 +65,7 @@ void CProcessInfo::ResetVideoCodecInfo()
   m_videoIsHWDecoder = false;
   m_videoDecoderName = "unknown";
   m_videoDeintMethod = "unknown";
+  m_videoDecoderThreads.clear();
   m_videoPixelFormat = "unknown";
   m_videoStereoMode.clear();
   m_videoWidth = 0;
@@ -81,6 +82,7 @@ void CProcessInfo::ResetVideoCodecInfo()
   {
     m_dataCache->SetVideoDecoderName(m_videoDecoderName, m_videoIsHWDecoder);
     m_dataCache->SetVideoDeintMethod(m_videoDeintMethod);
+    m_dataCache->SetVideoDecoderThreads(m_videoDecoderThreads);
     m_dataCache->SetVideoPixelFormat(m_videoPixelFormat);
     m_dataCache->SetVideoDimensions(m_videoWidth, m_videoHeight);
     m_dataCache->SetVideoFps(m_videoFPS);
@@ -132,6 +134,23 @@ std::string CProcessInfo::GetVideoDeintMethod()
   return m_videoDeintMethod;
 }
 
+void CProcessInfo::SetVideoDecoderThreads(const std::string &threads)
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  m_videoDecoderThreads = threads;
+
+  if (m_dataCache)
+    m_dataCache->SetVideoDecoderThreads(m_videoDecoderThreads);
+}
+
+std::string CProcessInfo::GetVideoDecoderThreads()
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  return m_videoDecoderThreads;
+}
+
 void CProcessInfo::SetVideoPixelFormat(const std::string &pixFormat)
 {
   CSingleLock lock(m_videoCodecSection);
@@ -656,6 +675,12 @@ int64_t CProcessInfo::GetMaxTime()
   return m_timeMax;
 }
 
+void CProcessInfo::SetTimeToFirstFrame(int64_t ms)
+{
+  if (m_dataCache)
+    m_dataCache->SetTimeToFirstFrame(ms);
+}
+
 //******************************************************************************
 // settings
 //******************************************************************************
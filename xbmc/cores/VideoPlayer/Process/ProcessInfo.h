@@ -38,6 +38,8 @@ public:
   bool IsVideoHwDecoder();
   void SetVideoDeintMethod(const std::string &method);
   std::string GetVideoDeintMethod();
+  void SetVideoDecoderThreads(const std::string &threads);
+  std::string GetVideoDecoderThreads();
   void SetVideoPixelFormat(const std::string &pixFormat);
   std::string GetVideoPixelFormat();
   void SetVideoStereoMode(const std::string &mode);
@@ -105,6 +107,7 @@ public:
 
   void SetPlayTimes(time_t start, int64_t current, int64_t min, int64_t max);
   int64_t GetMaxTime();
+  void SetTimeToFirstFrame(int64_t ms);
 
   // settings
   CVideoSettings GetVideoSettings();
@@ -120,6 +123,7 @@ protected:
   bool m_videoIsHWDecoder;
   std::string m_videoDecoderName;
   std::string m_videoDeintMethod;
+  std::string m_videoDecoderThreads;
   std::string m_videoPixelFormat;
   std::string m_videoStereoMode;
   int m_videoWidth;
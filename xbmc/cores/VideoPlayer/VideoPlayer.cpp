@@ -17,8 +17,10 @@
 #include "DVDInputStreams/DVDInputStreamBluray.h"
 #endif
 #include "DVDInputStreams/InputStreamPVRBase.h"
+#include "DVDInputStreams/InputStreamPreOpener.h"
 
 #include "DVDDemuxers/DVDDemux.h"
+#include "DVDDemuxers/DemuxKeyframeIndex.h"
 #include "DVDDemuxers/DVDDemuxUtils.h"
 #include "DVDDemuxers/DVDDemuxVobsub.h"
 #include "DVDDemuxers/DVDFactoryDemuxer.h"
@@ -60,6 +62,7 @@
 #include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "video/Bookmark.h"
+#include "video/VideoDatabase.h"
 #include "video/VideoInfoTag.h"
 #include "Util.h"
 #include "LangInfo.h"
@@ -627,6 +630,7 @@ CVideoPlayer::CVideoPlayer(IPlayerCallback& callback)
   m_UpdateStreamDetails = false;
 
   memset(&m_SpeedState, 0, sizeof(m_SpeedState));
+  m_SpeedState.trickplaypts = DVD_NOPTS_VALUE;
 
   m_SkipCommercials = true;
 
@@ -662,12 +666,15 @@ bool CVideoPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options
 {
   CLog::Log(LOGINFO, "VideoPlayer::OpenFile: %s", CURL::GetRedacted(file.GetPath()).c_str());
 
+  m_openRequestTime = XbmcThreads::SystemClockMillis();
+
   if (IsRunning())
   {
     CDVDMsgOpenFile::FileParams params;
     params.m_item = file;
     params.m_options = options;
     params.m_item.SetMimeTypeForInternetFile();
+    params.m_inputStream = CInputStreamPreOpener::GetInstance().Take(params.m_item);
     m_messenger.Put(new CDVDMsgOpenFile(params), 1);
 
     return true;
@@ -677,6 +684,7 @@ bool CVideoPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options
   m_playerOptions = options;
   // Try to resolve the correct mime type
   m_item.SetMimeTypeForInternetFile();
+  m_pPreOpenedInputStream = CInputStreamPreOpener::GetInstance().Take(m_item);
 
   m_processInfo->SetPlayTimes(0,0,0,0);
   m_bAbortRequest = false;
@@ -764,14 +772,21 @@ bool CVideoPlayer::OpenInputStream()
     m_item.SetPath(CServiceBroker::GetMediaManager().TranslateDevicePath(""));
   }
 
-  m_pInputStream = CDVDFactoryInputStream::CreateInputStream(this, m_item, true);
+  // streams of channels next to the playing one may have been opened ahead
+  m_pInputStream = std::move(m_pPreOpenedInputStream);
+  m_inputStreamPreOpened = m_pInputStream != nullptr;
+  if (m_inputStreamPreOpened)
+    CLog::Log(LOGINFO, "CVideoPlayer::OpenInputStream - using pre-opened input stream");
+  else
+    m_pInputStream = CDVDFactoryInputStream::CreateInputStream(this, m_item, true);
+
   if (m_pInputStream == nullptr)
   {
     CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - unable to create input stream for [%s]", CURL::GetRedacted(m_item.GetPath()).c_str());
     return false;
   }
 
-  if (!m_pInputStream->Open())
+  if (!m_inputStreamPreOpened && !m_pInputStream->Open())
   {
     CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - error opening [%s]", CURL::GetRedacted(m_item.GetPath()).c_str());
     return false;
@@ -821,10 +836,21 @@ bool CVideoPlayer::OpenDemuxStream()
 
   CLog::Log(LOGINFO, "Creating Demuxer");
 
+  // library info is a hint for the first demuxer of the file only, don't hold up
+  // the demuxer if the library lookup is slower than opening the input stream
+  std::shared_ptr<SLibraryInfo> libraryInfo = std::move(m_libraryInfo);
+  const CStreamDetails* streamDetails = nullptr;
+  if (libraryInfo && libraryInfo->ready.WaitMSec(100))
+  {
+    if (libraryInfo->details.HasItems())
+      streamDetails = &libraryInfo->details;
+    m_keyframeIndex = libraryInfo->keyframes;
+  }
+
   int attempts = 10;
   while (!m_bStop && attempts-- > 0)
   {
-    m_pDemuxer = CDVDFactoryDemuxer::CreateDemuxer(m_pInputStream);
+    m_pDemuxer = CDVDFactoryDemuxer::CreateDemuxer(m_pInputStream, false, streamDetails);
     if(!m_pDemuxer && m_pInputStream->IsStreamType(DVDSTREAM_TYPE_PVRMANAGER))
     {
       continue;
@@ -843,6 +869,9 @@ bool CVideoPlayer::OpenDemuxStream()
     return false;
   }
 
+  if (m_keyframeIndex)
+    m_pDemuxer->SetKeyframeIndex(m_keyframeIndex);
+
   m_SelectionStreams.Clear(STREAM_NONE, STREAM_SOURCE_DEMUX);
   m_SelectionStreams.Clear(STREAM_NONE, STREAM_SOURCE_NAV);
   m_SelectionStreams.Update(m_pInputStream, m_pDemuxer);
@@ -861,6 +890,86 @@ bool CVideoPlayer::OpenDemuxStream()
   return true;
 }
 
+void CVideoPlayer::StartLibraryLookup()
+{
+  m_libraryInfo.reset();
+  m_keyframeIndex.reset();
+
+  if (m_item.IsInternetStream() || m_item.IsLiveTV())
+    return;
+
+  const bool fastStart =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoFastStart;
+  // only mpeg transport and program streams are indexed by the demuxer
+  const bool lookupKeyframes =
+      URIUtils::HasExtension(m_item.GetPath(), ".ts|.m2ts|.mts|.tp|.trp|.mpg|.mpeg|.vob");
+  if (!fastStart && !lookupKeyframes)
+    return;
+
+  std::shared_ptr<SLibraryInfo> libraryInfo = std::make_shared<SLibraryInfo>();
+  m_libraryInfo = libraryInfo;
+
+  bool lookupStreamDetails = fastStart;
+  if (lookupStreamDetails && m_item.HasVideoInfoTag() &&
+      m_item.GetVideoInfoTag()->HasStreamDetails())
+  {
+    libraryInfo->details = m_item.GetVideoInfoTag()->m_streamDetails;
+    lookupStreamDetails = false;
+  }
+
+  if (!lookupStreamDetails && !lookupKeyframes)
+  {
+    libraryInfo->ready.Set();
+    return;
+  }
+
+  CFileItem item(m_item);
+  CJobManager::GetInstance().Submit([item, libraryInfo, lookupStreamDetails, lookupKeyframes]() mutable {
+    CVideoDatabase db;
+    if (db.Open())
+    {
+      if (lookupStreamDetails && db.GetStreamDetails(item))
+        libraryInfo->details = item.GetVideoInfoTag()->m_streamDetails;
+
+      if (lookupKeyframes)
+      {
+        std::string keyframes;
+        libraryInfo->keyframes = std::make_shared<CDemuxKeyframeIndex>();
+        if (db.GetKeyframeIndex(item.GetPath(), keyframes))
+          libraryInfo->keyframes->Deserialize(keyframes);
+      }
+
+      db.Close();
+    }
+    libraryInfo->ready.Set();
+  }, CJob::PRIORITY_HIGH);
+}
+
+void CVideoPlayer::StoreKeyframeIndex()
+{
+  std::shared_ptr<CDemuxKeyframeIndex> keyframeIndex = std::move(m_keyframeIndex);
+  if (!keyframeIndex)
+    return;
+
+  // the demuxer may still be reading ahead
+  if (m_pDemuxer)
+    m_pDemuxer->SetKeyframeIndex(nullptr);
+
+  if (!keyframeIndex->IsChanged())
+    return;
+
+  const std::string path = m_item.GetPath();
+  const std::string keyframes = keyframeIndex->Serialize();
+  CJobManager::GetInstance().Submit([path, keyframes]() {
+    CVideoDatabase db;
+    if (db.Open())
+    {
+      db.SetKeyframeIndex(path, keyframes);
+      db.Close();
+    }
+  });
+}
+
 void CVideoPlayer::CloseDemuxer()
 {
   delete m_pDemuxer;
@@ -1196,6 +1305,7 @@ void CVideoPlayer::Prepare()
   m_CurrentTeletext.hint.Clear();
   m_CurrentRadioRDS.hint.Clear();
   memset(&m_SpeedState, 0, sizeof(m_SpeedState));
+  m_SpeedState.trickplaypts = DVD_NOPTS_VALUE;
   m_offset_pts = 0;
   m_CurrentAudio.lastdts = DVD_NOPTS_VALUE;
   m_CurrentVideo.lastdts = DVD_NOPTS_VALUE;
@@ -1206,6 +1316,9 @@ void CVideoPlayer::Prepare()
     cb->RequestVideoSettings(fileItem);
   });
 
+  m_openTime = XbmcThreads::SystemClockMillis();
+  StartLibraryLookup();
+
   if (!OpenInputStream())
   {
     m_bAbortRequest = true;
@@ -1666,6 +1779,12 @@ void CVideoPlayer::ProcessVideoData(CDemuxStream* pStream, DemuxPacket* pPacket)
   if (CheckSceneSkip(m_CurrentVideo))
     drop = true;
 
+  if (!drop && CheckTrickPlaySkip(pPacket))
+  {
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+    return;
+  }
+
   m_VideoPlayerVideo->SendMessage(new CDVDMsgDemuxerPacket(pPacket, drop));
   m_CurrentVideo.packets++;
 }
@@ -1998,6 +2117,15 @@ void CVideoPlayer::HandlePlaySpeed()
           CApplicationMessenger::GetInstance().PostMsg(TMSG_SWITCHTOFULLSCREEN);
         }
 
+        const unsigned int timeToFirstFrame = XbmcThreads::SystemClockMillis() - m_openTime;
+        CLog::Log(LOGINFO, "VideoPlayer: time to first frame %u ms", timeToFirstFrame);
+        m_processInfo->SetTimeToFirstFrame(timeToFirstFrame);
+
+        if (m_item.IsLiveTV())
+          CLog::Log(LOGINFO, "VideoPlayer: channel switch took %u ms, input stream %s",
+                    XbmcThreads::SystemClockMillis() - m_openRequestTime,
+                    m_inputStreamPreOpened ? "pre-opened" : "opened on demand");
+
         IPlayerCallback *cb = &m_callback;
         CFileItem fileItem = m_item;
         m_outboundEvents->Submit([=]() {
@@ -2080,7 +2208,29 @@ void CVideoPlayer::HandlePlaySpeed()
           error /= errorwin;
         }
 
-        if (error > DVD_MSEC_TO_TIME(1000))
+        if (IsTrickPlay() && m_playSpeed < 0)
+        {
+          // step back from keyframe to keyframe at the trick play frame rate, the
+          // seek ends up on the keyframe before the clock
+          const double frameTime =
+              static_cast<double>(DVD_TIME_BASE) /
+              CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoTrickPlayFps;
+          if (error > GetTrickPlayStep() &&
+              m_SpeedState.lastabstime - m_SpeedState.lastseekabstime >= frameTime)
+          {
+            m_SpeedState.lastseekpts = m_clock.GetClock();
+            m_SpeedState.lastseekabstime = m_SpeedState.lastabstime;
+            CDVDMsgPlayerSeek::CMode mode;
+            mode.time = (m_clock.GetClock() + m_State.time_offset) / 1000;
+            mode.backward = true;
+            mode.accurate = false;
+            mode.restore = false;
+            mode.trickplay = true;
+            mode.sync = false;
+            m_messenger.Put(new CDVDMsgPlayerSeek(mode));
+          }
+        }
+        else if (error > DVD_MSEC_TO_TIME(1000))
         {
           error  = (m_clock.GetClock() - m_SpeedState.lastseekpts) / 1000;
 
@@ -2115,6 +2265,38 @@ void CVideoPlayer::HandlePlaySpeed()
   }
 }
 
+bool CVideoPlayer::IsTrickPlay() const
+{
+  // the demuxer passes keyframes only at these speeds
+  return CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoTrickPlayFps > 0 &&
+         std::abs(m_playSpeed) > 2 * DVD_PLAYSPEED_NORMAL;
+}
+
+double CVideoPlayer::GetTrickPlayStep() const
+{
+  // media time between two keyframes shown at the trick play frame rate
+  return static_cast<double>(DVD_TIME_BASE) * std::abs(m_playSpeed) / DVD_PLAYSPEED_NORMAL /
+         CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoTrickPlayFps;
+}
+
+bool CVideoPlayer::CheckTrickPlaySkip(const DemuxPacket* pPacket)
+{
+  // packets of demuxers that don't flag keyframes are left to the drop logic
+  if (!IsTrickPlay() || m_playSpeed < 0 || !pPacket->keyframe)
+    return false;
+
+  const double pts = pPacket->pts != DVD_NOPTS_VALUE ? pPacket->pts : pPacket->dts;
+  if (pts == DVD_NOPTS_VALUE)
+    return false;
+
+  // decoding more keyframes than can be shown only costs cpu
+  if (pts >= m_SpeedState.trickplaypts && pts - m_SpeedState.trickplaypts < GetTrickPlayStep())
+    return true;
+
+  m_SpeedState.trickplaypts = pts;
+  return false;
+}
+
 bool CVideoPlayer::CheckPlayerInit(CCurrentStream& current)
 {
   if (current.inited)
@@ -2405,6 +2587,7 @@ void CVideoPlayer::OnExit()
 
   CFileItem fileItem(m_item);
   UpdateFileItemStreamDetails(fileItem);
+  StoreKeyframeIndex();
 
   CloseStream(m_CurrentAudio, !m_bAbortRequest);
   CloseStream(m_CurrentVideo, !m_bAbortRequest);
@@ -2481,6 +2664,7 @@ void CVideoPlayer::HandleMessages()
       IPlayerCallback *cb = &m_callback;
       CFileItem fileItem(m_item);
       UpdateFileItemStreamDetails(fileItem);
+      StoreKeyframeIndex();
       CVideoSettings vs = m_processInfo->GetVideoSettings();
       m_outboundEvents->Submit([=]() {
         cb->StoreVideoSettings(fileItem, vs);
@@ -2502,6 +2686,7 @@ void CVideoPlayer::HandleMessages()
 
       m_item = msg.GetItem();
       m_playerOptions = msg.GetOptions();
+      m_pPreOpenedInputStream = std::move(msg.GetInputStream());
 
       m_processInfo->SetPlayTimes(0,0,0,0);
 
@@ -2858,6 +3043,9 @@ void CVideoPlayer::HandleMessages()
 
       m_processInfo->SetFrameAdvance(false);
 
+      if (speed != m_playSpeed)
+        m_SpeedState.trickplaypts = DVD_NOPTS_VALUE;
+
       m_playSpeed = speed;
 
       m_caching = CACHESTATE_DONE;
@@ -3801,6 +3989,8 @@ void CVideoPlayer::FlushBuffers(double pts, bool accurate, bool sync)
   m_CurrentRadioRDS.startpts = startpts;
   m_CurrentRadioRDS.packets = 0;
 
+  m_SpeedState.trickplaypts = DVD_NOPTS_VALUE;
+
   m_VideoPlayerAudio->Flush(sync);
   m_VideoPlayerVideo->Flush(sync);
   m_VideoPlayerSubtitle->Flush();
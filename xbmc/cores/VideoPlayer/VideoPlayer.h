@@ -21,8 +21,10 @@
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
 #include "guilib/DispResource.h"
+#include "threads/Event.h"
 #include "threads/SystemClock.h"
 #include "threads/Thread.h"
+#include "utils/StreamDetails.h"
 
 #include <atomic>
 #include <memory>
@@ -30,6 +32,8 @@
 #include <utility>
 #include <vector>
 
+class CDemuxKeyframeIndex;
+
 struct SPlayerState
 {
   SPlayerState() { Clear(); }
@@ -413,6 +417,9 @@ protected:
   bool CheckContinuity(CCurrentStream& current, DemuxPacket* pPacket);
   bool CheckSceneSkip(CCurrentStream& current);
   bool CheckPlayerInit(CCurrentStream& current);
+  bool CheckTrickPlaySkip(const DemuxPacket* pPacket);
+  bool IsTrickPlay() const;
+  double GetTrickPlayStep() const;
   void UpdateCorrection(DemuxPacket* pkt, double correction);
   void UpdateTimestamps(CCurrentStream& current, DemuxPacket* pPacket);
   IDVDStreamPlayer* GetStreamPlayer(unsigned int player);
@@ -426,6 +433,8 @@ protected:
 
   bool OpenInputStream();
   bool OpenDemuxStream();
+  void StartLibraryLookup();
+  void StoreKeyframeIndex();
   void CloseDemuxer();
   void OpenDefaultStreams(bool reset = true);
 
@@ -482,6 +491,8 @@ protected:
     int64_t lasttime;
     double lastseekpts;
     double lastabstime;
+    double lastseekabstime;
+    double trickplaypts; // last keyframe passed to the decoder during trick play
   } m_SpeedState;
 
   double m_offset_pts;
@@ -540,5 +551,19 @@ protected:
 
   bool m_UpdateStreamDetails;
 
+  // info about the file from the library, looked up while the input stream is opened
+  struct SLibraryInfo
+  {
+    CEvent ready{true, false};
+    CStreamDetails details;
+    std::shared_ptr<CDemuxKeyframeIndex> keyframes;
+  };
+  std::shared_ptr<SLibraryInfo> m_libraryInfo;
+  std::shared_ptr<CDemuxKeyframeIndex> m_keyframeIndex;
+  unsigned int m_openTime = 0; // time in ticks when we started opening the file
+  std::atomic<unsigned int> m_openRequestTime{0}; // time in ticks when the file was requested
+  std::shared_ptr<CDVDInputStream> m_pPreOpenedInputStream;
+  bool m_inputStreamPreOpened = false;
+
   std::atomic<bool> m_displayLost;
 };
@@ -206,6 +206,14 @@ void CVideoPlayerAudio::UpdatePlayerInfo()
   if (m_synctype == SYNC_RESAMPLE)
     s << ", rr:" << std::fixed << std::setprecision(5) << 1.0 / m_audioSink.GetResampleRatio();
 
+  IAE* ae = CServiceBroker::GetActiveAE();
+  if (ae)
+  {
+    const std::string aeInfo = ae->GetDebugInfo();
+    if (!aeInfo.empty())
+      s << ", " << aeInfo;
+  }
+
   SInfo info;
   info.info        = s.str();
   info.pts         = m_audioSink.GetPlayingPts();
@@ -942,6 +942,15 @@ std::string CVideoPlayerVideo::GetPlayerInfo()
   s << ", drop:" << m_iDroppedFrames;
   s << ", skip:" << m_renderManager.GetSkippedFrames();
 
+  std::string threads = m_processInfo.GetVideoDecoderThreads();
+  if (!threads.empty())
+    s << ", thr:" << threads;
+
+  const CVideoBufferManager::Stats pool = m_processInfo.GetVideoBufferManager().GetStats();
+  if (pool.buffers > 0)
+    s << ", pool:" << pool.used << "/" << pool.buffers << " n:" << pool.createdPools
+      << " r:" << pool.reusedPools;
+
   int pc = m_ptsTracker.GetPatternLength();
   if (pc > 0)
     s << ", pc:" << pc;
@@ -92,6 +92,8 @@ CLinuxRendererGL::CPictureBuffer::CPictureBuffer()
   memset(&fields, 0, sizeof(fields));
   memset(&image , 0, sizeof(image));
   memset(&pbo   , 0, sizeof(pbo));
+  memset(&pboMapped, 0, sizeof(pboMapped));
+  pboFence = nullptr;
   videoBuffer = nullptr;
   loaded = false;
 }
@@ -233,6 +235,10 @@ bool CLinuxRendererGL::Configure(const VideoPicture &picture, float fps, unsigne
   m_pixelRatio = 1.0;
 
   m_pboSupported = CServiceBroker::GetRenderSystem()->IsExtSupported("GL_ARB_pixel_buffer_object");
+#ifdef GL_MAP_PERSISTENT_BIT
+  m_pboPersistent = m_pboSupported &&
+                    CServiceBroker::GetRenderSystem()->IsExtSupported("GL_ARB_buffer_storage");
+#endif
 
   // setup the background colour
   m_clearColour = CServiceBroker::GetWinSystem()->UseLimitedColor() ? (16.0f / 0xff) : 0.0f;
@@ -946,7 +952,8 @@ void CLinuxRendererGL::LoadShaders(int field)
 
   if (m_pboSupported)
   {
-    CLog::Log(LOGINFO, "GL: Using GL_ARB_pixel_buffer_object");
+    CLog::Log(LOGINFO, "GL: Using GL_ARB_pixel_buffer_object{}",
+              m_pboPersistent ? " with persistent mapping" : "");
     m_pboUsed = true;
   }
   else
@@ -1736,6 +1743,12 @@ void CLinuxRendererGL::DeleteTexture(int index)
   CPictureBuffer& buf = m_buffers[index];
   buf.loaded = false;
 
+  if (buf.pboFence)
+  {
+    glDeleteSync(buf.pboFence);
+    buf.pboFence = nullptr;
+  }
+
   if (m_format == AV_PIX_FMT_NV12)
     DeleteNV12Texture(index);
   else if (m_format == AV_PIX_FMT_YUYV422 ||
@@ -1763,6 +1776,11 @@ bool CLinuxRendererGL::UploadTexture(int index)
 
     UnBindPbo(m_buffers[index]);
 
+    //! @todo decode into the pbos instead of copying the frame. the renderer would register a
+    //! pool of its mapped pbos with the video buffer manager and the ffmpeg decoder would
+    //! allocate its frames from it in get_buffer2. the pbos have to outlive the reference frames
+    //! of the decoder then, they can only be freed on the render thread after the pool was
+    //! discarded.
     if (m_format == AV_PIX_FMT_NV12)
     {
       CVideoBuffer::CopyNV12Picture(&dst, &src);
@@ -1783,6 +1801,11 @@ bool CLinuxRendererGL::UploadTexture(int index)
       ret = UploadYV12Texture(index);
     }
 
+    // persistently mapped pbos must not be written again before the texture
+    // uploads that source them have completed
+    if (m_pboPersistent && m_buffers[index].pbo[0])
+      m_buffers[index].pboFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
     if (ret)
       m_buffers[index].loaded = true;
   }
@@ -1854,11 +1877,10 @@ bool CLinuxRendererGL::CreateYV12Texture(int index)
 
     for (int i = 0; i < 3; i++)
     {
-      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[i]);
-      glBufferData(GL_PIXEL_UNPACK_BUFFER, im.planesize[i] + PBO_OFFSET, 0, GL_STREAM_DRAW);
-      void* pboPtr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+      void* pboPtr = AllocatePbo(pbo[i], im.planesize[i]);
       if (pboPtr)
       {
+        buf.pboMapped[i] = static_cast<uint8_t*>(pboPtr);
         im.plane[i] = (uint8_t*) pboPtr + PBO_OFFSET;
         memset(im.plane[i], 0, im.planesize[i]);
       }
@@ -2160,11 +2182,10 @@ bool CLinuxRendererGL::CreateNV12Texture(int index)
 
     for (int i = 0; i < 2; i++)
     {
-      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[i]);
-      glBufferData(GL_PIXEL_UNPACK_BUFFER, im.planesize[i] + PBO_OFFSET, 0, GL_STREAM_DRAW);
-      void* pboPtr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+      void* pboPtr = AllocatePbo(pbo[i], im.planesize[i]);
       if (pboPtr)
       {
+        buf.pboMapped[i] = static_cast<uint8_t*>(pboPtr);
         im.plane[i] = (uint8_t*)pboPtr + PBO_OFFSET;
         memset(im.plane[i], 0, im.planesize[i]);
       }
@@ -2426,11 +2447,10 @@ bool CLinuxRendererGL::CreateYUV422PackedTexture(int index)
     pboSetup = true;
     glGenBuffers(1, pbo);
 
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[0]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, im.planesize[0] + PBO_OFFSET, 0, GL_STREAM_DRAW);
-    void* pboPtr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+    void* pboPtr = AllocatePbo(pbo[0], im.planesize[0]);
     if (pboPtr)
     {
+      buf.pboMapped[0] = static_cast<uint8_t*>(pboPtr);
       im.plane[0] = (uint8_t*)pboPtr + PBO_OFFSET;
       memset(im.plane[0], 0, im.planesize[0]);
     }
@@ -2601,6 +2621,25 @@ bool CLinuxRendererGL::Supports(ESCALINGMETHOD method)
   return false;
 }
 
+void* CLinuxRendererGL::AllocatePbo(GLuint pbo, int size)
+{
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+
+#ifdef GL_MAP_PERSISTENT_BIT
+  if (m_pboPersistent)
+  {
+    // mapped once for the lifetime of the buffer, the copy into it then needs
+    // neither a map/unmap nor a reallocation per frame
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size + PBO_OFFSET, nullptr, flags);
+    return glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size + PBO_OFFSET, flags);
+  }
+#endif
+
+  glBufferData(GL_PIXEL_UNPACK_BUFFER, size + PBO_OFFSET, 0, GL_STREAM_DRAW);
+  return glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+}
+
 void CLinuxRendererGL::BindPbo(CPictureBuffer& buff)
 {
   bool pbo = false;
@@ -2608,6 +2647,12 @@ void CLinuxRendererGL::BindPbo(CPictureBuffer& buff)
   {
     if(!buff.pbo[plane] || buff.image.plane[plane] == (uint8_t*)PBO_OFFSET)
       continue;
+
+    if (m_pboPersistent)
+    {
+      buff.image.plane[plane] = (uint8_t*)PBO_OFFSET;
+      continue;
+    }
     pbo = true;
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buff.pbo[plane]);
@@ -2620,11 +2665,24 @@ void CLinuxRendererGL::BindPbo(CPictureBuffer& buff)
 
 void CLinuxRendererGL::UnBindPbo(CPictureBuffer& buff)
 {
+  if (buff.pboFence)
+  {
+    glClientWaitSync(buff.pboFence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+    glDeleteSync(buff.pboFence);
+    buff.pboFence = nullptr;
+  }
+
   bool pbo = false;
   for(int plane = 0; plane < YuvImage::MAX_PLANES; plane++)
   {
     if(!buff.pbo[plane] || buff.image.plane[plane] != (uint8_t*)PBO_OFFSET)
       continue;
+
+    if (m_pboPersistent)
+    {
+      buff.image.plane[plane] = buff.pboMapped[plane] + PBO_OFFSET;
+      continue;
+    }
     pbo = true;
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buff.pbo[plane]);
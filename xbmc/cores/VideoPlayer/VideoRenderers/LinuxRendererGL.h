@@ -135,6 +135,7 @@ protected:
   struct CYuvPlane;
   struct CPictureBuffer;
 
+  void* AllocatePbo(GLuint pbo, int size);
   void BindPbo(CPictureBuffer& buff);
   void UnBindPbo(CPictureBuffer& buff);
   void LoadPlane(CYuvPlane& plane, int type,
@@ -191,6 +192,8 @@ protected:
     CYuvPlane fields[MAX_FIELDS][YuvImage::MAX_PLANES];
     YuvImage image;
     GLuint pbo[3]; // one pbo for 3 planes
+    uint8_t* pboMapped[3]; // persistent mappings of the pbos
+    GLsync pboFence; // signaled when the gpu is done reading the pbos
 
     CVideoBuffer *videoBuffer;
     bool loaded;
@@ -224,6 +227,7 @@ protected:
   float m_clearColour = 0.0f;
   bool m_pboSupported = true;
   bool m_pboUsed = false;
+  bool m_pboPersistent = false;
   bool m_nonLinStretch = false;
   bool m_nonLinStretchGui = false;
   float m_pixelRatio = 0.0f;
@@ -39,14 +39,7 @@ void CRendererSoftware::GetWeight(std::map<RenderMethod, int>& weights, const Vi
     weights[RENDER_SW] = weight;
 }
 
-CRendererSoftware::~CRendererSoftware()
-{
-  if (m_sw_scale_ctx)
-  {
-    sws_freeContext(m_sw_scale_ctx);
-    m_sw_scale_ctx = nullptr;
-  }
-}
+CRendererSoftware::~CRendererSoftware() = default;
 
 bool CRendererSoftware::Configure(const VideoPicture& picture, float fps, unsigned orientation)
 {
@@ -79,19 +72,6 @@ void CRendererSoftware::RenderImpl(CD3DTexture& target, CRect& sourceRect, CPoin
   CRenderBuffer* buf = m_renderBuffers[m_iBufferIndex];
 
   // 1. convert yuv to rgb
-  m_sw_scale_ctx = sws_getCachedContext(m_sw_scale_ctx,
-    buf->GetWidth(), buf->GetHeight(), buf->av_format,
-    buf->GetWidth(), buf->GetHeight(), AV_PIX_FMT_BGRA,
-    SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
-
-  if (!m_sw_scale_ctx)
-    return;
-
-  sws_setColorspaceDetails(m_sw_scale_ctx,
-    sws_getCoefficients(buf->color_space), buf->full_range,
-    sws_getCoefficients(AVCOL_SPC_BT709),  buf->full_range,
-    0, 1 << 16, 1 << 16);
-
   uint8_t* src[YuvImage::MAX_PLANES];
   int srcStride[YuvImage::MAX_PLANES];
   buf->GetDataPlanes(src, srcStride);
@@ -99,10 +79,13 @@ void CRendererSoftware::RenderImpl(CD3DTexture& target, CRect& sourceRect, CPoin
   D3D11_MAPPED_SUBRESOURCE mapping;
   if (target.LockRect(0, &mapping, D3D11_MAP_WRITE_DISCARD))
   {
-    uint8_t *dst[] = { static_cast<uint8_t*>(mapping.pData), nullptr, nullptr };
-    int dstStride[] = { static_cast<int>(mapping.RowPitch), 0, 0 };
+    const int width = buf->GetWidth();
+    const int height = std::min(target.GetHeight(), buf->GetHeight());
 
-    sws_scale(m_sw_scale_ctx, src, srcStride, 0, std::min(target.GetHeight(), buf->GetHeight()), dst, dstStride);
+    if (!m_converter.Convert(buf->av_format, buf->color_space, buf->full_range, src, srcStride,
+                             width, height, static_cast<uint8_t*>(mapping.pData),
+                             static_cast<int>(mapping.RowPitch), width, height, buf->full_range))
+      CLog::LogF(LOGERROR, "failed to convert picture.");
 
     if (!target.UnlockRect(0))
       CLog::LogF(LOGERROR, "failed to unlock swtarget texture.");
@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include "Buffers/YuvToRgbConverter.h"
 #include "RendererBase.h"
 
 #include <map>
@@ -34,7 +35,7 @@ protected:
   void FinalOutput(CD3DTexture& source, CD3DTexture& target, const CRect& src, const CPoint(&destPoints)[4]) override;
 
 private:
-  SwsContext* m_sw_scale_ctx = nullptr;
+  CYuvToRgbConverter m_converter;
 };
 
 class CRendererSoftware::CRenderBufferImpl : public CRenderBuffer
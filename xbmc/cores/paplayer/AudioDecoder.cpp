@@ -13,11 +13,14 @@
 #include "FileItem.h"
 #include "ServiceBroker.h"
 #include "music/tags/MusicInfoTag.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <math.h>
 
 CAudioDecoder::CAudioDecoder()
@@ -45,7 +48,13 @@ CAudioDecoder::~CAudioDecoder()
 
 void CAudioDecoder::Destroy()
 {
+  // a codec still being opened in the background has to be done before we go on
+  m_abortOpen = true;
+  m_openDone.Wait();
+  m_abortOpen = false;
+
   CSingleLock lock(m_critSection);
+  FinishRecording(false);
   m_status = STATUS_NO_FILE;
 
   m_pcmBuffer.Destroy();
@@ -54,10 +63,22 @@ void CAudioDecoder::Destroy()
     delete m_codec;
   m_codec = NULL;
 
+  delete m_openedCodec;
+  m_openedCodec = nullptr;
+  m_openFailed = false;
+  m_openedData.clear();
+  m_cacheEntry.reset();
+  m_cachePos = 0;
+  m_cacheTotalTime = 0;
+
+  m_format = AEAudioFormat();
+  m_bitsPerSample = 0;
+  m_replayGain = ReplayGain();
+
   m_canPlay = false;
 }
 
-bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
+bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset, bool useCache)
 {
   Destroy();
 
@@ -76,55 +97,76 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
   else if ( file.IsOnLAN() )
     filecache = settings->GetInt(CSettings::SETTING_CACHEAUDIO_LAN);
 
-  // create our codec
-  m_codec=CodecFactory::CreateCodecDemux(file, filecache * 1024);
+  const bool cacheEnabled = CDecodedAudioCache::GetMaxSize() > 0;
+  const bool fromStart = seekOffset == file.m_lStartOffset;
+  m_cacheKey = cacheEnabled ? CDecodedAudioCache::GetKey(file) : "";
+  if (useCache && cacheEnabled && fromStart)
+    m_cacheEntry = CDecodedAudioCache::GetInstance().Get(m_cacheKey);
 
-  if (!m_codec || !m_codec->Init(file, filecache * 1024))
+  if (m_cacheEntry)
   {
-    CLog::Log(LOGERROR, "CAudioDecoder: Unable to Init Codec while loading file %s", file.GetDynPath().c_str());
-    Destroy();
-    return false;
+    // play what we have got and open the codec meanwhile
+    m_format = m_cacheEntry->format;
+    m_bitsPerSample = m_cacheEntry->bitsPerSample;
+    m_replayGain = m_cacheEntry->replayGain;
+    m_cacheTotalTime = m_cacheEntry->totalTime;
+
+    m_openDone.Reset();
+    CJobManager::GetInstance().Submit(
+        [this, file, filecache, entry = m_cacheEntry]() { OpenCodec(file, filecache, entry); },
+        CJob::PRIORITY_HIGH);
+
+    CLog::Log(LOGDEBUG, "CAudioDecoder: Starting %s from %zu cached bytes",
+              file.GetDynPath().c_str(), m_cacheEntry->data.size());
+  }
+  else
+  {
+    // create our codec
+    m_codec=CodecFactory::CreateCodecDemux(file, filecache * 1024);
+
+    if (!m_codec || !m_codec->Init(file, filecache * 1024))
+    {
+      CLog::Log(LOGERROR, "CAudioDecoder: Unable to Init Codec while loading file %s", file.GetDynPath().c_str());
+      Destroy();
+      return false;
+    }
+    m_format = m_codec->m_format;
+    m_bitsPerSample = m_codec->m_bitsPerSample;
   }
-  unsigned int blockSize = (m_codec->m_bitsPerSample >> 3) * m_codec->m_format.m_channelLayout.Count();
+
+  unsigned int blockSize = (m_bitsPerSample >> 3) * m_format.m_channelLayout.Count();
 
   if (blockSize == 0)
   {
     CLog::Log(LOGERROR, "CAudioDecoder: Codec provided invalid parameters (%d-bit, %u channels)",
-              m_codec->m_bitsPerSample, GetFormat().m_channelLayout.Count());
+              m_bitsPerSample, GetFormat().m_channelLayout.Count());
     return false;
   }
 
-  /* allocate the pcmBuffer for 2 seconds of audio */
-  m_pcmBuffer.Create(2 * blockSize * m_codec->m_format.m_sampleRate);
+  /* allocate the pcmBuffer, it holds what is decoded ahead of playback */
+  const int bufferSeconds = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioPreDecodeBuffer;
+  m_pcmBuffer.Create(bufferSeconds * blockSize * m_format.m_sampleRate);
 
-  if (file.HasMusicInfoTag())
+  if (m_codec)
   {
-    // set total time from the given tag
-    if (file.GetMusicInfoTag()->GetDuration())
-      m_codec->SetTotalTime(file.GetMusicInfoTag()->GetDuration());
-
-    // update ReplayGain from the given tag if it's better then original (cuesheet)
-    ReplayGain rgInfo = m_codec->m_tag.GetReplayGain();
-    bool anySet = false;
-    if (!rgInfo.Get(ReplayGain::ALBUM).Valid()
-      && file.GetMusicInfoTag()->GetReplayGain().Get(ReplayGain::ALBUM).Valid())
-    {
-      rgInfo.Set(ReplayGain::ALBUM, file.GetMusicInfoTag()->GetReplayGain().Get(ReplayGain::ALBUM));
-      anySet = true;
-    }
-    if (!rgInfo.Get(ReplayGain::TRACK).Valid()
-      && file.GetMusicInfoTag()->GetReplayGain().Get(ReplayGain::TRACK).Valid())
+    ApplyFileTag(m_codec, file);
+    m_replayGain = m_codec->m_tag.GetReplayGain();
+
+    if (seekOffset)
+      m_codec->Seek(seekOffset);
+
+    // record the start of the track, so it can be played again without delay
+    if (cacheEnabled && fromStart && m_format.m_dataFormat != AE_FMT_RAW)
     {
-      rgInfo.Set(ReplayGain::TRACK, file.GetMusicInfoTag()->GetReplayGain().Get(ReplayGain::TRACK));
-      anySet = true;
+      m_record = std::make_shared<CDecodedAudioCache::Entry>();
+      m_record->format = m_format;
+      m_record->bitsPerSample = m_bitsPerSample;
+      m_record->totalTime = m_codec->m_TotalTime;
+      m_record->replayGain = m_replayGain;
+      m_recordLimit = CDecodedAudioCache::GetMaxEntrySize(m_format, m_bitsPerSample);
     }
-    if (anySet)
-      m_codec->m_tag.SetReplayGain(rgInfo);
   }
 
-  if (seekOffset)
-    m_codec->Seek(seekOffset);
-
   m_status = STATUS_QUEUING;
 
   m_rawBufferSize = 0;
@@ -132,16 +174,208 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
   return true;
 }
 
-AEAudioFormat CAudioDecoder::GetFormat()
+void CAudioDecoder::ApplyFileTag(ICodec* codec, const CFileItem& file)
+{
+  if (!file.HasMusicInfoTag())
+    return;
+
+  // set total time from the given tag
+  if (file.GetMusicInfoTag()->GetDuration())
+    codec->SetTotalTime(file.GetMusicInfoTag()->GetDuration());
+
+  // update ReplayGain from the given tag if it's better then original (cuesheet)
+  ReplayGain rgInfo = codec->m_tag.GetReplayGain();
+  bool anySet = false;
+  if (!rgInfo.Get(ReplayGain::ALBUM).Valid()
+    && file.GetMusicInfoTag()->GetReplayGain().Get(ReplayGain::ALBUM).Valid())
+  {
+    rgInfo.Set(ReplayGain::ALBUM, file.GetMusicInfoTag()->GetReplayGain().Get(ReplayGain::ALBUM));
+    anySet = true;
+  }
+  if (!rgInfo.Get(ReplayGain::TRACK).Valid()
+    && file.GetMusicInfoTag()->GetReplayGain().Get(ReplayGain::TRACK).Valid())
+  {
+    rgInfo.Set(ReplayGain::TRACK, file.GetMusicInfoTag()->GetReplayGain().Get(ReplayGain::TRACK));
+    anySet = true;
+  }
+  if (anySet)
+    codec->m_tag.SetReplayGain(rgInfo);
+}
+
+void CAudioDecoder::OpenCodec(const CFileItem& file,
+                              unsigned int filecache,
+                              const std::shared_ptr<const CDecodedAudioCache::Entry>& entry)
+{
+  ICodec* codec = CodecFactory::CreateCodecDemux(file, filecache * 1024);
+  bool success = codec && codec->Init(file, filecache * 1024);
+  std::vector<uint8_t> data;
+
+  // the codec continues the cached audio, it can't switch formats in between
+  if (success && (codec->m_format.m_dataFormat != entry->format.m_dataFormat ||
+                  codec->m_format.m_sampleRate != entry->format.m_sampleRate ||
+                  codec->m_format.m_channelLayout != entry->format.m_channelLayout ||
+                  codec->m_bitsPerSample != entry->bitsPerSample))
+  {
+    CLog::Log(LOGWARNING, "CAudioDecoder: Cached audio of %s doesn't match the codec output, discarding it",
+              file.GetDynPath().c_str());
+    CDecodedAudioCache::GetInstance().Remove(m_cacheKey);
+    success = false;
+  }
+
+  if (success)
+  {
+    size_t skipBytes = entry->complete ? 0 : entry->data.size();
+
+    ApplyFileTag(codec, file);
+    if (file.m_lStartOffset)
+      codec->Seek(file.m_lStartOffset);
+
+    // decode up to where the cached audio ends, seeking wouldn't be sample accurate
+    const unsigned int frameSize = (codec->m_bitsPerSample >> 3) * codec->m_format.m_channelLayout.Count();
+    std::vector<uint8_t> buffer(frameSize ? INPUT_SIZE / frameSize * frameSize : 0);
+    while (skipBytes > 0 && success && !m_abortOpen)
+    {
+      int readSize = 0;
+      const int result = codec->ReadPCM(buffer.data(), buffer.size(), &readSize);
+      if (result == READ_ERROR || (result == READ_EOF && !readSize))
+        success = false;
+
+      const size_t skipped = std::min(skipBytes, static_cast<size_t>(readSize));
+      skipBytes -= skipped;
+      data.assign(buffer.begin() + skipped, buffer.begin() + readSize);
+    }
+  }
+
+  if (!success)
+  {
+    CLog::Log(LOGERROR, "CAudioDecoder: Unable to open codec in the background for %s",
+              file.GetDynPath().c_str());
+    delete codec;
+    codec = nullptr;
+  }
+
+  CSingleLock lock(m_critSection);
+  m_openedCodec = codec;
+  m_openFailed = !success;
+  m_openedData = std::move(data);
+  m_openDone.Set();
+}
+
+bool CAudioDecoder::AdoptCodec(bool wait)
+{
+  if (m_codec)
+    return true;
+
+  if (!m_cacheEntry)
+    return false;
+
+  if (wait)
+    m_openDone.Wait();
+  else if (!m_openDone.Signaled())
+    return false;
+
+  CSingleLock lock(m_critSection);
+  m_codec = m_openedCodec;
+  m_openedCodec = nullptr;
+  return m_codec != nullptr;
+}
+
+int CAudioDecoder::ReadCached()
 {
-  AEAudioFormat format;
+  AdoptCodec(false);
+
+  const std::vector<uint8_t>& cached = m_cacheEntry->data;
+  if (m_cachePos < cached.size())
+  {
+    const size_t size = std::min<size_t>(
+        {cached.size() - m_cachePos, m_pcmBuffer.getMaxWriteSize(), INPUT_SIZE});
+    if (!size)
+      return RET_SLEEP;
+
+    m_pcmBuffer.WriteData(reinterpret_cast<const char*>(cached.data() + m_cachePos), size);
+    m_cachePos += size;
+
+    if (m_status == STATUS_QUEUING &&
+        (m_pcmBuffer.getMaxReadSize() > m_pcmBuffer.getSize() * 0.9 || m_cachePos == cached.size()))
+      m_status = STATUS_QUEUED;
+
+    return RET_SUCCESS;
+  }
+
+  if (m_cacheEntry->complete)
+  {
+    m_eof = true;
+    if (m_status < STATUS_ENDING)
+      m_status = STATUS_ENDING;
+    return RET_SUCCESS;
+  }
+
   if (!m_codec)
-    return format;
-  return m_codec->m_format;
+  {
+    if (m_openFailed)
+      return RET_ERROR;
+
+    // the codec is too slow to open, nothing we can do about it
+    return RET_SLEEP;
+  }
+
+  // hand over what was decoded past the cached audio
+  if (!m_openedData.empty())
+  {
+    const size_t size = std::min<size_t>(m_openedData.size(), m_pcmBuffer.getMaxWriteSize());
+    if (!size)
+      return RET_SLEEP;
+
+    m_pcmBuffer.WriteData(reinterpret_cast<const char*>(m_openedData.data()), size);
+    m_openedData.erase(m_openedData.begin(), m_openedData.begin() + size);
+    return RET_SUCCESS;
+  }
+
+  // from now on the codec takes over
+  m_cacheEntry.reset();
+  return RET_SUCCESS;
+}
+
+void CAudioDecoder::Record(const uint8_t* data, int size)
+{
+  if (!m_record)
+    return;
+
+  const size_t count = std::min<size_t>(size, m_recordLimit - m_record->data.size());
+  m_record->data.insert(m_record->data.end(), data, data + count);
+
+  if (m_record->data.size() >= m_recordLimit)
+    FinishRecording(false);
+}
+
+void CAudioDecoder::FinishRecording(bool complete)
+{
+  if (!m_record)
+    return;
+
+  m_record->complete = complete;
+  if (!m_record->data.empty())
+    CDecodedAudioCache::GetInstance().Add(m_cacheKey, std::move(m_record));
+  m_record.reset();
+}
+
+AEAudioFormat CAudioDecoder::GetFormat()
+{
+  return m_format;
 }
 
 int64_t CAudioDecoder::Seek(int64_t time)
 {
+  // the recorded audio is no longer continuous
+  FinishRecording(false);
+
+  if (m_cacheEntry)
+  {
+    AdoptCodec(true);
+    m_cacheEntry.reset();
+    m_openedData.clear();
+  }
+
   m_pcmBuffer.Clear();
   m_rawBufferSize = 0;
   if (!m_codec)
@@ -155,13 +389,14 @@ void CAudioDecoder::SetTotalTime(int64_t time)
 {
   if (m_codec)
     m_codec->m_TotalTime = time;
+  m_cacheTotalTime = time;
 }
 
 int64_t CAudioDecoder::TotalTime()
 {
   if (m_codec)
     return m_codec->m_TotalTime;
-  return 0;
+  return m_cacheTotalTime;
 }
 
 unsigned int CAudioDecoder::GetDataSize(bool checkPktSize)
@@ -169,7 +404,7 @@ unsigned int CAudioDecoder::GetDataSize(bool checkPktSize)
   if (m_status == STATUS_QUEUING || m_status == STATUS_NO_FILE)
     return 0;
 
-  if (m_codec->m_format.m_dataFormat != AE_FMT_RAW)
+  if (m_format.m_dataFormat != AE_FMT_RAW)
   {
     // check for end of file and end of buffer
     if (m_status == STATUS_ENDING)
@@ -179,7 +414,7 @@ unsigned int CAudioDecoder::GetDataSize(bool checkPktSize)
       else if (checkPktSize && m_pcmBuffer.getMaxReadSize() < PACKET_SIZE)
         m_status = STATUS_ENDED;
     }
-    return std::min(m_pcmBuffer.getMaxReadSize() / (m_codec->m_bitsPerSample >> 3), (unsigned int)OUTPUT_SAMPLES);
+    return std::min(m_pcmBuffer.getMaxReadSize() / (m_bitsPerSample >> 3), (unsigned int)OUTPUT_SAMPLES);
   }
   else
   {
@@ -191,7 +426,7 @@ unsigned int CAudioDecoder::GetDataSize(bool checkPktSize)
 
 void *CAudioDecoder::GetData(unsigned int samples)
 {
-  unsigned int size  = samples * (m_codec->m_bitsPerSample >> 3);
+  unsigned int size  = samples * (m_bitsPerSample >> 3);
   if (size > sizeof(m_outputBuffer))
   {
     CLog::Log(LOGERROR, "CAudioDecoder::GetData - More data was requested then we have space to buffer!");
@@ -242,21 +477,28 @@ int CAudioDecoder::ReadSamples(int numsamples)
   // grab a lock to ensure the codec is created at this point.
   CSingleLock lock(m_critSection);
 
-  if (m_codec->m_format.m_dataFormat != AE_FMT_RAW)
+  if (m_cacheEntry)
+    return ReadCached();
+
+  if (!m_codec)
+    return RET_ERROR;
+
+  if (m_format.m_dataFormat != AE_FMT_RAW)
   {
     // Read in more data
-    int maxsize = std::min<int>(INPUT_SAMPLES, m_pcmBuffer.getMaxWriteSize() / (m_codec->m_bitsPerSample >> 3));
+    int maxsize = std::min<int>(INPUT_SAMPLES, m_pcmBuffer.getMaxWriteSize() / (m_bitsPerSample >> 3));
     numsamples = std::min<int>(numsamples, maxsize);
     numsamples -= (numsamples % GetFormat().m_channelLayout.Count());  // make sure it's divisible by our number of channels
     if (numsamples)
     {
       int readSize = 0;
-      int result = m_codec->ReadPCM(m_pcmInputBuffer, numsamples * (m_codec->m_bitsPerSample >> 3), &readSize);
+      int result = m_codec->ReadPCM(m_pcmInputBuffer, numsamples * (m_bitsPerSample >> 3), &readSize);
 
       if (result != READ_ERROR && readSize)
       {
         // move it into our buffer
         m_pcmBuffer.WriteData((char *)m_pcmInputBuffer, readSize);
+        Record(m_pcmInputBuffer, readSize);
 
         // update status
         if (m_status == STATUS_QUEUING && m_pcmBuffer.getMaxReadSize() > m_pcmBuffer.getSize() * 0.9)
@@ -267,6 +509,7 @@ int CAudioDecoder::ReadSamples(int numsamples)
 
         if (result == READ_EOF) // EOF reached
         {
+          FinishRecording(true);
           // setup ending if we're within set time of the end (currently just EOF)
           m_eof = true;
           if (m_status < STATUS_ENDING)
@@ -283,6 +526,7 @@ int CAudioDecoder::ReadSamples(int numsamples)
       }
       if (result == READ_EOF)
       {
+        FinishRecording(true);
         m_eof = true;
         // setup ending if we're within set time of the end (currently just EOF)
         if (m_status < STATUS_ENDING)
@@ -332,7 +576,7 @@ float CAudioDecoder::GetReplayGain(float &peakVal)
   // Compute amount of gain
   float replaydB = (float)replayGainSettings.iNoGainPreAmp;
   float peak = 1.0f;
-  const ReplayGain& rgInfo = m_codec->m_tag.GetReplayGain();
+  const ReplayGain& rgInfo = m_replayGain;
   if (replayGainSettings.iType == ReplayGain::ALBUM)
   {
     if (rgInfo.Get(ReplayGain::ALBUM).HasGain())
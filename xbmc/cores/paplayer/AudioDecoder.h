@@ -8,11 +8,18 @@
 
 #pragma once
 
+#include "DecodedAudioCache.h"
 #include "ICodec.h"
 #include "cores/AudioEngine/Utils/AEChannelInfo.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
 #include "utils/RingBuffer.h"
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
 class CFileItem;
 
 #define PACKET_SIZE 3840    // audio packet size - we keep 1 in reserve for gapless playback
@@ -43,7 +50,12 @@ public:
   CAudioDecoder();
   ~CAudioDecoder();
 
-  bool Create(const CFileItem &file, int64_t seekOffset);
+  /*!
+   \brief Opens the codec and gets ready to decode
+   \param useCache start from the decoded audio cache if the track is in there, the codec
+   is then opened in the background
+   */
+  bool Create(const CFileItem &file, int64_t seekOffset, bool useCache = false);
   void Destroy();
 
   int ReadSamples(int numsamples);
@@ -66,6 +78,15 @@ public:
   float GetReplayGain(float &peakVal);
 
 private:
+  static void ApplyFileTag(ICodec* codec, const CFileItem& file);
+  void OpenCodec(const CFileItem& file,
+                 unsigned int filecache,
+                 const std::shared_ptr<const CDecodedAudioCache::Entry>& entry);
+  bool AdoptCodec(bool wait);
+  int ReadCached();
+  void Record(const uint8_t* data, int size);
+  void FinishRecording(bool complete);
+
   // pcm buffer
   CRingBuffer m_pcmBuffer;
 
@@ -86,6 +107,24 @@ private:
 
   // the codec we're using
   ICodec* m_codec;
+  AEAudioFormat m_format;
+  int m_bitsPerSample = 0;
+  ReplayGain m_replayGain;
+
+  // playback from the decoded audio cache while the codec is opened in the background
+  std::shared_ptr<const CDecodedAudioCache::Entry> m_cacheEntry;
+  size_t m_cachePos = 0;
+  int64_t m_cacheTotalTime = 0;
+  CEvent m_openDone{true, true};
+  std::atomic_bool m_abortOpen{false};
+  ICodec* m_openedCodec = nullptr;
+  bool m_openFailed = false;
+  std::vector<uint8_t> m_openedData; // decoded past the end of the cached audio
+
+  // recording of the start of the track into the cache
+  std::string m_cacheKey;
+  std::shared_ptr<CDecodedAudioCache::Entry> m_record;
+  size_t m_recordLimit = 0;
 
   CCriticalSection m_critSection;
 };
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DecodedAudioCache.h"
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+CDecodedAudioCache& CDecodedAudioCache::GetInstance()
+{
+  static CDecodedAudioCache cache;
+  return cache;
+}
+
+size_t CDecodedAudioCache::GetMaxSize()
+{
+  const auto settingsComponent = CServiceBroker::GetSettingsComponent();
+  if (!settingsComponent)
+    return 0;
+
+  const auto advancedSettings = settingsComponent->GetAdvancedSettings();
+  if (!advancedSettings)
+    return 0;
+
+  return static_cast<size_t>(advancedSettings->m_audioDecodedCacheSize) * 1024 * 1024;
+}
+
+size_t CDecodedAudioCache::GetMaxEntrySize(const AEAudioFormat& format, int bitsPerSample)
+{
+  const int seconds =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioDecodedCacheTime;
+  const size_t size = static_cast<size_t>(seconds) * format.m_sampleRate *
+                     format.m_channelLayout.Count() * (bitsPerSample >> 3);
+
+  // a larger entry would be rejected anyway, don't keep decoding into it
+  return std::min(size, GetMaxSize());
+}
+
+std::string CDecodedAudioCache::GetKey(const CFileItem& file)
+{
+  return StringUtils::Format("{}|{}", file.GetDynPath(), file.m_lStartOffset);
+}
+
+std::shared_ptr<const CDecodedAudioCache::Entry> CDecodedAudioCache::Get(const std::string& key)
+{
+  CSingleLock lock(m_lock);
+  for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+  {
+    if (it->first == key)
+    {
+      m_entries.splice(m_entries.begin(), m_entries, it);
+      return it->second;
+    }
+  }
+  return nullptr;
+}
+
+void CDecodedAudioCache::Add(const std::string& key, std::shared_ptr<const Entry> entry)
+{
+  const size_t maxSize = GetMaxSize();
+  if (!entry || entry->data.size() > maxSize)
+    return;
+
+  CSingleLock lock(m_lock);
+  Remove(key);
+
+  m_size += entry->data.size();
+  m_entries.emplace_front(key, std::move(entry));
+  Trim(maxSize);
+
+  CLog::Log(LOGDEBUG, "CDecodedAudioCache::{} - {} tracks cached, {} kB", __FUNCTION__,
+            m_entries.size(), m_size / 1024);
+}
+
+void CDecodedAudioCache::Remove(const std::string& key)
+{
+  CSingleLock lock(m_lock);
+  for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+  {
+    if (it->first == key)
+    {
+      m_size -= it->second->data.size();
+      m_entries.erase(it);
+      return;
+    }
+  }
+}
+
+void CDecodedAudioCache::Clear()
+{
+  CSingleLock lock(m_lock);
+  m_entries.clear();
+  m_size = 0;
+}
+
+void CDecodedAudioCache::Trim(size_t maxSize)
+{
+  while (m_size > maxSize && !m_entries.empty())
+  {
+    m_size -= m_entries.back().second->data.size();
+    m_entries.pop_back();
+  }
+}
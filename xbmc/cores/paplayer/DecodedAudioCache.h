@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Utils/AEAudioFormat.h"
+#include "music/tags/ReplayGain.h"
+#include "threads/CriticalSection.h"
+
+#include <list>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CFileItem;
+
+/*!
+ \brief Keeps the decoded start of recently played tracks in memory
+
+ CAudioDecoder records the first seconds of every track it decodes from the
+ beginning. When the same track is played again, playback starts from the
+ recorded audio right away while the codec is opened in the background, which
+ makes skipping back on slow network shares instant.
+ */
+class CDecodedAudioCache
+{
+public:
+  struct Entry
+  {
+    AEAudioFormat format;
+    int bitsPerSample = 0;
+    int64_t totalTime = 0;
+    ReplayGain replayGain;
+    std::vector<uint8_t> data; // pcm from the start of the track
+    bool complete = false; // data holds the whole track
+  };
+
+  static CDecodedAudioCache& GetInstance();
+
+  /*!
+   \brief Max size of the cache in bytes, 0 if it is disabled
+   */
+  static size_t GetMaxSize();
+
+  /*!
+   \brief Number of bytes to record from the start of a track, at most the size of the cache
+   */
+  static size_t GetMaxEntrySize(const AEAudioFormat& format, int bitsPerSample);
+
+  static std::string GetKey(const CFileItem& file);
+
+  std::shared_ptr<const Entry> Get(const std::string& key);
+  void Add(const std::string& key, std::shared_ptr<const Entry> entry);
+  void Remove(const std::string& key);
+  void Clear();
+
+private:
+  CDecodedAudioCache() = default;
+
+  void Trim(size_t maxSize);
+
+  CCriticalSection m_lock;
+  // most recently used first
+  std::list<std::pair<std::string, std::shared_ptr<const Entry>>> m_entries;
+  size_t m_size = 0;
+};
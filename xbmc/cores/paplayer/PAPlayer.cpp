@@ -28,7 +28,6 @@
 
 using namespace KODI::MESSAGING;
 
-#define TIME_TO_CACHE_NEXT_FILE 5000 /* 5 seconds before end of song, start caching the next song */
 #define FAST_XFADE_TIME           80 /* 80 milliseconds */
 #define MAX_SKIP_XFADE_TIME     2000 /* max 2 seconds crossfade on track skip */
 
@@ -327,7 +326,8 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
 
   StreamInfo *si = new StreamInfo();
   si->m_fileItem = file;
-  if (!si->m_decoder.Create(file, si->m_fileItem.m_lStartOffset))
+  const bool hasBookmark = si->m_fileItem.HasProperty("audiobook_bookmark");
+  if (!si->m_decoder.Create(file, si->m_fileItem.m_lStartOffset, !hasBookmark))
   {
     CLog::Log(LOGWARNING, "PAPlayer::QueueNextFileEx - Failed to create the decoder");
 
@@ -339,6 +339,16 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
     return false;
   }
 
+  /* seek to the bookmark now, so we decode ahead from the right position */
+  si->m_framesSent = 0;
+  if (hasBookmark)
+  {
+    const AEAudioFormat format = si->m_decoder.GetFormat();
+    const int seekFrame = format.m_sampleRate * CUtil::ConvertMilliSecsToSecs(si->m_fileItem.GetProperty("audiobook_bookmark").asInteger());
+    si->m_framesSent = (int)(seekFrame - ((float)file.m_lStartOffset * (float)format.m_sampleRate) / 1000.0f);
+    si->m_decoder.Seek((int64_t)((float)seekFrame / (float)format.m_sampleRate * 1000.0f));
+  }
+
   /* decode until there is data-available */
   si->m_decoder.Start();
   while (si->m_decoder.GetDataSize(true) == 0)
@@ -373,12 +383,9 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   si->m_bytesPerFrame = si->m_bytesPerSample * si->m_audioFormat.m_channelLayout.Count();
   si->m_started = false;
   si->m_finishing = false;
-  si->m_framesSent = 0;
   si->m_seekNextAtFrame = 0;
-  if (si->m_fileItem.HasProperty("audiobook_bookmark"))
-    si->m_seekFrame = si->m_audioFormat.m_sampleRate * CUtil::ConvertMilliSecsToSecs(si->m_fileItem.GetProperty("audiobook_bookmark").asInteger());
-  else
-    si->m_seekFrame = -1;
+  si->m_seekFrame = -1;
+  si->m_codecPending = !si->m_decoder.GetCodec();
   si->m_stream = NULL;
   si->m_volume = (fadeIn && m_upcomingCrossfadeMS) ? 0.0f : 1.0f;
   si->m_fadeOutTriggered = false;
@@ -392,10 +399,7 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   si->m_prepareNextAtFrame = 0;
   // cd drives don't really like it to be crossfaded or prepared
   if(!file.IsCDDA())
-  {
-    if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
-      si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
-  }
+    UpdateStreamInfoPrepareNextAtFrame(si, streamTotalTime);
 
   if (m_currentStream && ((m_currentStream->m_audioFormat.m_dataFormat == AE_FMT_RAW) || (si->m_audioFormat.m_dataFormat == AE_FMT_RAW)))
   {
@@ -433,6 +437,14 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   return true;
 }
 
+void PAPlayer::UpdateStreamInfoPrepareNextAtFrame(StreamInfo *si, int64_t streamTotalTime)
+{
+  // open and decode the next item early enough to hide the latency of slow sources
+  const int64_t preDecodeTime = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioPreDecodeTime * 1000;
+  if (streamTotalTime >= preDecodeTime + m_defaultCrossfadeMS)
+    si->m_prepareNextAtFrame = (int)((streamTotalTime - preDecodeTime - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
+}
+
 void PAPlayer::UpdateStreamInfoPlayNextAtFrame(StreamInfo *si, unsigned int crossFadingTime)
 {
   // if no crossfading or cue sheet, wait for eof
@@ -731,10 +743,21 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
     m_callback.OnAVStarted(si->m_fileItem);
   }
 
-  /* if we have not started yet and the stream has been primed */
+  /* the codec was opened in the background while playing from the decoded audio cache */
+  if (si->m_codecPending && si->m_decoder.GetCodec())
+  {
+    si->m_codecPending = false;
+    if (si == m_currentStream)
+      UpdateGUIData(si);
+  }
+
+  /* if we have not started yet and the stream has been primed, keep filling the decoder buffer */
   unsigned int space = si->m_stream->GetSpace();
   if (!si->m_started && !space)
+  {
+    si->m_decoder.ReadSamples(PACKET_SIZE);
     return true;
+  }
 
   /* see if it is time yet to FF/RW or a direct seek */
   if (!si->m_playNextTriggered && ((m_playbackSpeed != 1 && si->m_framesSent >= si->m_seekNextAtFrame) || si->m_seekFrame > -1))
@@ -797,8 +820,7 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
 
       // calculate time when to prepare next stream
       si->m_prepareNextAtFrame = 0;
-      if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
-        si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
+      UpdateStreamInfoPrepareNextAtFrame(si, streamTotalTime);
 
       si->m_prepareTriggered = false;
       si->m_playNextAtFrame = 0;
@@ -109,6 +109,7 @@ private:
 
     bool m_isSlaved;                     /* true if the stream has been slaved to another */
     bool m_waitOnDrain;                  /* wait for stream being drained in AE */
+    bool m_codecPending;                 /* decoder plays from the cache until its codec is open */
   };
 
   typedef std::list<StreamInfo*> StreamList;
@@ -145,6 +146,7 @@ private:
   bool QueueData(StreamInfo *si);
   int64_t GetTotalTime64();
   void UpdateCrossfadeTime(const CFileItem& file);
+  void UpdateStreamInfoPrepareNextAtFrame(StreamInfo *si, int64_t streamTotalTime);
   void UpdateStreamInfoPlayNextAtFrame(StreamInfo *si, unsigned int crossFadingTime);
   void UpdateGUIData(StreamInfo *si);
   int64_t GetTimeInternal();
@@ -436,10 +436,13 @@ bool CDatabase::QueueInsertQuery(const std::string &strQuery)
   return true;
 }
 
-bool CDatabase::CommitInsertQueries()
+bool CDatabase::CommitInsertQueries(int64_t* changedRows /* = nullptr */)
 {
   bool bReturn = true;
 
+  if (changedRows)
+    *changedRows = 0;
+
   if (m_bMultiInsert)
   {
     try
@@ -447,6 +450,8 @@ bool CDatabase::CommitInsertQueries()
       m_bMultiInsert = false;
       m_pDS2->post();
       m_pDS2->clear_insert_sql();
+      if (changedRows)
+        *changedRows = m_pDS2->changedrows();
     }
     catch(...)
     {
@@ -475,10 +480,13 @@ bool CDatabase::QueueDeleteQuery(const std::string& strQuery)
   return true;
 }
 
-bool CDatabase::CommitDeleteQueries()
+bool CDatabase::CommitDeleteQueries(int64_t* changedRows /* = nullptr */)
 {
   bool bReturn = true;
 
+  if (changedRows)
+    *changedRows = 0;
+
   if (m_bMultiDelete)
   {
     try
@@ -486,6 +494,8 @@ bool CDatabase::CommitDeleteQueries()
       m_bMultiDelete = false;
       m_pDS->deletion();
       m_pDS->clear_delete_sql();
+      if (changedRows)
+        *changedRows = m_pDS->changedrows();
     }
     catch (...)
     {
@@ -13,6 +13,7 @@ namespace dbiplus {
   class Dataset;
 }
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -206,9 +207,10 @@ public:
 
   /*!
    * @brief Commit all queries in the queue.
+   * @param changedRows If not nullptr, receives the number of rows the queries changed.
    * @return True if all queries were executed successfully, false otherwise.
    */
-  bool CommitInsertQueries();
+  bool CommitInsertQueries(int64_t* changedRows = nullptr);
 
   /*!
    * @brief Get the number of INSERT queries in the queue.
@@ -225,9 +227,10 @@ public:
 
   /*!
    * @brief Commit all queued DELETE queries.
+   * @param changedRows If not nullptr, receives the number of rows the queries deleted.
    * @return True if all queries were executed successfully, false otherwise.
    */
-  bool CommitDeleteQueries();
+  bool CommitDeleteQueries(int64_t* changedRows = nullptr);
 
   /*!
    * @brief Get the number of DELETE queries in the queue.
@@ -79,6 +79,7 @@ Dataset::Dataset():
   frecno = 0;
   fbof = feof = true;
   autocommit = true;
+  changed_rows = 0;
   fieldIndexMapID = ~0;
 
   fields_object = new Fields();
@@ -97,6 +98,7 @@ Dataset::Dataset(Database *newDb):
   frecno = 0;
   fbof = feof = true;
   autocommit = true;
+  changed_rows = 0;
   fieldIndexMapID = ~0;
 
   fields_object = new Fields();
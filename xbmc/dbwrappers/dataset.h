@@ -196,6 +196,7 @@ protected:
   ParamList plist;              // Paramlist for locate
   bool fbof, feof;
   bool autocommit;		// for transactions
+  int64_t changed_rows;		// rows changed by the last insert, edit or deletion
 
 
 /* Variables to store SQL statements */
@@ -279,6 +280,8 @@ public:
 
 /* last inserted id */
   virtual int64_t lastinsertid() = 0;
+/* number of rows changed by the last post or deletion */
+  virtual int64_t changedrows() { return changed_rows; }
 /* sequence numbers */
   virtual long nextid(const char *seq_name)=0;
 /* sequence numbers */
@@ -1447,6 +1447,8 @@ void MysqlDataset::make_query(StringList &_sql) {
   {
     if (autocommit) db->start_transaction();
 
+    changed_rows = 0;
+
     for (const std::string& i : _sql)
     {
       query = i;
@@ -1455,6 +1457,9 @@ void MysqlDataset::make_query(StringList &_sql) {
       {
         throw DbErrors(db->getErrorMsg());
       }
+      const uint64_t rows = mysql_affected_rows(handle());
+      if (rows != static_cast<uint64_t>(-1))
+        changed_rows += rows;
     } // end of for
 
     if (db->in_transaction() && autocommit) db->commit_transaction();
@@ -645,6 +645,7 @@ void SqliteDataset::make_query(StringList &_sql) {
 
   if (autocommit) db->start_transaction();
 
+  changed_rows = 0;
 
   for (const std::string& i : _sql)
   {
@@ -664,6 +665,7 @@ void SqliteDataset::make_query(StringList &_sql) {
       }
       throw DbErrors("%s", message.c_str());
     }
+    changed_rows += sqlite3_changes(this->handle());
   } // end of for
 
 
@@ -609,6 +609,8 @@ int CFileCache::IoControl(EIoControl request, void* param)
     status->maxrate = m_writeRate;
     status->currate = m_writeRateActual;
     status->lowspeed = m_bLowSpeedDetected;
+    status->full = m_forwardCacheSize != 0 &&
+                   static_cast<int64_t>(status->forward) + m_chunkSize >= m_forwardCacheSize;
     m_bLowSpeedDetected = false; // Reset flag
     return 0;
   }
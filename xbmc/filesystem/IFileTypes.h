@@ -52,6 +52,7 @@ struct SCacheStatus
   unsigned maxrate;  /**< maximum number of bytes per second cache is allowed to fill */
   unsigned currate;  /**< average read rate from source file since last position change */
   bool     lowspeed; /**< cache low speed condition detected? */
+  bool     full = false; /**< forward cache is full, the source is not read until data is consumed */
 };
 
 typedef enum {
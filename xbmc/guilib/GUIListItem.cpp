@@ -302,6 +302,37 @@ void CGUIListItem::Serialize(CVariant &value)
     value["art"][it.first] = it.second;
 }
 
+std::size_t CGUIListItem::GetStringMemoryUsage(const std::string& str)
+{
+  return str.capacity() > std::string().capacity() ? str.capacity() + 1 : 0;
+}
+
+std::size_t CGUIListItem::GetMemoryUsage() const
+{
+  // red-black tree node header: colour + parent/left/right pointers
+  constexpr std::size_t mapNodeSize = 4 * sizeof(void*);
+
+  std::size_t bytes = sizeof(CGUIListItem);
+  bytes += GetStringMemoryUsage(m_strLabel) + GetStringMemoryUsage(m_strLabel2);
+  bytes += m_sortLabel.capacity() > std::wstring().capacity()
+               ? (m_sortLabel.capacity() + 1) * sizeof(wchar_t)
+               : 0;
+
+  for (const auto& it : m_mapProperties)
+  {
+    bytes += mapNodeSize + sizeof(PropertyMap::value_type) + GetStringMemoryUsage(it.first);
+    if (it.second.isString())
+      bytes += GetStringMemoryUsage(it.second.asString());
+  }
+  for (const ArtMap* art : {&m_art, &m_artFallbacks})
+  {
+    for (const auto& it : *art)
+      bytes += mapNodeSize + sizeof(ArtMap::value_type) + GetStringMemoryUsage(it.first) +
+               GetStringMemoryUsage(it.second);
+  }
+  return bytes;
+}
+
 void CGUIListItem::FreeIcons()
 {
   FreeMemory();
@@ -155,6 +155,12 @@ public:
   void Archive(CArchive& ar);
   void Serialize(CVariant& value);
 
+  /*!
+   \brief Approximate number of bytes used by this item, including owned heap allocations.
+   Shared data (layouts, shared info tags, interned strings) is not accounted for.
+   */
+  virtual std::size_t GetMemoryUsage() const;
+
   bool       HasProperty(const std::string &strKey) const;
   bool       HasProperties() const { return !m_mapProperties.empty(); };
   void       ClearProperty(const std::string &strKey);
@@ -191,6 +197,11 @@ protected:
 
   typedef std::map<std::string, CVariant, icompare> PropertyMap;
   PropertyMap m_mapProperties;
+
+  /*!
+   \brief Approximate heap usage of a string, zero if it fits the small string buffer.
+   */
+  static std::size_t GetStringMemoryUsage(const std::string& str);
 private:
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
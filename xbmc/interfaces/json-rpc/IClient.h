@@ -17,5 +17,8 @@ namespace JSONRPC
     virtual int GetPermissionFlags() = 0;
     virtual int GetAnnouncementFlags() = 0;
     virtual bool SetAnnouncementFlags(int flags) = 0;
+    virtual bool CanBatchNotifications() { return false; }
+    virtual bool IsBatchingNotifications() { return false; }
+    virtual void SetBatchingNotifications(bool batching) {}
   };
 }
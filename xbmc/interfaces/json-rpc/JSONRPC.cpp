@@ -25,6 +25,7 @@
 #include "utils/log.h"
 
 #include <string.h>
+#include <utility>
 
 using namespace JSONRPC;
 
@@ -165,11 +166,18 @@ JSONRPC_STATUS CJSONRPC::GetConfiguration(const std::string &method, ITransportL
   for (int i = 1; i <= ANNOUNCEMENT::ANNOUNCE_ALL; i *= 2)
     result["notifications"][AnnouncementFlagToString((ANNOUNCEMENT::AnnouncementFlag)i)] = (flags & i) == i;
 
+  result["batching"] = client->IsBatchingNotifications();
+
   return OK;
 }
 
 JSONRPC_STATUS CJSONRPC::SetConfiguration(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result)
 {
+  // validate everything before changing anything, so a failure leaves the configuration as it was
+  bool batching = parameterObject["batching"].isBoolean() && parameterObject["batching"].asBoolean();
+  if (batching && !client->CanBatchNotifications())
+    return BadPermission;
+
   int flags = 0;
   int oldFlags = client->GetAnnouncementFlags();
 
@@ -194,20 +202,28 @@ JSONRPC_STATUS CJSONRPC::SetConfiguration(const std::string &method, ITransportL
     if ((notifications["AudioLibrary"].isNull() && (oldFlags & ANNOUNCEMENT::AudioLibrary)) ||
         (notifications["AudioLibrary"].isBoolean() && notifications["AudioLibrary"].asBoolean()))
       flags |= ANNOUNCEMENT::AudioLibrary;
-    if ((notifications["Application"].isNull() && (oldFlags & ANNOUNCEMENT::Other)) ||
+    if ((notifications["Application"].isNull() && (oldFlags & ANNOUNCEMENT::Application)) ||
         (notifications["Application"].isBoolean() && notifications["Application"].asBoolean()))
       flags |= ANNOUNCEMENT::Application;
     if ((notifications["Input"].isNull() && (oldFlags & ANNOUNCEMENT::Input)) ||
         (notifications["Input"].isBoolean() && notifications["Input"].asBoolean()))
       flags |= ANNOUNCEMENT::Input;
+    if ((notifications["PVR"].isNull() && (oldFlags & ANNOUNCEMENT::PVR)) ||
+        (notifications["PVR"].isBoolean() && notifications["PVR"].asBoolean()))
+      flags |= ANNOUNCEMENT::PVR;
     if ((notifications["Other"].isNull() && (oldFlags & ANNOUNCEMENT::Other)) ||
         (notifications["Other"].isBoolean() && notifications["Other"].asBoolean()))
       flags |= ANNOUNCEMENT::Other;
   }
+  else
+    flags = oldFlags;
 
   if (!client->SetAnnouncementFlags(flags))
     return BadPermission;
 
+  if (parameterObject["batching"].isBoolean())
+    client->SetBatchingNotifications(batching);
+
   return GetConfiguration(method, transport, client, parameterObject, result);
 }
 
@@ -230,7 +246,17 @@ JSONRPC_STATUS CJSONRPC::NotifyAll(const std::string &method, ITransportLayer *t
 
 std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client)
 {
-  CVariant inputroot, outputroot, result;
+  CVariant outputroot;
+  std::string str;
+  if (MethodCall(inputString, transport, client, outputroot))
+    CJSONVariantWriter::Write(outputroot, str, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+
+  return str;
+}
+
+bool CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client, CVariant& outputroot)
+{
+  CVariant inputroot;
   bool hasResponse = false;
 
   CLog::Log(LOGDEBUG, LOGJSONRPC, "JSONRPC: Incoming request: %s", inputString.c_str());
@@ -252,7 +278,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
           CVariant response;
           if (HandleMethodCall(*itr, response, transport, client))
           {
-            outputroot.append(response);
+            outputroot.append(std::move(response));
             hasResponse = true;
           }
         }
@@ -268,11 +294,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
     hasResponse = true;
   }
 
-  std::string str;
-  if (hasResponse)
-    CJSONVariantWriter::Write(outputroot, str, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
-
-  return str;
+  return hasResponse;
 }
 
 bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client)
@@ -305,7 +327,7 @@ bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITr
     errorCode = InvalidRequest;
   }
 
-  BuildResponse(request, errorCode, result, response);
+  BuildResponse(request, errorCode, std::move(result), response);
 
   return !isNotification;
 }
@@ -315,7 +337,7 @@ inline bool CJSONRPC::IsProperJSONRPC(const CVariant& inputroot)
   return inputroot.isMember("jsonrpc") && inputroot["jsonrpc"].isString() && inputroot["jsonrpc"] == CVariant("2.0") && inputroot.isMember("method") && inputroot["method"].isString() && (!inputroot.isMember("params") || inputroot["params"].isArray() || inputroot["params"].isObject());
 }
 
-inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code, const CVariant& result, CVariant& response)
+inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code, CVariant&& result, CVariant& response)
 {
   response["jsonrpc"] = "2.0";
   response["id"] = request.isMember("id") ? request["id"] : CVariant();
@@ -323,7 +345,7 @@ inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code
   switch (code)
   {
     case OK:
-      response["result"] = result;
+      response["result"] = std::move(result);
       break;
     case ACK:
       response["result"] = "OK";
@@ -336,7 +358,7 @@ inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code
       response["error"]["code"] = InvalidParams;
       response["error"]["message"] = "Invalid params.";
       if (!result.isNull())
-        response["error"]["data"] = result;
+        response["error"]["data"] = std::move(result);
       break;
     case MethodNotFound:
       response["error"]["code"] = MethodNotFound;
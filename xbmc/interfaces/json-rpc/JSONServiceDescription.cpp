@@ -30,6 +30,8 @@
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+
 using namespace JSONRPC;
 
 std::map<std::string, CVariant> CJSONServiceDescription::m_notifications = std::map<std::string, CVariant>();
@@ -641,9 +643,23 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
                                                CVariant& outputValue,
                                                CVariant& errorData) const
 {
-  if (!name.empty())
-    errorData["name"] = name;
-  SchemaValueTypeToJson(type, errorData["type"]);
+  JSONRPC_STATUS status = checkValue(value, outputValue, errorData);
+
+  // only describe the failing type, error data is thrown away for valid values
+  if (status != OK)
+  {
+    if (!name.empty())
+      errorData["name"] = name;
+    SchemaValueTypeToJson(type, errorData["type"]);
+  }
+
+  return status;
+}
+
+JSONRPC_STATUS JSONSchemaTypeDefinition::checkValue(const CVariant& value,
+                                                    CVariant& outputValue,
+                                                    CVariant& errorData) const
+{
   std::string errorMessage;
 
   // Let's check the type of the provided parameter
@@ -907,12 +923,17 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
   if (enums.size() > 0)
   {
     bool valid = false;
-    for (const auto& enumItr : enums)
+    if (!stringEnums.empty())
+      valid = value.isString() && stringEnums.find(value.c_str()) != stringEnums.end();
+    else
     {
-      if (enumItr == value)
+      for (const auto& enumItr : enums)
       {
-        valid = true;
-        break;
+        if (enumItr == value)
+        {
+          valid = true;
+          break;
+        }
       }
     }
 
@@ -1199,6 +1220,37 @@ void JSONSchemaTypeDefinition::ResolveReference()
   referencedTypeSet = true;
 }
 
+void JSONSchemaTypeDefinition::Compile()
+{
+  // guard against cycles
+  if (compiled)
+    return;
+
+  compiled = true;
+
+  for (const auto& it : extends)
+    it->Compile();
+  for (const auto& it : unionTypes)
+    it->Compile();
+  for (const auto& it : items)
+    it->Compile();
+  for (const auto& it : additionalItems)
+    it->Compile();
+  for (const auto& it : properties)
+    it.second->Compile();
+
+  if (additionalProperties)
+    additionalProperties->Compile();
+
+  stringEnums.clear();
+  if (!enums.empty() && std::all_of(enums.begin(), enums.end(),
+                                    [](const CVariant& value) { return value.isString(); }))
+  {
+    for (const auto& it : enums)
+      stringEnums.insert(it.asString());
+  }
+}
+
 JSONSchemaTypeDefinition::CJsonSchemaPropertiesMap::CJsonSchemaPropertiesMap() :
    m_propertiesmap(std::map<std::string, JSONSchemaTypeDefinitionPtr>())
 {
@@ -1396,7 +1448,9 @@ JSONRPC_STATUS JsonRpcMethod::checkParameter(const CVariant& requestParameters,
   if (ParameterExists(requestParameters, type->name, position))
   {
     // Get the parameter
-    CVariant parameterValue = GetParameter(requestParameters, type->name, position);
+    const CVariant& parameterValue = IsValueMember(requestParameters, type->name)
+                                         ? requestParameters[type->name]
+                                         : requestParameters[position];
 
     // Evaluate the type of the parameter
     JSONRPC_STATUS status = type->Check(parameterValue, outputParameters[type->name], errorData["stack"]);
@@ -1426,6 +1480,15 @@ void CJSONServiceDescription::ResolveReferences()
 {
   for (const auto& it : m_types)
     it.second->ResolveReference();
+
+  // precompute everything needed to validate calls now that all types are complete
+  for (const auto& it : m_types)
+    it.second->Compile();
+  for (const auto& it : m_actionMap)
+  {
+    for (const auto& parameter : it.second.parameters)
+      parameter->Compile();
+  }
 }
 
 void CJSONServiceDescription::Cleanup()
@@ -11,8 +11,10 @@
 #include "JSONUtils.h"
 #include "utils/Variant.h"
 
+#include <functional>
 #include <limits>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -41,6 +43,12 @@ namespace JSONRPC
     void Print(bool isParameter, bool isGlobal, bool printDefault, bool printDescriptions, CVariant &output) const;
     void ResolveReference();
 
+    /*!
+     \brief Precomputes the lookup structures used by Check().
+     Must be called once all references have been resolved.
+     */
+    void Compile();
+
     std::string missingReference;
 
     /*!
@@ -147,6 +155,17 @@ namespace JSONRPC
      */
     std::vector<CVariant> enums;
 
+    /*!
+     \brief Sorted copy of "enums" for fast lookups
+     (only set if all allowed values are strings)
+     */
+    std::set<std::string, std::less<>> stringEnums;
+
+    /*!
+     \brief Whether Compile() has been run
+     */
+    bool compiled = false;
+
     /*!
      \brief List of possible values in an array
      */
@@ -211,6 +230,9 @@ namespace JSONRPC
      \brief Type definition for additional properties
      */
     JSONSchemaTypeDefinitionPtr additionalProperties;
+
+  private:
+    JSONRPC_STATUS checkValue(const CVariant& value, CVariant& outputValue, CVariant& errorData) const;
   };
 
   /*!
@@ -50,6 +50,9 @@ using namespace JSONRPC;
 
 #define RECEIVEBUFFER 1024
 
+// interval in ms during which notifications are collected for clients batching them
+#define NOTIFICATION_BATCH_INTERVAL 100
+
 CTCPServer *CTCPServer::ServerInstance = NULL;
 
 bool CTCPServer::StartServer(int port, bool nonlocal)
@@ -117,6 +120,13 @@ void CTCPServer::Process()
       FD_SET(m_connections[i]->m_socket, &rfds);
       if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
         max_fd = m_connections[i]->m_socket;
+
+      // wake up in time to send batched notifications
+      if (m_connections[i]->IsBatchingNotifications())
+      {
+        to.tv_sec = 0;
+        to.tv_usec = NOTIFICATION_BATCH_INTERVAL * 1000;
+      }
     }
 
     int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
@@ -202,6 +212,8 @@ void CTCPServer::Process()
         }
       }
     }
+
+    SendPendingNotifications();
   }
 
   Deinitialize();
@@ -237,7 +249,21 @@ void CTCPServer::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
         continue;
     }
 
-    m_connections[i]->Send(str.c_str(), str.size());
+    // batched notifications are sent from Process() so they arrive in order
+    if (m_connections[i]->IsBatchingNotifications())
+      m_connections[i]->AddPendingNotification(str);
+    else
+      m_connections[i]->Send(str.c_str(), str.size());
+  }
+}
+
+void CTCPServer::SendPendingNotifications()
+{
+  for (auto& connection : m_connections)
+  {
+    std::string batch;
+    if (connection->GetPendingNotifications(batch))
+      connection->Send(batch.c_str(), batch.size());
   }
 }
 
@@ -496,6 +522,7 @@ CTCPServer::CTCPClient::CTCPClient()
   m_endBrackets = 0;
   m_beginChar = 0;
   m_endChar = 0;
+  m_batchNotifications = false;
 
   m_addrlen = sizeof(m_cliaddr);
 }
@@ -527,6 +554,49 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
   return true;
 }
 
+bool CTCPServer::CTCPClient::IsBatchingNotifications()
+{
+  CSingleLock lock (m_critSection);
+  return m_batchNotifications;
+}
+
+void CTCPServer::CTCPClient::SetBatchingNotifications(bool batching)
+{
+  CSingleLock lock (m_critSection);
+  m_batchNotifications = batching;
+}
+
+void CTCPServer::CTCPClient::AddPendingNotification(const std::string& notification)
+{
+  CSingleLock lock (m_critSection);
+  if (m_pendingNotifications.empty())
+  {
+    m_pendingNotifications.push_back('[');
+    m_pendingSince = std::chrono::steady_clock::now();
+  }
+  else
+    m_pendingNotifications.push_back(',');
+
+  m_pendingNotifications.append(notification);
+}
+
+bool CTCPServer::CTCPClient::GetPendingNotifications(std::string& batch)
+{
+  CSingleLock lock (m_critSection);
+  if (m_pendingNotifications.empty())
+    return false;
+
+  // leftovers from before batching was disabled are sent right away
+  if (m_batchNotifications && std::chrono::steady_clock::now() - m_pendingSince <
+                                  std::chrono::milliseconds(NOTIFICATION_BATCH_INTERVAL))
+    return false;
+
+  batch.swap(m_pendingNotifications);
+  batch.push_back(']');
+  m_pendingNotifications.clear();
+  return true;
+}
+
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
   unsigned int sent = 0;
@@ -622,16 +692,19 @@ void CTCPServer::CTCPClient::Disconnect()
 
 void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
 {
-  m_new               = client.m_new;
-  m_socket            = client.m_socket;
-  m_cliaddr           = client.m_cliaddr;
-  m_addrlen           = client.m_addrlen;
-  m_announcementflags = client.m_announcementflags;
-  m_beginBrackets     = client.m_beginBrackets;
-  m_endBrackets       = client.m_endBrackets;
-  m_beginChar         = client.m_beginChar;
-  m_endChar           = client.m_endChar;
-  m_buffer            = client.m_buffer;
+  m_new                  = client.m_new;
+  m_socket               = client.m_socket;
+  m_cliaddr              = client.m_cliaddr;
+  m_addrlen              = client.m_addrlen;
+  m_announcementflags    = client.m_announcementflags;
+  m_beginBrackets        = client.m_beginBrackets;
+  m_endBrackets          = client.m_endBrackets;
+  m_beginChar            = client.m_beginChar;
+  m_endChar              = client.m_endChar;
+  m_buffer               = client.m_buffer;
+  m_batchNotifications   = client.m_batchNotifications;
+  m_pendingNotifications = client.m_pendingNotifications;
+  m_pendingSince         = client.m_pendingSince;
 }
 
 CTCPServer::CWebSocketClient::CWebSocketClient(CWebSocket *websocket)
@@ -15,6 +15,8 @@
 #include "threads/Thread.h"
 #include "websocket/WebSocket.h"
 
+#include <chrono>
+#include <string>
 #include <vector>
 
 #include <sys/socket.h>
@@ -49,6 +51,7 @@ namespace JSONRPC
     bool InitializeBlue();
     bool InitializeTCP();
     void Deinitialize();
+    void SendPendingNotifications();
 
     class CTCPClient : public IClient
     {
@@ -63,6 +66,19 @@ namespace JSONRPC
       int GetPermissionFlags() override;
       int GetAnnouncementFlags() override;
       bool SetAnnouncementFlags(int flags) override;
+      bool CanBatchNotifications() override { return true; }
+      bool IsBatchingNotifications() override;
+      void SetBatchingNotifications(bool batching) override;
+
+      /*!
+       \brief Queues a notification for the next batch
+       */
+      void AddPendingNotification(const std::string& notification);
+      /*!
+       \brief Takes the pending notifications as a JSON array
+       \return False if there is nothing to send yet
+       */
+      bool GetPendingNotifications(std::string& batch);
 
       virtual void Send(const char *data, unsigned int size);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
@@ -84,6 +100,9 @@ namespace JSONRPC
       int m_beginBrackets, m_endBrackets;
       char m_beginChar, m_endChar;
       std::string m_buffer;
+      bool m_batchNotifications;
+      std::string m_pendingNotifications;
+      std::chrono::steady_clock::time_point m_pendingSince;
     };
 
     class CWebSocketClient : public CTCPClient
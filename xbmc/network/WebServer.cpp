@@ -367,6 +367,10 @@ MHD_RESULT CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>&
       ret = CreateMemoryDownloadResponse(handler, response);
       break;
 
+    case HTTPStreamDownload:
+      ret = CreateStreamDownloadResponse(handler, response);
+      break;
+
     case HTTPError:
       ret =
           CreateErrorResponse(request.connection, responseDetails.status, request.method, response);
@@ -944,6 +948,41 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   return MHD_YES;
 }
 
+MHD_RESULT CWebServer::CreateStreamDownloadResponse(
+    const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response*& response) const
+{
+  if (handler == nullptr)
+    return MHD_NO;
+
+  const HTTPRequest& request = handler->GetRequest();
+  if (request.method == HEAD)
+  {
+    response = create_response(0, nullptr, MHD_NO, MHD_NO);
+    if (response == nullptr)
+    {
+      m_logger->error("failed to create a HTTP HEAD response for {}", request.pathUrl);
+      return MHD_NO;
+    }
+
+    return MHD_YES;
+  }
+
+  // keep the request handler alive until MHD has read all of its data
+  auto context = std::make_unique<std::shared_ptr<IHTTPRequestHandler>>(handler);
+  response = MHD_create_response_from_callback(MHD_SIZE_UNKNOWN, 32 * 1024,
+                                               &CWebServer::StreamReaderCallback, context.get(),
+                                               &CWebServer::StreamReaderFreeCallback);
+  if (response == nullptr)
+  {
+    m_logger->error("failed to create a HTTP streamed response for {}", request.pathUrl);
+    return MHD_NO;
+  }
+
+  context.release(); // ownership was passed to mhd
+
+  return MHD_YES;
+}
+
 MHD_RESULT CWebServer::CreateErrorResponse(struct MHD_Connection* connection,
                                            int responseType,
                                            HTTPMethod method,
@@ -1147,6 +1186,30 @@ void CWebServer::ContentReaderFreeCallback(void* cls)
     s_logger->debug("[OUT] done");
 }
 
+ssize_t CWebServer::StreamReaderCallback(void* cls, uint64_t pos, char* buf, size_t max)
+{
+  auto handler = static_cast<std::shared_ptr<IHTTPRequestHandler>*>(cls);
+  if (handler == nullptr || *handler == nullptr)
+    return MHD_CONTENT_READER_END_WITH_ERROR;
+
+  const size_t read = (*handler)->ReadResponseData(buf, max);
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+    s_logger->debug("[OUT] streamed {} bytes at {}", read, pos);
+
+  if (read == 0)
+    return MHD_CONTENT_READER_END_OF_STREAM;
+
+  return static_cast<ssize_t>(read);
+}
+
+void CWebServer::StreamReaderFreeCallback(void* cls)
+{
+  delete static_cast<std::shared_ptr<IHTTPRequestHandler>*>(cls);
+
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+    s_logger->debug("[OUT] done");
+}
+
 // static logger for libmicrohttpd
 static Logger GetMhdLogger()
 {
@@ -16,11 +16,25 @@
 #include "interfaces/json-rpc/JSONUtils.h"
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/JSONVariantWriter.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 #define MAX_HTTP_POST_SIZE 65536
+// responses up to this size are sent in one piece with a known content length
+#define MAX_HTTP_RESPONSE_BUFFER_SIZE 65536
+
+CHTTPJsonRpcHandler::CHTTPJsonRpcHandler(const HTTPRequest &request)
+  : IHTTPRequestHandler(request)
+{ }
+
+CHTTPJsonRpcHandler::~CHTTPJsonRpcHandler() = default;
 
 bool CHTTPJsonRpcHandler::CanHandleRequest(const HTTPRequest &request) const
 {
@@ -74,7 +88,19 @@ MHD_RESULT CHTTPJsonRpcHandler::HandleRequest()
 
   if (isRequest)
   {
-    m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
+    CVariant response;
+    bool hasResponse = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client, response);
+    m_requestData.clear();
+
+    const bool compact = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact;
+    if (hasResponse && jsonpCallback.empty())
+    {
+      SetResponse(std::move(response), compact);
+      return MHD_YES;
+    }
+
+    if (hasResponse)
+      CJSONVariantWriter::Write(response, m_responseData, compact);
 
     if (!jsonpCallback.empty())
       m_responseData = jsonpCallback + "(" + m_responseData + ");";
@@ -120,6 +146,49 @@ HttpResponseRanges CHTTPJsonRpcHandler::GetResponseData() const
   return ranges;
 }
 
+size_t CHTTPJsonRpcHandler::ReadResponseData(char* buffer, size_t size)
+{
+  // first hand out what has already been serialised by SetResponse()
+  if (m_responseDataPosition < m_responseData.size())
+  {
+    const size_t length = std::min(size, m_responseData.size() - m_responseDataPosition);
+    memcpy(buffer, m_responseData.data() + m_responseDataPosition, length);
+    m_responseDataPosition += length;
+    return length;
+  }
+
+  if (m_responseWriter == nullptr)
+    return 0;
+
+  return m_responseWriter->Read(buffer, size);
+}
+
+void CHTTPJsonRpcHandler::SetResponse(CVariant&& response, bool compact)
+{
+  m_responseWriter = std::make_unique<CJSONVariantStreamWriter>(std::move(response), compact);
+
+  m_responseData.resize(MAX_HTTP_RESPONSE_BUFFER_SIZE);
+  m_responseData.resize(m_responseWriter->Read(&m_responseData[0], m_responseData.size()));
+  m_responseDataPosition = 0;
+
+  m_response.status = MHD_HTTP_OK;
+  m_response.contentType = "application/json";
+
+  if (m_responseWriter->IsComplete())
+  {
+    // small response, send it with a known length as before
+    m_responseWriter.reset();
+    m_responseRange.SetData(m_responseData.c_str(), m_responseData.size());
+    m_response.type = HTTPMemoryDownloadNoFreeCopy;
+    m_response.totalLength = m_responseData.size();
+  }
+  else
+  {
+    // large response, serialise the rest while sending it
+    m_response.type = HTTPStreamDownload;
+  }
+}
+
 bool CHTTPJsonRpcHandler::appendPostData(const char *data, size_t size)
 {
   if (m_requestData.size() + size > MAX_HTTP_POST_SIZE)
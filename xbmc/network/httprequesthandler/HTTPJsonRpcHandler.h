@@ -12,13 +12,17 @@
 #include "interfaces/json-rpc/ITransportLayer.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 
+#include <memory>
 #include <string>
 
+class CJSONVariantStreamWriter;
+class CVariant;
+
 class CHTTPJsonRpcHandler : public IHTTPRequestHandler
 {
 public:
   CHTTPJsonRpcHandler() = default;
-  ~CHTTPJsonRpcHandler() override = default;
+  ~CHTTPJsonRpcHandler() override;
 
   // implementations of IHTTPRequestHandler
   IHTTPRequestHandler* Create(const HTTPRequest &request) const override { return new CHTTPJsonRpcHandler(request); }
@@ -27,20 +31,23 @@ public:
   MHD_RESULT HandleRequest() override;
 
   HttpResponseRanges GetResponseData() const override;
+  size_t ReadResponseData(char* buffer, size_t size) override;
 
   int GetPriority() const override { return 5; }
 
 protected:
-  explicit CHTTPJsonRpcHandler(const HTTPRequest &request)
-    : IHTTPRequestHandler(request)
-  { }
+  explicit CHTTPJsonRpcHandler(const HTTPRequest &request);
 
   bool appendPostData(const char *data, size_t size) override;
 
 private:
+  void SetResponse(CVariant&& response, bool compact);
+
   std::string m_requestData;
   std::string m_responseData;
   CHttpResponseRange m_responseRange;
+  size_t m_responseDataPosition = 0;
+  std::unique_ptr<CJSONVariantStreamWriter> m_responseWriter;
 
   class CHTTPTransportLayer : public JSONRPC::ITransportLayer
   {
@@ -60,7 +60,10 @@ typedef enum HTTPResponseType
   HTTPMemoryDownloadFreeNoCopy,
   // creates a HTTP response from a buffer by copying followed by freeing the buffer
   // the buffer must have been malloc'ed and not new'ed
-  HTTPMemoryDownloadFreeCopy
+  HTTPMemoryDownloadFreeCopy,
+  // creates a HTTP response of unknown length which is read piece by piece from
+  // the request handler while being sent
+  HTTPStreamDownload
 } HTTPResponseType;
 
 typedef struct HTTPRequest
@@ -153,6 +156,18 @@ public:
    */
   virtual HttpResponseRanges GetResponseData() const { return HttpResponseRanges(); };
 
+  /*!
+   * \brief Reads the next part of the response data into the given buffer.
+   *
+   * \details This is only used if the response type is HTTPStreamDownload.
+   * It is called from the webserver's connection thread until it returns 0.
+   *
+   * \param buffer Buffer to fill with response data
+   * \param size Maximum number of bytes to write into the buffer
+   * \return Number of bytes written into the buffer, 0 at the end of the response.
+   */
+  virtual size_t ReadResponseData(char* buffer, size_t size) { return 0; }
+
   /*!
   * \brief Returns the URL to which the request should be redirected.
   *
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "network/websocket/WebSocketDeflate.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+TEST(TestWebSocketDeflate, Negotiate)
+{
+  int windowBits = 0;
+  EXPECT_TRUE(CWebSocketDeflate::Negotiate("permessage-deflate", windowBits));
+  EXPECT_EQ(MAX_WBITS, windowBits);
+
+  EXPECT_TRUE(CWebSocketDeflate::Negotiate("permessage-deflate; client_max_window_bits", windowBits));
+  EXPECT_EQ(MAX_WBITS, windowBits);
+
+  EXPECT_TRUE(CWebSocketDeflate::Negotiate(
+      "x-webkit-deflate-frame, permessage-deflate; server_max_window_bits=10", windowBits));
+  EXPECT_EQ(10, windowBits);
+
+  EXPECT_FALSE(CWebSocketDeflate::Negotiate("x-webkit-deflate-frame", windowBits));
+  EXPECT_FALSE(CWebSocketDeflate::Negotiate("permessage-deflate; server_max_window_bits=8", windowBits));
+  EXPECT_FALSE(CWebSocketDeflate::Negotiate("permessage-deflate; unknown_parameter", windowBits));
+}
+
+TEST(TestWebSocketDeflate, ResponseHeader)
+{
+  EXPECT_STREQ("permessage-deflate; server_no_context_takeover; client_no_context_takeover",
+               CWebSocketDeflate().GetResponseHeader().c_str());
+  EXPECT_STREQ("permessage-deflate; server_no_context_takeover; client_no_context_takeover; "
+               "server_max_window_bits=10",
+               CWebSocketDeflate(10).GetResponseHeader().c_str());
+}
+
+TEST(TestWebSocketDeflate, RoundTrip)
+{
+  std::string message;
+  for (int i = 0; i < 1000; i++)
+    message += "{\"jsonrpc\":\"2.0\",\"method\":\"VideoLibrary.OnUpdate\",\"params\":{\"data\":{\"item\":{\"id\":" +
+               std::to_string(i) + ",\"type\":\"movie\"}},\"sender\":\"xbmc\"}}";
+
+  CWebSocketDeflate deflate;
+  std::string compressed, decompressed;
+  for (int i = 0; i < 2; i++)
+  {
+    ASSERT_TRUE(deflate.Compress(message.c_str(), message.size(), compressed));
+    EXPECT_LT(compressed.size(), message.size() / 10);
+    ASSERT_TRUE(deflate.Decompress(compressed, decompressed));
+    EXPECT_EQ(message, decompressed);
+  }
+}
+
+TEST(TestWebSocketDeflate, DecompressInvalid)
+{
+  CWebSocketDeflate deflate;
+  std::string decompressed;
+  EXPECT_FALSE(deflate.Decompress(std::string("\xff\xff\xff\xff\xff", 5), decompressed));
+}
@@ -8,6 +8,7 @@
 
 #include "WebSocket.h"
 
+#include "WebSocketDeflate.h"
 #include "utils/EndianSwap.h"
 #include "utils/HttpParser.h"
 #include "utils/StringUtils.h"
@@ -29,6 +30,9 @@
 
 #define LENGTH_MIN    0x2
 
+// messages smaller than this aren't worth compressing
+#define DEFLATE_MIN_LENGTH 256
+
 CWebSocketFrame::CWebSocketFrame(const char* data, uint64_t length)
 {
   reset();
@@ -43,9 +47,7 @@ CWebSocketFrame::CWebSocketFrame(const char* data, uint64_t length)
   // Get the FIN flag
   m_final = ((m_data[0] & MASK_FIN) == MASK_FIN);
   // Get the RSV1 - RSV3 flags
-  m_extension |= m_data[0] & MASK_RSV1;
-  m_extension |= (m_data[0] & MASK_RSV2) << 1;
-  m_extension |= (m_data[0] & MASK_RSV3) << 2;
+  m_extension = (m_data[0] & MASK_RSV) >> 4;
   // Get the opcode
   m_opcode = (WebSocketFrameOpcode)(m_data[0] & MASK_OPCODE);
   if (m_opcode >= WebSocketUnknownFrame)
@@ -285,6 +287,12 @@ void CWebSocketMessage::Clear()
   m_frames.clear();
 }
 
+CWebSocket::~CWebSocket()
+{
+  delete m_message;
+  delete m_deflate;
+}
+
 const CWebSocketMessage* CWebSocket::Handle(const char* &buffer, size_t &length, bool &send)
 {
   send = false;
@@ -369,6 +377,10 @@ const CWebSocketMessage* CWebSocket::Handle(const char* &buffer, size_t &length,
 
         CWebSocketMessage *msg = m_message;
         m_message = NULL;
+
+        if (m_deflate != NULL && (msg->GetFrames().front()->GetExtension() & WebSocketExtensionDeflate))
+          return decompress(msg);
+
         return msg;
       }
 
@@ -408,7 +420,14 @@ const CWebSocketMessage* CWebSocket::Handle(const char* &buffer, size_t &length,
 
 const CWebSocketMessage* CWebSocket::Send(WebSocketFrameOpcode opcode, const char* data /* = NULL */, uint32_t length /* = 0 */)
 {
-  CWebSocketFrame *frame = GetFrame(opcode, data, length);
+  CWebSocketFrame *frame = NULL;
+  std::string compressed;
+  if (m_deflate != NULL && (opcode == WebSocketTextFrame || opcode == WebSocketBinaryFrame) &&
+      length >= DEFLATE_MIN_LENGTH && m_deflate->Compress(data, length, compressed))
+    frame = GetFrame(opcode, compressed.c_str(), (uint32_t)compressed.size(), true, false, 0, WebSocketExtensionDeflate);
+  else
+    frame = GetFrame(opcode, data, length);
+
   if (frame == NULL || !frame->IsValid())
   {
     CLog::Log(LOGINFO, "WebSocket: Trying to send an invalid frame");
@@ -428,3 +447,32 @@ const CWebSocketMessage* CWebSocket::Send(WebSocketFrameOpcode opcode, const cha
 
   return NULL;
 }
+
+CWebSocketMessage* CWebSocket::decompress(CWebSocketMessage* message)
+{
+  const std::vector<const CWebSocketFrame*>& frames = message->GetFrames();
+  WebSocketFrameOpcode opcode = frames.front()->GetOpcode();
+
+  std::string data;
+  for (const auto& frame : frames)
+  {
+    if (frame->GetLength() > 0)
+      data.append(frame->GetApplicationData(), (size_t)frame->GetLength());
+  }
+  delete message;
+
+  std::string decompressed;
+  if (!m_deflate->Decompress(data, decompressed))
+  {
+    CLog::Log(LOGINFO, "WebSocket: Invalid compressed message received");
+    Fail();
+    return NULL;
+  }
+
+  message = GetMessage();
+  if (message == NULL)
+    return NULL;
+
+  message->AddFrame(GetFrame(opcode, decompressed.c_str(), (uint32_t)decompressed.size()));
+  return message;
+}
@@ -25,6 +25,13 @@ enum WebSocketFrameOpcode
   WebSocketUnknownFrame       = 0x10
 };
 
+// RSV1 - RSV3 flags as used by CWebSocketFrame
+enum WebSocketExtension
+{
+  WebSocketExtensionNone        = 0x00,
+  WebSocketExtensionDeflate     = 0x04  // RSV1, "permessage-deflate"
+};
+
 enum WebSocketState
 {
   WebSocketStateNotConnected    = 0,
@@ -104,11 +111,13 @@ protected:
   bool m_complete;
 };
 
+class CWebSocketDeflate;
+
 class CWebSocket
 {
 public:
-  CWebSocket() { m_state = WebSocketStateNotConnected; m_message = NULL; }
-  virtual ~CWebSocket() { if (m_message) delete m_message; };
+  CWebSocket() { m_state = WebSocketStateNotConnected; m_message = NULL; m_deflate = NULL; }
+  virtual ~CWebSocket();
 
   int GetVersion() { return m_version; }
   WebSocketState GetState() { return m_state; }
@@ -125,8 +134,12 @@ protected:
   int m_version;
   WebSocketState m_state;
   CWebSocketMessage *m_message;
+  CWebSocketDeflate *m_deflate;
 
   virtual CWebSocketFrame* GetFrame(const char* data, uint64_t length) = 0;
   virtual CWebSocketFrame* GetFrame(WebSocketFrameOpcode opcode, const char* data = NULL, uint32_t length = 0, bool final = true, bool masked = false, int32_t mask = 0, int8_t extension = 0) = 0;
   virtual CWebSocketMessage* GetMessage() = 0;
+
+private:
+  CWebSocketMessage* decompress(CWebSocketMessage* message);
 };
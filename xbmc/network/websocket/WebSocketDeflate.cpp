@@ -0,0 +1,188 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "WebSocketDeflate.h"
+
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <cstdlib>
+#include <vector>
+
+#define WS_EXTENSION_DEFLATE          "permessage-deflate"
+#define WS_PARAM_SERVER_NO_TAKEOVER   "server_no_context_takeover"
+#define WS_PARAM_CLIENT_NO_TAKEOVER   "client_no_context_takeover"
+#define WS_PARAM_SERVER_WINDOW_BITS   "server_max_window_bits"
+#define WS_PARAM_CLIENT_WINDOW_BITS   "client_max_window_bits"
+
+// every message compressed with Z_SYNC_FLUSH ends with an empty stored block
+static const char DEFLATE_TRAILER[] = { 0x00, 0x00, (char)0xff, (char)0xff };
+
+#define DEFLATE_CHUNK_SIZE            16384
+// upper limit for decompressed messages to protect against compression bombs
+#define INFLATE_MAX_SIZE              (16 * 1024 * 1024)
+
+CWebSocketDeflate::CWebSocketDeflate(int serverWindowBits /* = MAX_WBITS */)
+  : m_serverWindowBits(serverWindowBits)
+{
+}
+
+CWebSocketDeflate::~CWebSocketDeflate()
+{
+  if (m_deflateInitialized)
+    deflateEnd(&m_deflateStream);
+  if (m_inflateInitialized)
+    inflateEnd(&m_inflateStream);
+}
+
+bool CWebSocketDeflate::Negotiate(const std::string& extensions, int& serverWindowBits)
+{
+  std::vector<std::string> offers = StringUtils::Split(extensions, ",");
+  for (const auto& offer : offers)
+  {
+    std::vector<std::string> params = StringUtils::Split(offer, ";");
+    if (params.empty() || StringUtils::Trim(params[0]) != WS_EXTENSION_DEFLATE)
+      continue;
+
+    bool accepted = true;
+    int windowBits = MAX_WBITS;
+    for (size_t i = 1; i < params.size() && accepted; i++)
+    {
+      std::string name = params[i];
+      std::string value;
+      size_t pos = name.find('=');
+      if (pos != std::string::npos)
+      {
+        value = name.substr(pos + 1);
+        name.erase(pos);
+      }
+      StringUtils::Trim(name);
+      StringUtils::Trim(value, " \t\"");
+
+      if (name == WS_PARAM_SERVER_NO_TAKEOVER || name == WS_PARAM_CLIENT_NO_TAKEOVER ||
+          name == WS_PARAM_CLIENT_WINDOW_BITS)
+        continue;
+
+      if (name == WS_PARAM_SERVER_WINDOW_BITS)
+      {
+        // zlib can't produce raw deflate streams with a window of 256 bytes
+        windowBits = StringUtils::IsInteger(value) ? atoi(value.c_str()) : 0;
+        accepted = windowBits >= 9 && windowBits <= MAX_WBITS;
+        continue;
+      }
+
+      accepted = false;
+    }
+
+    if (accepted)
+    {
+      serverWindowBits = windowBits;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::string CWebSocketDeflate::GetResponseHeader() const
+{
+  std::string header = WS_EXTENSION_DEFLATE "; " WS_PARAM_SERVER_NO_TAKEOVER "; " WS_PARAM_CLIENT_NO_TAKEOVER;
+  if (m_serverWindowBits < MAX_WBITS)
+    header += StringUtils::Format("; {}={}", WS_PARAM_SERVER_WINDOW_BITS, m_serverWindowBits);
+
+  return header;
+}
+
+bool CWebSocketDeflate::Compress(const char* data, size_t length, std::string& output)
+{
+  CSingleLock lock(m_critSection);
+
+  if (!m_deflateInitialized)
+  {
+    if (deflateInit2(&m_deflateStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -m_serverWindowBits, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      CLog::Log(LOGERROR, "WebSocket: failed to initialize deflate stream");
+      return false;
+    }
+    m_deflateInitialized = true;
+  }
+  else
+    deflateReset(&m_deflateStream);
+
+  output.clear();
+  m_deflateStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  m_deflateStream.avail_in = static_cast<uInt>(length);
+
+  char buffer[DEFLATE_CHUNK_SIZE];
+  do
+  {
+    m_deflateStream.next_out = reinterpret_cast<Bytef*>(buffer);
+    m_deflateStream.avail_out = sizeof(buffer);
+    if (deflate(&m_deflateStream, Z_SYNC_FLUSH) == Z_STREAM_ERROR)
+      return false;
+
+    output.append(buffer, sizeof(buffer) - m_deflateStream.avail_out);
+  } while (m_deflateStream.avail_out == 0);
+
+  if (output.size() < sizeof(DEFLATE_TRAILER))
+    return false;
+
+  output.resize(output.size() - sizeof(DEFLATE_TRAILER));
+  return true;
+}
+
+bool CWebSocketDeflate::Decompress(const std::string& data, std::string& output)
+{
+  CSingleLock lock(m_critSection);
+
+  if (!m_inflateInitialized)
+  {
+    if (inflateInit2(&m_inflateStream, -MAX_WBITS) != Z_OK)
+    {
+      CLog::Log(LOGERROR, "WebSocket: failed to initialize inflate stream");
+      return false;
+    }
+    m_inflateInitialized = true;
+  }
+  else
+    inflateReset(&m_inflateStream);
+
+  std::string input = data;
+  input.append(DEFLATE_TRAILER, sizeof(DEFLATE_TRAILER));
+
+  output.clear();
+  m_inflateStream.next_in = reinterpret_cast<Bytef*>(&input[0]);
+  m_inflateStream.avail_in = static_cast<uInt>(input.size());
+
+  char buffer[DEFLATE_CHUNK_SIZE];
+  do
+  {
+    m_inflateStream.next_out = reinterpret_cast<Bytef*>(buffer);
+    m_inflateStream.avail_out = sizeof(buffer);
+    int ret = inflate(&m_inflateStream, Z_SYNC_FLUSH);
+    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+    {
+      CLog::Log(LOGINFO, "WebSocket: failed to decompress message");
+      return false;
+    }
+
+    output.append(buffer, sizeof(buffer) - m_inflateStream.avail_out);
+    if (output.size() > INFLATE_MAX_SIZE)
+    {
+      CLog::Log(LOGINFO, "WebSocket: decompressed message is too large");
+      return false;
+    }
+
+    if (ret == Z_STREAM_END)
+      break;
+  } while (m_inflateStream.avail_out == 0);
+
+  return true;
+}
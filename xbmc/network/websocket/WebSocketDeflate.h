@@ -0,0 +1,58 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <string>
+
+#include <zlib.h>
+
+/*!
+ \brief Compression of websocket messages as described by the
+ "permessage-deflate" extension (RFC 7692).
+
+ Both directions are negotiated without context takeover so every
+ message is compressed and decompressed on its own.
+ */
+class CWebSocketDeflate
+{
+public:
+  explicit CWebSocketDeflate(int serverWindowBits = MAX_WBITS);
+  ~CWebSocketDeflate();
+
+  /*!
+   \brief Checks a "Sec-WebSocket-Extensions" request header for a
+   "permessage-deflate" offer we can accept.
+   \param extensions Value of the "Sec-WebSocket-Extensions" header
+   \param serverWindowBits Window size requested by the client for our messages
+   \return True if one of the offers can be accepted otherwise false
+   */
+  static bool Negotiate(const std::string& extensions, int& serverWindowBits);
+
+  /*!
+   \brief Returns the "Sec-WebSocket-Extensions" response header value
+   */
+  std::string GetResponseHeader() const;
+
+  bool Compress(const char* data, size_t length, std::string& output);
+  bool Decompress(const std::string& data, std::string& output);
+
+private:
+  CWebSocketDeflate(const CWebSocketDeflate&) = delete;
+  CWebSocketDeflate& operator=(const CWebSocketDeflate&) = delete;
+
+  int m_serverWindowBits;
+
+  CCriticalSection m_critSection;
+  z_stream m_deflateStream = {};
+  z_stream m_inflateStream = {};
+  bool m_deflateInitialized = false;
+  bool m_inflateInitialized = false;
+};
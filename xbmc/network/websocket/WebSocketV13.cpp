@@ -9,6 +9,7 @@
 #include "WebSocketV13.h"
 
 #include "WebSocket.h"
+#include "WebSocketDeflate.h"
 #include "utils/HttpParser.h"
 #include "utils/HttpResponse.h"
 #include "utils/StringUtils.h"
@@ -30,6 +31,8 @@
 #define WS_HEADER_ACCEPT        "Sec-WebSocket-Accept"
 #define WS_HEADER_PROTOCOL      "Sec-WebSocket-Protocol"
 #define WS_HEADER_PROTOCOL_LC   "sec-websocket-protocol"    // "Sec-WebSocket-Protocol"
+#define WS_HEADER_EXTENSIONS    "Sec-WebSocket-Extensions"
+#define WS_HEADER_EXTENSIONS_LC "sec-websocket-extensions"  // "Sec-WebSocket-Extensions"
 
 #define WS_PROTOCOL_JSONRPC     "jsonrpc.xbmc.org"
 #define WS_HEADER_UPGRADE_VALUE "websocket"
@@ -126,6 +129,13 @@ bool CWebSocketV13::Handshake(const char* data, size_t length, std::string &resp
     }
   }
 
+  // There might be a "Sec-WebSocket-Extensions" header offering message compression
+  value = header.getValue(WS_HEADER_EXTENSIONS_LC);
+  int windowBits;
+  if (value && strlen(value) > 0 && m_deflate == NULL &&
+      CWebSocketDeflate::Negotiate(value, windowBits))
+    m_deflate = new CWebSocketDeflate(windowBits);
+
   CHttpResponse httpResponse(HTTP::Get, HTTP::SwitchingProtocols, HTTP::Version1_1);
   httpResponse.AddHeader(WS_HEADER_UPGRADE, WS_HEADER_UPGRADE_VALUE);
   httpResponse.AddHeader(WS_HEADER_CONNECTION, WS_HEADER_UPGRADE);
@@ -133,6 +143,8 @@ bool CWebSocketV13::Handshake(const char* data, size_t length, std::string &resp
   httpResponse.AddHeader(WS_HEADER_ACCEPT, responseKey);
   if (!websocketProtocol.empty())
     httpResponse.AddHeader(WS_HEADER_PROTOCOL, websocketProtocol);
+  if (m_deflate != NULL)
+    httpResponse.AddHeader(WS_HEADER_EXTENSIONS, m_deflate->GetResponseHeader());
 
   response = httpResponse.Create();
 
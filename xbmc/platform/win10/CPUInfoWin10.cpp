@@ -60,6 +60,17 @@ CCPUInfoWin10::CCPUInfoWin10()
       m_cpuFeatures |= CPU_FEATURE_SSE4;
     if (CPUInfo[CPUINFO_ECX] & CPUID_00000001_ECX_SSE42)
       m_cpuFeatures |= CPU_FEATURE_SSE42;
+
+    // AVX2 can only be used if the OS saves the AVX registers as well
+    if ((CPUInfo[CPUINFO_ECX] & CPUID_00000001_ECX_OSXSAVE) &&
+        (CPUInfo[CPUINFO_ECX] & CPUID_00000001_ECX_AVX) &&
+        (_xgetbv(0) & XCR0_SSE_AVX_STATE) == XCR0_SSE_AVX_STATE &&
+        MaxStdInfoType >= CPUID_INFOTYPE_STRUCTURED_EXTENDED)
+    {
+      __cpuidex(CPUInfo, CPUID_INFOTYPE_STRUCTURED_EXTENDED, 0);
+      if (CPUInfo[CPUINFO_EBX] & CPUID_00000007_EBX_AVX2)
+        m_cpuFeatures |= CPU_FEATURE_AVX2;
+    }
   }
 
   __cpuid(CPUInfo, 0x80000000);
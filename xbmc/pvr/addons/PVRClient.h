@@ -268,6 +268,15 @@ public:
     return m_addonCapabilities && m_addonCapabilities->bHandlesDemuxing;
   }
 
+  /*!
+   * @brief Check whether the backend serves the streams of several channels at the same time.
+   * @return True if supported, false otherwise.
+   */
+  bool SupportsConcurrentChannelStreams() const
+  {
+    return m_addonCapabilities && m_addonCapabilities->bSupportsConcurrentChannelStreams;
+  }
+
 private:
   void InitRecordingsLifetimeValues();
 
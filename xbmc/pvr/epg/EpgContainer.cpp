@@ -17,14 +17,22 @@
 #include "pvr/epg/EpgContainer.h"
 #include "pvr/epg/EpgDatabase.h"
 #include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgSearchIndex.h"
 #include "pvr/guilib/PVRGUIProgressHandler.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "threads/Thread.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -96,6 +104,28 @@ void CEpgTagStateChange::Deliver()
   epg->UpdateEntry(m_epgtag, m_state);
 }
 
+class CEpgUpdateWorker : private CThread
+{
+public:
+  explicit CEpgUpdateWorker(const std::function<void()>& update)
+    : CThread("EPGUpdateWorker"), m_update(update)
+  {
+  }
+
+  ~CEpgUpdateWorker() override
+  {
+    // wait for the update to finish
+    StopThread(true);
+  }
+
+  void Start() { Create(); }
+
+private:
+  void Process() override { m_update(); }
+
+  const std::function<void()> m_update;
+};
+
 CPVREpgContainer::CPVREpgContainer() :
   CThread("EPGUpdater"),
   m_database(new CPVREpgDatabase),
@@ -282,6 +312,24 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
     // Note: We must lock the db the whole time, otherwise races may occur.
     database->Lock();
 
+    const unsigned int startTime = XbmcThreads::SystemClockMillis();
+    size_t persistedEpgs = 0;
+    size_t insertCount = 0;
+    size_t deleteCount = 0;
+    int64_t writtenRows = 0;
+    int64_t deletedRows = 0;
+
+    const auto commitQueries = [&]() {
+      deleteCount += database->GetDeleteQueriesCount();
+      insertCount += database->GetInsertQueriesCount();
+
+      int64_t rows = 0;
+      database->CommitDeleteQueries(&rows);
+      deletedRows += rows;
+      database->CommitInsertQueries(&rows);
+      writtenRows += rows;
+    };
+
     XbmcThreads::EndTime processTimeslice(iMaxTimeslice);
     for (const auto& epg : changedEpgs)
     {
@@ -291,14 +339,14 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
                     epg->GetChannelData()->ChannelName());
 
         bReturn &= epg->QueuePersistQuery(database);
+        persistedEpgs++;
 
         size_t queryCount = database->GetInsertQueriesCount() + database->GetDeleteQueriesCount();
         if (queryCount > EPG_COMMIT_QUERY_COUNT_LIMIT)
         {
           CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: committing {} queries in loop.",
                       queryCount);
-          database->CommitDeleteQueries();
-          database->CommitInsertQueries();
+          commitQueries();
           CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: committed {} queries in loop.", queryCount);
         }
       }
@@ -307,12 +355,15 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
     }
 
     if (bReturn)
-    {
-      database->CommitDeleteQueries();
-      database->CommitInsertQueries();
-    }
+      commitQueries();
 
     database->Unlock();
+
+    CLog::LogFC(LOGDEBUG, LOGEPG,
+                "EPG Container: Persisted {} of {} changed EPGs in {} ms, {} insert queries wrote "
+                "{} rows, {} delete queries deleted {} rows",
+                persistedEpgs, changedEpgs.size(), XbmcThreads::SystemClockMillis() - startTime,
+                insertCount, writtenRows, deleteCount, deletedRows);
   }
 
   return bReturn;
@@ -539,6 +590,54 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgContainer::GetTags(
   return results;
 }
 
+bool CPVREpgContainer::GetSearchCandidates(
+    const std::string& text, std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const
+{
+  if (text.find_first_not_of(" \t\r\n") == std::string::npos)
+    return false;
+
+  const std::shared_ptr<CPVREpgDatabase> database = GetEpgDatabase();
+  if (!database)
+    return false;
+
+  const std::shared_ptr<CPVREpgSearchIndex> index = database->GetSearchIndex();
+  if (!index)
+    return false;
+
+  const std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates =
+      database->GetEpgTagsByDatabaseIDs(index->Find(text));
+
+  std::map<int, std::shared_ptr<CPVREpg>> epgs;
+  {
+    CSingleLock lock(m_critSection);
+    epgs = m_epgIdToEpgMap;
+  }
+
+  // the index only knows the persisted tags, take all tags of EPGs with unsaved changes
+  std::set<int> changedEpgs;
+  for (const auto& epg : epgs)
+  {
+    if (epg.second->NeedsSave())
+    {
+      changedEpgs.insert(epg.first);
+      const std::vector<std::shared_ptr<CPVREpgInfoTag>> epgTags = epg.second->GetTags();
+      tags.insert(tags.end(), epgTags.cbegin(), epgTags.cend());
+    }
+  }
+
+  for (const auto& tag : candidates)
+  {
+    const auto it = epgs.find(tag->EpgID());
+    if (it == epgs.cend() || changedEpgs.find(tag->EpgID()) != changedEpgs.cend())
+      continue;
+
+    tag->SetChannelData((*it).second->GetChannelData());
+    tags.emplace_back(tag);
+  }
+
+  return true;
+}
+
 void CPVREpgContainer::InsertFromDB(const std::shared_ptr<CPVREpg>& newEpg)
 {
   CSingleLock lock(m_critSection);
@@ -747,38 +846,97 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
   const auto epgsToUpdate = m_epgIdToEpgMap;
   m_critSection.unlock();
 
+  // a slow client must not hold up the others. clients are asked for one channel at a
+  // time, but different clients are asked in parallel.
+  std::map<int, std::vector<std::shared_ptr<CPVREpg>>> clientEpgs;
   for (const auto& epgEntry : epgsToUpdate)
   {
-    if (InterruptUpdate())
-    {
-      bInterrupted = true;
-      break;
-    }
-
     const std::shared_ptr<CPVREpg> epg = epgEntry.second;
-    if (!epg)
-      continue;
+    if (epg)
+      clientEpgs[epg->GetChannelData()->ClientId()].emplace_back(epg);
+  }
 
-    if (bShowProgress && !bOnlyPending)
-      progressHandler->UpdateProgress(epg->GetChannelData()->ChannelName(), ++iCounter,
-                                      epgsToUpdate.size());
-
-    if ((!bOnlyPending || epg->UpdatePending()) &&
-        epg->Update(start,
-                    end,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY),
-                    database,
-                    bOnlyPending))
+  const int iUpdateTime = m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60;
+  const int iPastDays = m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY);
+  const unsigned int iStartTime = XbmcThreads::SystemClockMillis();
+
+  CCriticalSection updateSection;
+  auto nextClient = clientEpgs.cbegin();
+
+  const auto updateClients = [&]() {
+    while (true)
     {
-      iUpdatedTables++;
+      CSingleLock lock(updateSection);
+      if (bInterrupted || nextClient == clientEpgs.cend())
+        return;
+
+      const int iClientId = (*nextClient).first;
+      const std::vector<std::shared_ptr<CPVREpg>>& epgs = (*nextClient).second;
+      ++nextClient;
+      lock.Leave();
+
+      unsigned int iClientTime = 0;
+      unsigned int iMaxTime = 0;
+      size_t iProcessed = 0;
+      for (const auto& epg : epgs)
+      {
+        if (InterruptUpdate())
+        {
+          lock.Enter();
+          bInterrupted = true;
+          lock.Leave();
+          break;
+        }
+
+        if (bShowProgress && !bOnlyPending)
+        {
+          lock.Enter();
+          progressHandler->UpdateProgress(epg->GetChannelData()->ChannelName(), ++iCounter,
+                                          epgsToUpdate.size());
+          lock.Leave();
+        }
+
+        const unsigned int iEpgStartTime = XbmcThreads::SystemClockMillis();
+        const bool bUpdated = (!bOnlyPending || epg->UpdatePending()) &&
+                              epg->Update(start, end, iUpdateTime, iPastDays, database, bOnlyPending);
+        const unsigned int iEpgTime = XbmcThreads::SystemClockMillis() - iEpgStartTime;
+        iClientTime += iEpgTime;
+        iMaxTime = std::max(iMaxTime, iEpgTime);
+        iProcessed++;
+
+        lock.Enter();
+        if (bUpdated)
+          iUpdatedTables++;
+        else if (!epg->IsValid())
+          invalidTables.push_back(epg);
+        lock.Leave();
+      }
+
+      CLog::LogFC(LOGDEBUG, LOGEPG,
+                  "EPG Container: Processed {} of {} EPGs of client {} in {} ms, slowest took {} ms",
+                  iProcessed, epgs.size(), iClientId, iClientTime, iMaxTime);
     }
-    else if (!epg->IsValid())
+  };
+
+  {
+    std::vector<std::unique_ptr<CEpgUpdateWorker>> workers;
+    const size_t iMaxParallelClients =
+        static_cast<size_t>(std::max(advancedSettings->m_iEpgMaxParallelClients, 1));
+    const size_t iWorkers = std::min(clientEpgs.size(), iMaxParallelClients);
+    for (size_t i = 1; i < iWorkers; ++i)
     {
-      invalidTables.push_back(epg);
+      workers.emplace_back(std::make_unique<CEpgUpdateWorker>(updateClients));
+      workers.back()->Start();
     }
+
+    // this thread is the first worker, the destructors of the others wait for them
+    updateClients();
   }
 
+  CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: Updated {} of {} EPGs from {} clients in {} ms",
+              iUpdatedTables, epgsToUpdate.size(), clientEpgs.size(),
+              XbmcThreads::SystemClockMillis() - iStartTime);
+
   if (bShowProgress && !bOnlyPending)
     progressHandler->DestroyProgress();
 
@@ -167,6 +167,15 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTags(const PVREpgSearchData& searchData) const;
 
+    /*!
+     * @brief Get the EPG tags whose titles or plot outlines may contain the given text.
+     * @param text The text to search for, ignoring the case of ASCII characters.
+     * @param tags The tags possibly containing the text, the caller has to check them.
+     * @return False if the search index is not available, true otherwise.
+     */
+    bool GetSearchCandidates(const std::string& text,
+                             std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const;
+
     /*!
      * @brief Notify EPG container that there are pending manual EPG updates
      * @param bHasPendingUpdates The new value
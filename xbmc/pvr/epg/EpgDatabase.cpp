@@ -13,14 +13,18 @@
 #include "pvr/epg/Epg.h"
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/epg/EpgSearchData.h"
+#include "pvr/epg/EpgSearchIndex.h"
+#include "pvr/epg/EpgTimelineIndex.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace dbiplus;
@@ -266,6 +270,7 @@ bool CPVREpgDatabase::DeleteEpg()
   CLog::LogFC(LOGDEBUG, LOGEPG, "Deleting all EPG data from the database");
 
   CSingleLock lock(m_critSection);
+  ResetSearchIndex();
 
   bReturn = DeleteValues("epg") || bReturn;
   bReturn = DeleteValues("epgtags") || bReturn;
@@ -304,6 +309,9 @@ bool CPVREpgDatabase::QueueDeleteTagQuery(const CPVREpgInfoTag& tag)
   Filter filter;
 
   CSingleLock lock(m_critSection);
+  if (m_searchIndex)
+    m_searchIndex->Remove(tag.DatabaseID());
+
   filter.AppendWhere(PrepareSQL("idBroadcast = %u", tag.DatabaseID()));
 
   std::string strQuery;
@@ -453,6 +461,39 @@ CDateTime CPVREpgDatabase::GetMaxEndTime(int iEpgID, const CDateTime& maxEnd)
   return {};
 }
 
+std::shared_ptr<CPVREpgTimelineIndex> CPVREpgDatabase::GetTimelineIndex(int iEpgID)
+{
+  CSingleLock lock(m_critSection);
+
+  // queued changes are not visible yet, an index built now would stay outdated
+  if (GetInsertQueriesCount() > 0 || GetDeleteQueriesCount() > 0)
+    return {};
+
+  const std::string strQuery =
+      PrepareSQL("SELECT iStartTime, iEndTime FROM epgtags WHERE idEpg = %u;", iEpgID);
+  if (ResultQuery(strQuery))
+  {
+    try
+    {
+      std::vector<CPVREpgTimelineIndex::Event> events;
+      events.reserve(m_pDS->num_rows());
+      while (!m_pDS->eof())
+      {
+        events.push_back({static_cast<time_t>(m_pDS->fv(0).get_asInt()),
+                          static_cast<time_t>(m_pDS->fv(1).get_asInt())});
+        m_pDS->next();
+      }
+      m_pDS->close();
+      return std::make_shared<CPVREpgTimelineIndex>(std::move(events));
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Could not load timeline index for EPG ({})", iEpgID);
+    }
+  }
+  return {};
+}
+
 namespace
 {
 
@@ -496,6 +537,9 @@ CDateTime ConvertLocalTimeToUTC(const CDateTime& local)
   return CDateTime(mktime(tms));
 }
 
+// more ids make the query slower than searching all tags
+constexpr size_t MAX_SEARCH_INDEX_IDS = 1000;
+
 class CSearchTermConverter
 {
 public:
@@ -519,6 +563,9 @@ public:
     return result;
   }
 
+  const std::vector<std::string>& GetTerms() const { return m_terms; }
+  bool HasNegation() const { return m_bNegation; }
+
 private:
   void Parse(const std::string& strSearchTerm)
   {
@@ -539,6 +586,7 @@ private:
         GetAndCutNextTerm(strParsedSearchTerm, strDummy);
         strFragment += " NOT ";
         bNextOR = false;
+        m_bNegation = true;
       }
       else if (StringUtils::StartsWith(strParsedSearchTerm, "+") ||
                StringUtils::StartsWithNoCase(strParsedSearchTerm, "and"))
@@ -571,6 +619,7 @@ private:
           strFragment.clear();
 
           strFragment += ") LIKE UPPER('%";
+          m_terms.emplace_back(strTerm);
           StringUtils::Replace(strTerm, "'", "''"); // escape '
           strFragment += strTerm;
           strFragment += "%')) ";
@@ -614,8 +663,23 @@ private:
   }
 
   std::vector<std::string> m_fragments;
+  std::vector<std::string> m_terms;
+  bool m_bNegation = false;
 };
 
+template<typename Iterator>
+std::string JoinValues(Iterator first, Iterator last)
+{
+  std::string result;
+  for (auto it = first; it != last; ++it)
+  {
+    if (!result.empty())
+      result += ',';
+    result += std::to_string(*it);
+  }
+  return result;
+}
+
 } // unnamed namespace
 
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
@@ -673,6 +737,48 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
   {
     const CSearchTermConverter conv(searchData.m_strSearchTerm);
 
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // search index, covers title and plot outline
+    /////////////////////////////////////////////////////////////////////////////////////////////
+
+    // other databases may ignore accents when comparing. without negation each match contains
+    // at least one term, the union of the index results for all terms narrows down the tags.
+    if (m_sqlite && !searchData.m_bSearchInDescription && !conv.HasNegation() &&
+        !conv.GetTerms().empty())
+    {
+      const std::shared_ptr<CPVREpgSearchIndex> index = GetSearchIndex();
+      if (index)
+      {
+        std::vector<int> ids;
+        bool bUseIndex = true;
+        for (const auto& term : conv.GetTerms())
+        {
+          // like wildcards are not supported by the index
+          if (term.find_first_of("%_") != std::string::npos ||
+              term.find_first_not_of(" \t\r\n") == std::string::npos)
+          {
+            bUseIndex = false;
+            break;
+          }
+
+          const std::vector<int> termIds = index->Find(term);
+          ids.insert(ids.end(), termIds.cbegin(), termIds.cend());
+        }
+
+        if (bUseIndex)
+        {
+          if (ids.empty())
+            return {};
+
+          std::sort(ids.begin(), ids.end());
+          ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+          if (ids.size() <= MAX_SEARCH_INDEX_IDS)
+            filter.AppendWhere("idBroadcast IN (" + JoinValues(ids.cbegin(), ids.cend()) + ")");
+        }
+      }
+    }
+
     // title
     std::string strWhere = conv.ToSQL("sTitle");
 
@@ -715,6 +821,162 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
   return {};
 }
 
+std::shared_ptr<CPVREpgSearchIndex> CPVREpgDatabase::GetSearchIndex()
+{
+  CSingleLock lock(m_critSection);
+
+  // queued changes are not visible yet, the index may already contain them
+  if (GetInsertQueriesCount() > 0 || GetDeleteQueriesCount() > 0)
+    return {};
+
+  if (m_searchIndex)
+  {
+    if (!AddNewTagsToSearchIndex())
+      ResetSearchIndex();
+
+    return m_searchIndex;
+  }
+
+  const std::string strQuery = PrepareSQL("SELECT idBroadcast, sTitle, sPlotOutline FROM epgtags;");
+  if (ResultQuery(strQuery))
+  {
+    try
+    {
+      const std::shared_ptr<CPVREpgSearchIndex> index = std::make_shared<CPVREpgSearchIndex>();
+      while (!m_pDS->eof())
+      {
+        const int iDatabaseId = m_pDS->fv(0).get_asInt();
+        index->Add(iDatabaseId, m_pDS->fv(1).get_asString());
+        index->Add(iDatabaseId, m_pDS->fv(2).get_asString());
+        m_pDS->next();
+      }
+      m_pDS->close();
+      m_searchIndex = index;
+      return m_searchIndex;
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Could not load search index");
+    }
+  }
+  return {};
+}
+
+bool CPVREpgDatabase::AddNewTagsToSearchIndex()
+{
+  for (const auto& epg : m_searchIndexNewTags)
+  {
+    const std::vector<unsigned int>& startTimes = epg.second;
+    for (auto it = startTimes.cbegin(); it != startTimes.cend();)
+    {
+      const auto last =
+          startTimes.cend() - it > static_cast<std::ptrdiff_t>(MAX_SEARCH_INDEX_IDS)
+              ? it + MAX_SEARCH_INDEX_IDS
+              : startTimes.cend();
+      const std::string strQuery =
+          PrepareSQL("SELECT idBroadcast, sTitle, sPlotOutline FROM epgtags WHERE idEpg = %u AND "
+                     "iStartTime IN (",
+                     epg.first) +
+          JoinValues(it, last) + ");";
+      it = last;
+
+      if (!ResultQuery(strQuery))
+        return false;
+
+      try
+      {
+        while (!m_pDS->eof())
+        {
+          const int iDatabaseId = m_pDS->fv(0).get_asInt();
+          m_searchIndex->Remove(iDatabaseId);
+          m_searchIndex->Add(iDatabaseId, m_pDS->fv(1).get_asString());
+          m_searchIndex->Add(iDatabaseId, m_pDS->fv(2).get_asString());
+          m_pDS->next();
+        }
+        m_pDS->close();
+      }
+      catch (...)
+      {
+        CLog::LogF(LOGERROR, "Could not add new tags to search index");
+        return false;
+      }
+    }
+  }
+
+  m_searchIndexNewTags.clear();
+  return true;
+}
+
+void CPVREpgDatabase::RemoveFromSearchIndex(const Filter& filter)
+{
+  if (!m_searchIndex)
+    return;
+
+  std::string strQuery;
+  if (BuildSQL("SELECT idBroadcast FROM epgtags ", filter, strQuery) && ResultQuery(strQuery))
+  {
+    try
+    {
+      while (!m_pDS->eof())
+      {
+        m_searchIndex->Remove(m_pDS->fv(0).get_asInt());
+        m_pDS->next();
+      }
+      m_pDS->close();
+      return;
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Could not remove tags from search index");
+    }
+  }
+
+  ResetSearchIndex();
+}
+
+void CPVREpgDatabase::ResetSearchIndex()
+{
+  m_searchIndex.reset();
+  m_searchIndexNewTags.clear();
+}
+
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTagsByDatabaseIDs(
+    const std::vector<int>& ids)
+{
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+
+  CSingleLock lock(m_critSection);
+  for (auto it = ids.cbegin(); it != ids.cend();)
+  {
+    const auto last = ids.cend() - it > static_cast<std::ptrdiff_t>(MAX_SEARCH_INDEX_IDS)
+                          ? it + MAX_SEARCH_INDEX_IDS
+                          : ids.cend();
+    const std::string strQuery =
+        "SELECT * FROM epgtags WHERE idBroadcast IN (" + JoinValues(it, last) + ");";
+    it = last;
+
+    if (ResultQuery(strQuery))
+    {
+      try
+      {
+        while (!m_pDS->eof())
+        {
+          tags.emplace_back(CreateEpgTag(m_pDS));
+          m_pDS->next();
+        }
+        m_pDS->close();
+      }
+      catch (...)
+      {
+        CLog::LogF(LOGERROR, "Could not load tags by database ids");
+        return {};
+      }
+    }
+  }
+
+  return tags;
+}
+
 std::shared_ptr<CPVREpgInfoTag> CPVREpgDatabase::GetEpgTagByUniqueBroadcastID(
     int iEpgID, unsigned int iUniqueBroadcastId)
 {
@@ -952,6 +1214,8 @@ bool CPVREpgDatabase::QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(int iEpgID,
 
   Filter filter;
 
+  // the index keeps the ids of the deleted tags until it gets rebuilt, the search still checks the
+  // texts of the candidates and does not find them anymore
   CSingleLock lock(m_critSection);
   filter.AppendWhere(PrepareSQL("idEpg = %u AND iEndTime >= %u AND iStartTime <= %u", iEpgID,
                                 static_cast<unsigned int>(minEnd),
@@ -1079,7 +1343,12 @@ bool CPVREpgDatabase::DeleteEpgTags(int iEpgId, const CDateTime& maxEndTime)
   CSingleLock lock(m_critSection);
   filter.AppendWhere(
       PrepareSQL("idEpg = %u AND iEndTime < %u", iEpgId, static_cast<unsigned int>(iMaxEndTime)));
-  return DeleteValues("epgtags", filter);
+  RemoveFromSearchIndex(filter);
+  if (DeleteValues("epgtags", filter))
+    return true;
+
+  ResetSearchIndex();
+  return false;
 }
 
 bool CPVREpgDatabase::DeleteEpgTags(int iEpgId)
@@ -1088,7 +1357,12 @@ bool CPVREpgDatabase::DeleteEpgTags(int iEpgId)
 
   CSingleLock lock(m_critSection);
   filter.AppendWhere(PrepareSQL("idEpg = %u", iEpgId));
-  return DeleteValues("epgtags", filter);
+  RemoveFromSearchIndex(filter);
+  if (DeleteValues("epgtags", filter))
+    return true;
+
+  ResetSearchIndex();
+  return false;
 }
 
 bool CPVREpgDatabase::QueueDeleteEpgTags(int iEpgId)
@@ -1097,10 +1371,15 @@ bool CPVREpgDatabase::QueueDeleteEpgTags(int iEpgId)
 
   CSingleLock lock(m_critSection);
   filter.AppendWhere(PrepareSQL("idEpg = %u", iEpgId));
+  RemoveFromSearchIndex(filter);
 
   std::string strQuery;
   BuildSQL(PrepareSQL("DELETE FROM %s ", "epg"), filter, strQuery);
-  return QueueDeleteQuery(strQuery);
+  if (QueueDeleteQuery(strQuery))
+    return true;
+
+  ResetSearchIndex();
+  return false;
 }
 
 bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
@@ -1126,6 +1405,20 @@ bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
   std::string strGenre = (tag.GenreType() == EPG_GENRE_USE_STRING || tag.GenreSubType() == EPG_GENRE_USE_STRING) ? tag.DeTokenize(tag.Genre()) : "";
 
   CSingleLock lock(m_critSection);
+  if (m_searchIndex)
+  {
+    if (iBroadcastId > 0)
+    {
+      m_searchIndex->Remove(iBroadcastId);
+      m_searchIndex->Add(iBroadcastId, tag.Title());
+      m_searchIndex->Add(iBroadcastId, tag.PlotOutline());
+    }
+    else
+    {
+      // the database id of a new tag is known once the query got executed
+      m_searchIndexNewTags[tag.EpgID()].emplace_back(static_cast<unsigned int>(iStartTime));
+    }
+  }
 
   if (iBroadcastId < 0)
   {
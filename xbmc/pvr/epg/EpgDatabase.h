@@ -11,6 +11,7 @@
 #include "dbwrappers/Database.h"
 #include "threads/CriticalSection.h"
 
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -20,6 +21,8 @@ namespace PVR
 {
   class CPVREpg;
   class CPVREpgInfoTag;
+  class CPVREpgSearchIndex;
+  class CPVREpgTimelineIndex;
 
   struct PVREpgSearchData;
 
@@ -139,6 +142,27 @@ namespace PVR
      */
     CDateTime GetMaxEndTime(int iEpgID, const CDateTime& maxEnd);
 
+    /*!
+     * @brief Get the start and end times of all tags of an EPG.
+     * @param iEpgID The ID of the EPG.
+     * @return The index or nullptr on error or if there are uncommitted queries.
+     */
+    std::shared_ptr<CPVREpgTimelineIndex> GetTimelineIndex(int iEpgID);
+
+    /*!
+     * @brief Get the search index over the titles and plot outlines of all tags.
+     * @return The index or nullptr on error or if there are uncommitted queries.
+     */
+    std::shared_ptr<CPVREpgSearchIndex> GetSearchIndex();
+
+    /*!
+     * @brief Get the tags with the given database ids.
+     * @param ids The database ids.
+     * @return The tags.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTagsByDatabaseIDs(
+        const std::vector<int>& ids);
+
     /*!
      * @brief Get all EPG tags matching the given search criteria.
      * @param searchData The search criteria.
@@ -308,6 +332,26 @@ namespace PVR
 
     std::shared_ptr<CPVREpgInfoTag> CreateEpgTag(const std::unique_ptr<dbiplus::Dataset>& pDS);
 
+    /*!
+     * @brief Add the tags persisted without database id since the last call to the search index.
+     * @return True on success, false otherwise.
+     */
+    bool AddNewTagsToSearchIndex();
+
+    /*!
+     * @brief Remove the tags matching the given filter from the search index, before they get
+     * deleted.
+     * @param filter The filter for the epgtags table.
+     */
+    void RemoveFromSearchIndex(const Filter& filter);
+
+    /*!
+     * @brief Drop the search index, it gets rebuilt on next use.
+     */
+    void ResetSearchIndex();
+
     CCriticalSection m_critSection;
+    std::shared_ptr<CPVREpgSearchIndex> m_searchIndex;
+    std::map<int, std::vector<unsigned int>> m_searchIndexNewTags; // start times of new tags per EPG
   };
 }
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgSearchIndex.h"
+
+#include "threads/SingleLock.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+using namespace PVR;
+
+namespace
+{
+
+bool IsSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+std::vector<std::string> SplitWords(const std::string& text)
+{
+  std::vector<std::string> words;
+  std::string word;
+  for (const char c : text)
+  {
+    if (IsSpace(c))
+    {
+      if (!word.empty())
+        words.emplace_back(std::move(word));
+      word.clear();
+    }
+    else
+    {
+      // only ascii, same as the case insensitive matching of sqlite and the timer rules
+      word += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+  }
+
+  if (!word.empty())
+    words.emplace_back(std::move(word));
+
+  return words;
+}
+
+constexpr size_t MAX_REMOVED_TAGS = 1024;
+
+void SortUnique(std::vector<int>& ids)
+{
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+} // unnamed namespace
+
+void CPVREpgSearchIndex::Add(int iDatabaseId, const std::string& text)
+{
+  CSingleLock lock(m_critSection);
+
+  if (m_removedTags.find(iDatabaseId) != m_removedTags.end())
+  {
+    std::vector<std::string>& readded = m_readdedTags[iDatabaseId];
+    for (auto& word : SplitWords(text))
+      readded.emplace_back(std::move(word));
+  }
+  else
+  {
+    AddWords(iDatabaseId, SplitWords(text));
+  }
+}
+
+void CPVREpgSearchIndex::Remove(int iDatabaseId)
+{
+  CSingleLock lock(m_critSection);
+
+  m_readdedTags.erase(iDatabaseId);
+  m_removedTags.insert(iDatabaseId);
+
+  // every drop walks all words, batch the removals of an update cycle
+  if (m_removedTags.size() >= MAX_REMOVED_TAGS)
+    DropRemovedTags();
+}
+
+std::vector<int> CPVREpgSearchIndex::Find(const std::string& text)
+{
+  std::vector<int> result;
+  bool bFirst = true;
+
+  CSingleLock lock(m_critSection);
+  DropRemovedTags();
+
+  // every word of a text contained in a string is contained in one of the words of that string
+  for (const auto& part : SplitWords(text))
+  {
+    std::vector<int> ids;
+    for (const auto& word : m_words)
+    {
+      if (word.first.find(part) != std::string::npos)
+        ids.insert(ids.end(), word.second.cbegin(), word.second.cend());
+    }
+    SortUnique(ids);
+
+    if (bFirst)
+    {
+      result = std::move(ids);
+      bFirst = false;
+    }
+    else
+    {
+      std::vector<int> intersection;
+      std::set_intersection(result.cbegin(), result.cend(), ids.cbegin(), ids.cend(),
+                            std::back_inserter(intersection));
+      result = std::move(intersection);
+    }
+
+    if (result.empty())
+      break;
+  }
+
+  return result;
+}
+
+void CPVREpgSearchIndex::AddWords(int iDatabaseId, std::vector<std::string> words)
+{
+  for (auto& word : words)
+  {
+    // tags are mostly added in ascending order when the index is built
+    std::vector<int>& ids = m_words[std::move(word)];
+    const auto it = std::lower_bound(ids.begin(), ids.end(), iDatabaseId);
+    if (it == ids.end() || *it != iDatabaseId)
+      ids.insert(it, iDatabaseId);
+  }
+}
+
+void CPVREpgSearchIndex::DropRemovedTags()
+{
+  if (m_removedTags.empty())
+    return;
+
+  for (auto it = m_words.begin(); it != m_words.end();)
+  {
+    std::vector<int>& ids = (*it).second;
+    ids.erase(std::remove_if(ids.begin(), ids.end(),
+                             [this](int id) { return m_removedTags.count(id) > 0; }),
+              ids.end());
+
+    if (ids.empty())
+      it = m_words.erase(it);
+    else
+      ++it;
+  }
+  m_removedTags.clear();
+
+  for (auto& tag : m_readdedTags)
+    AddWords(tag.first, std::move(tag.second));
+  m_readdedTags.clear();
+}
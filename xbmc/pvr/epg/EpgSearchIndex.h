@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace PVR
+{
+/*!
+ * @brief Inverted index of the words in the titles and plot outlines of the persisted EPG tags.
+ *
+ * Words are split at white space and compared ignoring the case of ASCII characters. A text
+ * without white space is contained in a string only if it is contained in one of its words,
+ * hence the index can narrow down the tags to check for substring and plain text matches.
+ *
+ * The index can be updated while it is used for lookups. It does not keep the words of each tag,
+ * removed tags are dropped from all words at once, before the next lookup or once enough tags
+ * were removed.
+ */
+class CPVREpgSearchIndex
+{
+public:
+  /*!
+   * @brief Add the words of a text of a tag.
+   * @param iDatabaseId The database id of the tag.
+   * @param text The text.
+   */
+  void Add(int iDatabaseId, const std::string& text);
+
+  /*!
+   * @brief Remove all words of a tag.
+   * @param iDatabaseId The database id of the tag.
+   */
+  void Remove(int iDatabaseId);
+
+  /*!
+   * @brief Get the tags with texts that may contain the given text.
+   * @param text The text, must contain at least one character other than white space.
+   * @return The database ids of the tags, sorted ascending. Tags not containing the text may be
+   * included, tags containing it are never missing.
+   */
+  std::vector<int> Find(const std::string& text);
+
+private:
+  void AddWords(int iDatabaseId, std::vector<std::string> words);
+  void DropRemovedTags();
+
+  CCriticalSection m_critSection;
+
+  // the sorted database ids of the tags using each word
+  std::unordered_map<std::string, std::vector<int>> m_words;
+
+  // tags which are still listed in m_words
+  std::unordered_set<int> m_removedTags;
+
+  // words of removed tags which were added again, they are added once the old words are dropped
+  std::unordered_map<int, std::vector<std::string>> m_readdedTags;
+};
+
+} // namespace PVR
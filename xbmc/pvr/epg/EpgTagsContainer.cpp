@@ -12,6 +12,7 @@
 #include "pvr/epg/EpgDatabase.h"
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/epg/EpgTagsCache.h"
+#include "pvr/epg/EpgTimelineIndex.h"
 #include "utils/log.h"
 
 using namespace PVR;
@@ -36,6 +37,7 @@ CPVREpgTagsContainer::~CPVREpgTagsContainer() = default;
 void CPVREpgTagsContainer::SetEpgID(int iEpgID)
 {
   m_iEpgID = iEpgID;
+  m_timelineIndex.reset();
   for (const auto& tag : m_changedTags)
     tag.second->SetEpgID(iEpgID);
 }
@@ -195,7 +197,10 @@ bool CPVREpgTagsContainer::UpdateEntries(const CPVREpgTagsContainer& tags)
     }
 
     if (bResetCache)
+    {
       m_tagsCache->Reset();
+      m_timelineIndex.reset();
+    }
   }
   else
   {
@@ -279,6 +284,7 @@ bool CPVREpgTagsContainer::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& ta
       // tag differs from existing tag and must be persisted
       m_changedTags.insert({existingTag->StartAsUTC(), existingTag});
       m_tagsCache->Reset();
+      m_timelineIndex.reset();
     }
   }
   else
@@ -286,6 +292,7 @@ bool CPVREpgTagsContainer::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& ta
     // new tags must always be persisted
     m_changedTags.insert({tag->StartAsUTC(), tag});
     m_tagsCache->Reset();
+    m_timelineIndex.reset();
   }
 
   return true;
@@ -296,6 +303,7 @@ bool CPVREpgTagsContainer::DeleteEntry(const std::shared_ptr<CPVREpgInfoTag>& ta
   m_changedTags.erase(tag->StartAsUTC());
   m_deletedTags.insert({tag->StartAsUTC(), tag});
   m_tagsCache->Reset();
+  m_timelineIndex.reset();
   return true;
 }
 
@@ -321,11 +329,14 @@ void CPVREpgTagsContainer::Cleanup(const CDateTime& time)
 
   if (m_database)
     m_database->DeleteEpgTags(m_iEpgID, time);
+
+  m_timelineIndex.reset();
 }
 
 void CPVREpgTagsContainer::Clear()
 {
   m_changedTags.clear();
+  m_timelineIndex.reset();
 }
 
 bool CPVREpgTagsContainer::IsEmpty() const
@@ -436,6 +447,18 @@ std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsContainer::CreateGapTag(const CDateTi
   return std::make_shared<CPVREpgInfoTag>(m_channelData, m_iEpgID, start, end, true);
 }
 
+std::shared_ptr<CPVREpgTimelineIndex> CPVREpgTagsContainer::GetTimelineIndex() const
+{
+  // the index only knows the persisted events
+  if (!m_database || !m_changedTags.empty())
+    return {};
+
+  if (!m_timelineIndex)
+    m_timelineIndex = m_database->GetTimelineIndex(m_iEpgID);
+
+  return m_timelineIndex;
+}
+
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
     const CDateTime& timelineStart,
     const CDateTime& timelineEnd,
@@ -444,6 +467,15 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
 {
   if (m_database)
   {
+    const std::shared_ptr<CPVREpgTimelineIndex> index = GetTimelineIndex();
+    const auto getMaxEndTime = [this, &index](const CDateTime& maxEnd) {
+      return index ? index->GetMaxEndTime(maxEnd) : m_database->GetMaxEndTime(m_iEpgID, maxEnd);
+    };
+    const auto getMinStartTime = [this, &index](const CDateTime& minStart) {
+      return index ? index->GetMinStartTime(minStart)
+                   : m_database->GetMinStartTime(m_iEpgID, minStart);
+    };
+
     std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
 
     if (!m_changedTags.empty() && !m_database->GetFirstStartTime(m_iEpgID).IsValid())
@@ -460,7 +492,9 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
     }
     else
     {
-      tags = m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
+      // only query the tags if the index does not tell that there are none
+      if (!index || index->HasEvents(minEventEnd, maxEventStart))
+        tags = m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
 
       if (!m_changedTags.empty())
       {
@@ -501,11 +535,11 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
     if (result.empty())
     {
       // create single gap tag
-      CDateTime maxEnd = m_database->GetMaxEndTime(m_iEpgID, minEventEnd);
+      CDateTime maxEnd = getMaxEndTime(minEventEnd);
       if (!maxEnd.IsValid() || maxEnd < timelineStart)
         maxEnd = timelineStart;
 
-      CDateTime minStart = m_database->GetMinStartTime(m_iEpgID, maxEventStart);
+      CDateTime minStart = getMinStartTime(maxEventStart);
       if (!minStart.IsValid() || minStart > timelineEnd)
         minStart = timelineEnd;
 
@@ -516,7 +550,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
       if (result.front()->StartAsUTC() > minEventEnd)
       {
         // prepend gap tag
-        CDateTime maxEnd = m_database->GetMaxEndTime(m_iEpgID, minEventEnd);
+        CDateTime maxEnd = getMaxEndTime(minEventEnd);
         if (!maxEnd.IsValid() || maxEnd < timelineStart)
           maxEnd = timelineStart;
 
@@ -526,7 +560,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
       if (result.back()->EndAsUTC() < maxEventStart)
       {
         // append gap tag
-        CDateTime minStart = m_database->GetMinStartTime(m_iEpgID, maxEventStart);
+        CDateTime minStart = getMinStartTime(maxEventStart);
         if (!minStart.IsValid() || minStart > timelineEnd)
           minStart = timelineEnd;
 
@@ -628,16 +662,35 @@ void CPVREpgTagsContainer::QueuePersistQuery()
 
     FixOverlappingEvents(m_changedTags);
 
+    // remove any conflicting events from database before persisting the new events. clients
+    // mostly deliver seamless events, one query covers a whole run of them.
+    CDateTime runStart;
+    CDateTime runEnd;
     for (const auto& tag : m_changedTags)
     {
-      // remove any conflicting events from database before persisting the new event
-      m_database->QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(
-          m_iEpgID, tag.second->StartAsUTC() + ONE_SECOND, tag.second->EndAsUTC() - ONE_SECOND);
+      if (runEnd.IsValid() && tag.second->StartAsUTC() == runEnd)
+      {
+        runEnd = tag.second->EndAsUTC();
+      }
+      else
+      {
+        if (runStart.IsValid())
+          m_database->QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(m_iEpgID, runStart + ONE_SECOND,
+                                                                  runEnd - ONE_SECOND);
+
+        runStart = tag.second->StartAsUTC();
+        runEnd = tag.second->EndAsUTC();
+      }
 
       tag.second->QueuePersistQuery(m_database);
     }
 
+    if (runStart.IsValid())
+      m_database->QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(m_iEpgID, runStart + ONE_SECOND,
+                                                              runEnd - ONE_SECOND);
+
     m_changedTags.clear();
+    m_timelineIndex.reset();
 
     m_database->Unlock();
   }
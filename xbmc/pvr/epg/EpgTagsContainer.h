@@ -20,6 +20,7 @@ class CPVREpgTagsCache;
 class CPVREpgChannelData;
 class CPVREpgDatabase;
 class CPVREpgInfoTag;
+class CPVREpgTimelineIndex;
 
 class CPVREpgTagsContainer
 {
@@ -206,6 +207,12 @@ private:
   void FixOverlappingEvents(std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const;
   void FixOverlappingEvents(std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>>& tags) const;
 
+  /*!
+   * @brief Get the index of the persisted events, loading it if needed.
+   * @return The index or nullptr if there are unsaved changes or it could not be loaded.
+   */
+  std::shared_ptr<CPVREpgTimelineIndex> GetTimelineIndex() const;
+
   int m_iEpgID = 0;
   std::shared_ptr<CPVREpgChannelData> m_channelData;
   const std::shared_ptr<CPVREpgDatabase> m_database;
@@ -213,6 +220,7 @@ private:
 
   std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> m_changedTags;
   std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> m_deletedTags;
+  mutable std::shared_ptr<CPVREpgTimelineIndex> m_timelineIndex;
 };
 
 } // namespace PVR
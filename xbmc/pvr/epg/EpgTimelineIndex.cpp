@@ -0,0 +1,107 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgTimelineIndex.h"
+
+#include <algorithm>
+
+using namespace PVR;
+
+namespace
+{
+constexpr time_t BUCKET_SIZE = 60 * 60;
+
+time_t ToTime(const CDateTime& dateTime)
+{
+  time_t time = 0;
+  dateTime.GetAsTime(time);
+  return time;
+}
+
+} // unnamed namespace
+
+CPVREpgTimelineIndex::CPVREpgTimelineIndex(std::vector<Event> events)
+{
+  std::sort(events.begin(), events.end(),
+            [](const Event& a, const Event& b) { return a.start < b.start; });
+
+  m_starts.reserve(events.size());
+  m_ends.reserve(events.size());
+  for (const auto& event : events)
+  {
+    m_starts.emplace_back(event.start);
+    m_ends.emplace_back(event.end);
+  }
+
+  m_sortedEnds = m_ends;
+  std::sort(m_sortedEnds.begin(), m_sortedEnds.end());
+
+  if (m_starts.empty())
+    return;
+
+  const time_t first = m_starts.front();
+  const time_t last = std::max(m_sortedEnds.back(), m_starts.back());
+  m_buckets.resize(static_cast<size_t>((last - first) / BUCKET_SIZE) + 1);
+
+  // events may overlap, so the end times are not sorted. all events before the
+  // one stored for a bucket end before the bucket starts.
+  size_t i = 0;
+  time_t maxEnd = m_ends.front();
+  for (size_t bucket = 0; bucket < m_buckets.size(); ++bucket)
+  {
+    const time_t bucketStart = first + static_cast<time_t>(bucket) * BUCKET_SIZE;
+    while (i < m_ends.size() && maxEnd < bucketStart)
+    {
+      ++i;
+      if (i < m_ends.size())
+        maxEnd = std::max(maxEnd, m_ends[i]);
+    }
+    m_buckets[bucket] = i;
+  }
+}
+
+size_t CPVREpgTimelineIndex::GetBucket(time_t time) const
+{
+  const size_t bucket = static_cast<size_t>((time - m_starts.front()) / BUCKET_SIZE);
+  return std::min(bucket, m_buckets.size() - 1);
+}
+
+bool CPVREpgTimelineIndex::HasEvents(const CDateTime& minEnd, const CDateTime& maxStart) const
+{
+  if (m_starts.empty())
+    return false;
+
+  const time_t minEndTime = ToTime(minEnd);
+  const time_t maxStartTime = ToTime(maxStart);
+
+  size_t i = minEndTime < m_starts.front() ? 0 : m_buckets[GetBucket(minEndTime)];
+  for (; i < m_starts.size() && m_starts[i] <= maxStartTime; ++i)
+  {
+    if (m_ends[i] >= minEndTime)
+      return true;
+  }
+  return false;
+}
+
+CDateTime CPVREpgTimelineIndex::GetMinStartTime(const CDateTime& minStart) const
+{
+  const auto it = std::upper_bound(m_starts.cbegin(), m_starts.cend(), ToTime(minStart));
+  if (it == m_starts.cend())
+    return {};
+
+  return CDateTime(*it);
+}
+
+CDateTime CPVREpgTimelineIndex::GetMaxEndTime(const CDateTime& maxEnd) const
+{
+  const auto it = std::upper_bound(m_sortedEnds.cbegin(), m_sortedEnds.cend(), ToTime(maxEnd));
+  if (it == m_sortedEnds.cbegin())
+    return {};
+
+  return CDateTime(*(it - 1));
+}
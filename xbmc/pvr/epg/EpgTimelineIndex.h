@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "XBDateTime.h"
+
+#include <ctime>
+#include <vector>
+
+namespace PVR
+{
+/*!
+ * @brief Start and end times of all persisted events of an EPG.
+ *
+ * The times are kept in plain arrays, bucketed by hour, so that the guide can
+ * find out which parts of a time line contain events without asking the
+ * database. Full tags are only loaded for time windows that contain events.
+ */
+class CPVREpgTimelineIndex
+{
+public:
+  struct Event
+  {
+    time_t start;
+    time_t end;
+  };
+
+  /*!
+   * @brief Create the index.
+   * @param events The events, in any order.
+   */
+  explicit CPVREpgTimelineIndex(std::vector<Event> events);
+
+  /*!
+   * @brief Check whether the index contains no events.
+   * @return True if there are no events, false otherwise.
+   */
+  bool IsEmpty() const { return m_starts.empty(); }
+
+  /*!
+   * @brief Check whether there are events ending at or after minEnd and starting at or before maxStart.
+   * @param minEnd The minimum end time.
+   * @param maxStart The maximum start time.
+   * @return True if there is at least one such event, false otherwise.
+   */
+  bool HasEvents(const CDateTime& minEnd, const CDateTime& maxStart) const;
+
+  /*!
+   * @brief Get the start time of the first event starting after the given time.
+   * @param minStart The time.
+   * @return The start time, invalid if there is no such event.
+   */
+  CDateTime GetMinStartTime(const CDateTime& minStart) const;
+
+  /*!
+   * @brief Get the end time of the last event ending at or before the given time.
+   * @param maxEnd The time.
+   * @return The end time, invalid if there is no such event.
+   */
+  CDateTime GetMaxEndTime(const CDateTime& maxEnd) const;
+
+private:
+  size_t GetBucket(time_t time) const;
+
+  // sorted by start time
+  std::vector<time_t> m_starts;
+  std::vector<time_t> m_ends;
+
+  // all end times in ascending order
+  std::vector<time_t> m_sortedEnds;
+
+  // per hour since the first start, the first event that may end in or after that hour
+  std::vector<size_t> m_buckets;
+};
+
+} // namespace PVR
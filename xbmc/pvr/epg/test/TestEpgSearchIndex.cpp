@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/epg/EpgSearchIndex.h"
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+
+void FillIndex(CPVREpgSearchIndex& index)
+{
+  index.Add(3, "The Big Match");
+  index.Add(3, "Live football from the stadium");
+  index.Add(1, "Matchday Highlights");
+  index.Add(2, "Nature Documentary");
+  index.Add(2, "Life in the deep sea");
+}
+
+} // unnamed namespace
+
+TEST(TestEpgSearchIndex, Find_Word)
+{
+  CPVREpgSearchIndex index;
+  FillIndex(index);
+
+  EXPECT_EQ(index.Find("nature"), std::vector<int>({2}));
+  EXPECT_EQ(index.Find("unknown"), std::vector<int>());
+}
+
+TEST(TestEpgSearchIndex, Find_IgnoresCase)
+{
+  CPVREpgSearchIndex index;
+  FillIndex(index);
+
+  EXPECT_EQ(index.Find("MATCH"), std::vector<int>({1, 3}));
+  EXPECT_EQ(index.Find("HighLights"), std::vector<int>({1}));
+}
+
+TEST(TestEpgSearchIndex, Find_Substring)
+{
+  CPVREpgSearchIndex index;
+  FillIndex(index);
+
+  EXPECT_EQ(index.Find("atch"), std::vector<int>({1, 3}));
+  EXPECT_EQ(index.Find("the"), std::vector<int>({2, 3}));
+}
+
+TEST(TestEpgSearchIndex, Find_Phrase)
+{
+  CPVREpgSearchIndex index;
+  FillIndex(index);
+
+  EXPECT_EQ(index.Find("big match"), std::vector<int>({3}));
+  EXPECT_EQ(index.Find("g matc"), std::vector<int>({1, 3}));
+  EXPECT_EQ(index.Find("deep football"), std::vector<int>());
+}
+
+TEST(TestEpgSearchIndex, Remove)
+{
+  CPVREpgSearchIndex index;
+  FillIndex(index);
+
+  index.Remove(3);
+  EXPECT_EQ(index.Find("match"), std::vector<int>({1}));
+  EXPECT_EQ(index.Find("football"), std::vector<int>());
+
+  index.Remove(4);
+  EXPECT_EQ(index.Find("the"), std::vector<int>({2}));
+}
+
+TEST(TestEpgSearchIndex, Update)
+{
+  CPVREpgSearchIndex index;
+  FillIndex(index);
+
+  index.Remove(2);
+  index.Add(2, "Deep Sea Match");
+  EXPECT_EQ(index.Find("match"), std::vector<int>({1, 2, 3}));
+  EXPECT_EQ(index.Find("nature"), std::vector<int>());
+
+  index.Add(0, "Match of the Day");
+  EXPECT_EQ(index.Find("match"), std::vector<int>({0, 1, 2, 3}));
+}
+
+TEST(TestEpgSearchIndex, Update_RemovedAgain)
+{
+  CPVREpgSearchIndex index;
+  FillIndex(index);
+
+  index.Remove(2);
+  index.Add(2, "Deep Sea Match");
+  index.Remove(2);
+  EXPECT_EQ(index.Find("match"), std::vector<int>({1, 3}));
+  EXPECT_EQ(index.Find("sea"), std::vector<int>());
+}
+
+TEST(TestEpgSearchIndex, Remove_Many)
+{
+  CPVREpgSearchIndex index;
+  for (int i = 0; i < 5000; i++)
+    index.Add(i, i % 2 ? "Odd Show" : "Even Show");
+
+  std::vector<int> expected;
+  for (int i = 0; i < 5000; i++)
+  {
+    if (i % 5 == 0)
+      expected.emplace_back(i);
+    else
+      index.Remove(i);
+  }
+  index.Add(3, "Odd Show");
+
+  EXPECT_EQ(index.Find("odd").size(), 501u);
+  expected.insert(expected.begin() + 1, 3);
+  EXPECT_EQ(index.Find("show"), expected);
+}
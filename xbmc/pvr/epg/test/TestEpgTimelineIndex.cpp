@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/epg/EpgTimelineIndex.h"
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+constexpr time_t BASE = 1600000000;
+constexpr time_t HOUR = 60 * 60;
+
+CDateTime Time(time_t offset)
+{
+  return CDateTime(BASE + offset);
+}
+
+} // unnamed namespace
+
+TEST(TestEpgTimelineIndex, Empty)
+{
+  const CPVREpgTimelineIndex index({});
+
+  EXPECT_TRUE(index.IsEmpty());
+  EXPECT_FALSE(index.HasEvents(Time(0), Time(HOUR)));
+  EXPECT_FALSE(index.GetMinStartTime(Time(0)).IsValid());
+  EXPECT_FALSE(index.GetMaxEndTime(Time(0)).IsValid());
+}
+
+TEST(TestEpgTimelineIndex, HasEvents)
+{
+  // a gap between the second and the third event
+  const CPVREpgTimelineIndex index(
+      {{BASE + 3 * HOUR, BASE + 4 * HOUR}, {BASE, BASE + HOUR}, {BASE + HOUR, BASE + 2 * HOUR}});
+
+  EXPECT_FALSE(index.IsEmpty());
+  EXPECT_TRUE(index.HasEvents(Time(-HOUR), Time(0)));
+  EXPECT_FALSE(index.HasEvents(Time(-2 * HOUR), Time(-1)));
+  EXPECT_TRUE(index.HasEvents(Time(2 * HOUR), Time(3 * HOUR)));
+  EXPECT_FALSE(index.HasEvents(Time(2 * HOUR + 1), Time(3 * HOUR - 1)));
+  EXPECT_TRUE(index.HasEvents(Time(4 * HOUR), Time(10 * HOUR)));
+  EXPECT_FALSE(index.HasEvents(Time(4 * HOUR + 1), Time(10 * HOUR)));
+}
+
+TEST(TestEpgTimelineIndex, HasEvents_Overlapping)
+{
+  // a long event spans the gap between the short ones
+  const CPVREpgTimelineIndex index({{BASE, BASE + 10 * HOUR},
+                                    {BASE + HOUR, BASE + 2 * HOUR},
+                                    {BASE + 8 * HOUR, BASE + 9 * HOUR}});
+
+  EXPECT_TRUE(index.HasEvents(Time(5 * HOUR), Time(6 * HOUR)));
+  EXPECT_TRUE(index.HasEvents(Time(9 * HOUR + 1), Time(12 * HOUR)));
+  EXPECT_FALSE(index.HasEvents(Time(10 * HOUR + 1), Time(12 * HOUR)));
+}
+
+TEST(TestEpgTimelineIndex, GapTimes)
+{
+  const CPVREpgTimelineIndex index(
+      {{BASE, BASE + HOUR}, {BASE + HOUR, BASE + 2 * HOUR}, {BASE + 3 * HOUR, BASE + 4 * HOUR}});
+
+  EXPECT_EQ(index.GetMaxEndTime(Time(2 * HOUR + 1)), Time(2 * HOUR));
+  EXPECT_EQ(index.GetMaxEndTime(Time(2 * HOUR)), Time(2 * HOUR));
+  EXPECT_FALSE(index.GetMaxEndTime(Time(HOUR - 1)).IsValid());
+
+  EXPECT_EQ(index.GetMinStartTime(Time(2 * HOUR)), Time(3 * HOUR));
+  EXPECT_EQ(index.GetMinStartTime(Time(HOUR - 1)), Time(HOUR));
+  EXPECT_FALSE(index.GetMinStartTime(Time(3 * HOUR)).IsValid());
+}
@@ -1231,7 +1231,8 @@ namespace PVR
         // fileitem instead and pass the epg tags props so we use those and skip the client call
         if (epgProps)
           props = *epgProps;
-        else
+        else if (!m_channelNavigator.GetPreOpenedStreamProperties(item->GetPVRChannelInfoTag(),
+                                                                  props))
           client->GetChannelStreamProperties(item->GetPVRChannelInfoTag(), props);
       }
       else if (item->IsPVRRecording())
@@ -1246,28 +1247,33 @@ namespace PVR
           client->GetEpgTagStreamProperties(item->GetEPGInfoTag(), props);
       }
 
-      if (props.size())
-      {
-        const std::string url = props.GetStreamURL();
-        if (!url.empty())
-          item->SetDynPath(url);
-
-        const std::string mime = props.GetStreamMimeType();
-        if (!mime.empty())
-        {
-          item->SetMimeType(mime);
-          item->SetContentLookup(false);
-        }
-
-        for (const auto& prop : props)
-          item->SetProperty(prop.first, prop.second);
-      }
+      ApplyStreamProperties(*item, props);
     }
 
     CApplicationMessenger::GetInstance().PostMsg(TMSG_MEDIA_PLAY, 0, 0, static_cast<void*>(item));
     CheckAndSwitchToFullscreen(bFullscreen);
   }
 
+  void CPVRGUIActions::ApplyStreamProperties(CFileItem& item, const CPVRStreamProperties& props)
+  {
+    if (props.size())
+    {
+      const std::string url = props.GetStreamURL();
+      if (!url.empty())
+        item.SetDynPath(url);
+
+      const std::string mime = props.GetStreamMimeType();
+      if (!mime.empty())
+      {
+        item.SetMimeType(mime);
+        item.SetContentLookup(false);
+      }
+
+      for (const auto& prop : props)
+        item.SetProperty(prop.first, prop.second);
+    }
+  }
+
   bool CPVRGUIActions::PlayRecording(const CFileItemPtr& item, bool bCheckResume) const
   {
     const std::shared_ptr<CPVRRecording> recording(CPVRItem(item).GetRecording());
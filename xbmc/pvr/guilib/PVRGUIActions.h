@@ -422,6 +422,13 @@ namespace PVR
      */
     void OnPlaybackStopped(const std::shared_ptr<CFileItem>& item);
 
+    /*!
+     * @brief Apply the stream url, mime type and properties obtained from a client to an item to play.
+     * @param item The item.
+     * @param props The stream properties.
+     */
+    static void ApplyStreamProperties(CFileItem& item, const CPVRStreamProperties& props);
+
   private:
     CPVRGUIActions(const CPVRGUIActions&) = delete;
     CPVRGUIActions const& operator=(CPVRGUIActions const&) = delete;
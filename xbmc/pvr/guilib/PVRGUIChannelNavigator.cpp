@@ -11,17 +11,24 @@
 #include "FileItem.h"
 #include "GUIInfoManager.h"
 #include "ServiceBroker.h"
+#include "cores/VideoPlayer/DVDInputStreams/InputStreamPreOpener.h"
 #include "guilib/GUIComponent.h"
 #include "pvr/PVRManager.h"
 #include "pvr/PVRPlaybackState.h"
+#include "pvr/addons/PVRClient.h"
+#include "pvr/channels/PVRChannel.h"
 #include "pvr/channels/PVRChannelGroup.h"
 #include "pvr/guilib/PVRGUIActions.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/Job.h"
 #include "utils/JobManager.h"
 #include "utils/XTimeUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
 
 namespace
 {
@@ -38,6 +45,7 @@ public:
   ~CPVRChannelTimeoutJobBase() override = default;
 
   virtual void OnTimeout() = 0;
+  virtual void OnWait() {}
 
   void OnJobComplete(unsigned int iJobID, bool bSuccess, CJob* job) override {}
 
@@ -50,6 +58,7 @@ public:
         OnTimeout();
         return true;
       }
+      OnWait();
       KODI::TIME::Sleep(10);
     }
     return false;
@@ -81,6 +90,43 @@ public:
   const char* GetType() const override { return "pvr-channel-info-timeout-job"; }
   void OnTimeout() override { m_channelNavigator.HideInfo(); }
 };
+
+class CPVRChannelPreOpenJob : public CPVRChannelTimeoutJobBase
+{
+public:
+  CPVRChannelPreOpenJob(PVR::CPVRGUIChannelNavigator& channelNavigator,
+                        const std::shared_ptr<PVR::CPVRChannel>& channel,
+                        int iTimeout)
+  : CPVRChannelTimeoutJobBase(channelNavigator, iTimeout), m_channel(channel) {}
+  ~CPVRChannelPreOpenJob() override = default;
+  const char* GetType() const override { return "pvr-channel-pre-open-job"; }
+
+  bool DoWork() override
+  {
+    // keep the streams open until timeout, then free the connections
+    m_channelNavigator.PreOpenChannels(m_channel);
+    m_drainTimer.Set(DRAIN_INTERVAL);
+    return CPVRChannelTimeoutJobBase::DoWork();
+  }
+
+  void OnTimeout() override { m_channelNavigator.ClearPreOpenedChannels(); }
+
+  void OnWait() override
+  {
+    // drop old data before the caches fill up and stop reading from the source
+    if (m_drainTimer.IsTimePast())
+    {
+      CInputStreamPreOpener::GetInstance().Drain();
+      m_drainTimer.Set(DRAIN_INTERVAL);
+    }
+  }
+
+private:
+  static constexpr int DRAIN_INTERVAL = 1000; // ms
+
+  const std::shared_ptr<PVR::CPVRChannel> m_channel;
+  XbmcThreads::EndTime m_drainTimer;
+};
 } // unnamed namespace
 
 namespace PVR
@@ -263,6 +309,7 @@ namespace PVR
       CSingleLock lock(m_critSection);
 
       m_playingChannel = channel;
+      m_preOpenedChannels.clear();
       if (m_currentChannel != m_playingChannel)
       {
         m_currentChannel = m_playingChannel;
@@ -275,13 +322,111 @@ namespace PVR
       CServiceBroker::GetGUI()->GetInfoManager().SetCurrentItem(*item);
 
     ShowInfo(false);
+
+    const int iPreOpenTimeout = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRPreOpenChannelsTimeout;
+    if (channel && iPreOpenTimeout > 0)
+    {
+      CSingleLock lock(m_critSection);
+
+      if (m_iPreOpenJobId >= 0)
+        CJobManager::GetInstance().CancelJob(m_iPreOpenJobId);
+
+      CPVRChannelPreOpenJob* job = new CPVRChannelPreOpenJob(*this, channel, iPreOpenTimeout * 1000);
+      m_iPreOpenJobId = CJobManager::GetInstance().AddJob(job, dynamic_cast<IJobCallback*>(job));
+    }
   }
 
   void CPVRGUIChannelNavigator::ClearPlayingChannel()
   {
+    bool bClearPreOpenedChannels = false;
+
+    {
+      CSingleLock lock(m_critSection);
+      m_playingChannel.reset();
+      HideInfo();
+
+      if (m_iPreOpenJobId >= 0)
+      {
+        CJobManager::GetInstance().CancelJob(m_iPreOpenJobId);
+        m_iPreOpenJobId = -1;
+        bClearPreOpenedChannels = true;
+      }
+    }
+
+    // closing the streams may block, don't hold the lock meanwhile
+    if (bClearPreOpenedChannels)
+      ClearPreOpenedChannels();
+  }
+
+  void CPVRGUIChannelNavigator::PreOpenChannels(const std::shared_ptr<CPVRChannel>& channel)
+  {
+    const std::shared_ptr<CPVRChannelGroup> group =
+        CServiceBroker::GetPVRManager().PlaybackState()->GetPlayingGroup(channel->IsRadio());
+    if (!group)
+      return;
+
+    std::vector<std::pair<std::shared_ptr<CPVRChannel>, CPVRStreamProperties>> channels;
+    std::vector<CFileItem> items;
+    for (const auto& adjacentChannel :
+         {group->GetNextChannel(channel), group->GetPreviousChannel(channel)})
+    {
+      if (!adjacentChannel || adjacentChannel == channel || adjacentChannel->IsLocked() ||
+          std::any_of(channels.cbegin(), channels.cend(),
+                      [&adjacentChannel](const auto& entry) { return entry.first == adjacentChannel; }))
+        continue;
+
+      // the backend has to serve the playing and the opened streams at the same time
+      const std::shared_ptr<CPVRClient> client =
+          CServiceBroker::GetPVRManager().GetClient(adjacentChannel->ClientID());
+      if (!client || !client->GetClientCapabilities().SupportsConcurrentChannelStreams())
+        continue;
+
+      CPVRStreamProperties props;
+      if (client->GetChannelStreamProperties(adjacentChannel, props) != PVR_ERROR_NO_ERROR)
+        continue;
+
+      // streams of clients handling the input stream are bound to the player, only streams played
+      // via url can be opened ahead
+      if (props.GetStreamURL().empty())
+        continue;
+
+      CFileItem item(adjacentChannel);
+      CPVRGUIActions::ApplyStreamProperties(item, props);
+      items.emplace_back(item);
+      channels.emplace_back(adjacentChannel, props);
+    }
+
+    const size_t iOpened = CInputStreamPreOpener::GetInstance().Open(items);
+    CLog::LogFC(LOGDEBUG, LOGPVR, "Opened {} of {} streams of the channels next to '{}' ahead",
+                iOpened, items.size(), channel->ChannelName());
+
     CSingleLock lock(m_critSection);
-    m_playingChannel.reset();
-    HideInfo();
+    if (iOpened > 0 && channel == m_playingChannel)
+      m_preOpenedChannels = std::move(channels);
+  }
+
+  void CPVRGUIChannelNavigator::ClearPreOpenedChannels()
+  {
+    {
+      CSingleLock lock(m_critSection);
+      m_preOpenedChannels.clear();
+    }
+
+    CInputStreamPreOpener::GetInstance().Clear();
+  }
+
+  bool CPVRGUIChannelNavigator::GetPreOpenedStreamProperties(
+      const std::shared_ptr<CPVRChannel>& channel, CPVRStreamProperties& props) const
+  {
+    CSingleLock lock(m_critSection);
+
+    const auto it = std::find_if(m_preOpenedChannels.cbegin(), m_preOpenedChannels.cend(),
+                                 [&channel](const auto& entry) { return entry.first == channel; });
+    if (it == m_preOpenedChannels.cend())
+      return false;
+
+    props = (*it).second;
+    return true;
   }
 
 } // namespace PVR
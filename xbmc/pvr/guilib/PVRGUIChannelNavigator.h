@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include "pvr/PVRStreamProperties.h"
 #include "threads/CriticalSection.h"
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace PVR
 {
@@ -82,6 +85,27 @@ namespace PVR
      */
     void ClearPlayingChannel();
 
+    /*!
+     * @brief Open the streams of the channels next to the playing channel ahead of a channel switch.
+     * Only streams the player reads via a stream url obtained from the client can be opened ahead.
+     * @param channel The playing channel.
+     */
+    void PreOpenChannels(const std::shared_ptr<CPVRChannel>& channel);
+
+    /*!
+     * @brief Close the streams of the channels opened ahead.
+     */
+    void ClearPreOpenedChannels();
+
+    /*!
+     * @brief Get the stream properties of a channel the stream was opened ahead for.
+     * @param channel The channel.
+     * @param props The stream properties, filled on success.
+     * @return True if the stream of the channel was opened ahead, false otherwise.
+     */
+    bool GetPreOpenedStreamProperties(const std::shared_ptr<CPVRChannel>& channel,
+                                      CPVRStreamProperties& props) const;
+
   private:
     /*!
      * @brief Get next or previous channel of the playing channel group, relative to the currently selected channel.
@@ -108,6 +132,8 @@ namespace PVR
     std::shared_ptr<CPVRChannel> m_currentChannel;
     int m_iChannelEntryJobId = -1;
     int m_iChannelInfoJobId = -1;
+    int m_iPreOpenJobId = -1;
+    std::vector<std::pair<std::shared_ptr<CPVRChannel>, CPVRStreamProperties>> m_preOpenedChannels;
   };
 
 } // namespace PVR
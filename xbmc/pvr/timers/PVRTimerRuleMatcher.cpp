@@ -14,6 +14,8 @@
 #include "pvr/timers/PVRTimerInfoTag.h"
 #include "utils/RegExp.h"
 
+#include <algorithm>
+
 using namespace PVR;
 
 CPVRTimerRuleMatcher::CPVRTimerRuleMatcher(const std::shared_ptr<CPVRTimerInfoTag>& timerRule, const CDateTime& start)
@@ -200,3 +202,23 @@ bool CPVRTimerRuleMatcher::MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>
   else
     return true;
 }
+
+std::string CPVRTimerRuleMatcher::GetTitleSearchText() const
+{
+  if (m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() &&
+      m_timerRule->m_bFullTextEpgSearch)
+    return {};
+
+  if (!m_timerRule->GetTimerType()->SupportsEpgTitleMatch())
+    return {};
+
+  // the search string is a regular expression, only plain ascii text compares the same way
+  // as the search index
+  const std::string& text = m_timerRule->m_strEpgSearchString;
+  if (text.find_first_of("\\^$.|?*+()[]{}") != std::string::npos ||
+      std::any_of(text.cbegin(), text.cend(),
+                  [](char c) { return static_cast<unsigned char>(c) >= 0x80; }))
+    return {};
+
+  return text;
+}
@@ -11,6 +11,7 @@
 #include "XBDateTime.h"
 
 #include <memory>
+#include <string>
 
 class CRegExp;
 
@@ -32,6 +33,12 @@ namespace PVR
     CDateTime GetNextTimerStart() const;
     bool Matches(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
 
+    /*!
+     * @brief Get the text the title of a matching tag must contain.
+     * @return The text or an empty string if the rule does not match by a plain text title search.
+     */
+    std::string GetTitleSearchText() const;
+
   private:
     bool MatchSeriesLink(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
     bool MatchChannel(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
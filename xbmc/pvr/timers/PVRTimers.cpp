@@ -405,10 +405,34 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer& timers, const std::vec
 
 namespace
 {
+  bool GetEpgTagsFromSearchIndex(const CPVRTimerRuleMatcher& matcher,
+                                 std::vector<std::shared_ptr<CPVREpgInfoTag>>& matches)
+  {
+    const std::string text = matcher.GetTitleSearchText();
+    if (text.empty())
+      return false;
+
+    // only check the tags whose titles may contain the search text
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+    if (!CServiceBroker::GetPVRManager().EpgContainer().GetSearchCandidates(text, candidates))
+      return false;
+
+    for (const auto& tag : candidates)
+    {
+      if (matcher.Matches(tag))
+        matches.emplace_back(tag);
+    }
+
+    return true;
+  }
+
   std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTagsForTimerRule(const CPVRTimerRuleMatcher& matcher)
   {
     std::vector<std::shared_ptr<CPVREpgInfoTag>> matches;
 
+    if (GetEpgTagsFromSearchIndex(matcher, matches))
+      return matches;
+
     const std::shared_ptr<CPVRChannel> channel = matcher.GetChannel();
     if (channel)
     {
@@ -575,7 +599,22 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
           if (timer->IsEpgBased())
           {
             if (m_bReminderRulesUpdatePending)
-              AddTimerRuleToEpgMap(timer, now, epgMap, bFetchedAllEpgs);
+            {
+              std::vector<std::shared_ptr<CPVREpgInfoTag>> epgTags;
+              if (GetEpgTagsFromSearchIndex(CPVRTimerRuleMatcher(timer, now), epgTags))
+              {
+                // create new children of local epg-based reminder timer rule
+                for (const auto& epgTag : epgTags)
+                {
+                  if (CreateChildReminder(epgTag, timer, childTimersToInsert))
+                    bChanged = true;
+                }
+              }
+              else
+              {
+                AddTimerRuleToEpgMap(timer, now, epgMap, bFetchedAllEpgs);
+              }
+            }
           }
           else
           {
@@ -636,20 +675,11 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
     const auto epgTags = epgMapEntry.first->GetTags();
     for (const auto& epgTag : epgTags)
     {
-      if (GetTimerForEpgTag(epgTag))
-        continue;
-
       for (const auto& matcher : epgMapEntry.second)
       {
-        if (!matcher->Matches(epgTag))
-          continue;
-
-        const std::shared_ptr<CPVRTimerInfoTag> childTimer = CPVRTimerInfoTag::CreateReminderFromEpg(epgTag, matcher->GetTimerRule());
-        if (childTimer)
-        {
+        if (matcher->Matches(epgTag) &&
+            CreateChildReminder(epgTag, matcher->GetTimerRule(), childTimersToInsert))
           bChanged = true;
-          childTimersToInsert.emplace_back(std::make_pair(matcher->GetTimerRule(), childTimer)); // remember and insert/save later
-        }
       }
     }
   }
@@ -679,6 +709,24 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
   return bChanged;
 }
 
+bool CPVRTimers::CreateChildReminder(
+    const std::shared_ptr<CPVREpgInfoTag>& epgTag,
+    const std::shared_ptr<CPVRTimerInfoTag>& timerRule,
+    std::vector<std::pair<std::shared_ptr<CPVRTimerInfoTag>, std::shared_ptr<CPVRTimerInfoTag>>>&
+        childTimersToInsert) const
+{
+  if (GetTimerForEpgTag(epgTag))
+    return false;
+
+  const std::shared_ptr<CPVRTimerInfoTag> childTimer =
+      CPVRTimerInfoTag::CreateReminderFromEpg(epgTag, timerRule);
+  if (!childTimer)
+    return false;
+
+  childTimersToInsert.emplace_back(std::make_pair(timerRule, childTimer)); // remember and insert/save later
+  return true;
+}
+
 std::shared_ptr<CPVRTimerInfoTag> CPVRTimers::GetNextReminderToAnnnounce()
 {
   std::shared_ptr<CPVRTimerInfoTag> ret;
@@ -15,6 +15,7 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <utility>
 #include <vector>
 
 namespace PVR
@@ -281,6 +282,20 @@ namespace PVR
                                                                  const std::shared_ptr<CPVRTimerInfoTag>& parentTimer);
     void NotifyTimersEvent(bool bAddedOrDeleted = true);
 
+    /*!
+     * @brief Create a child reminder of a local epg-based reminder timer rule for an epg tag,
+     * unless the tag already has a timer.
+     * @param epgTag The epg tag, must match the rule.
+     * @param timerRule The timer rule.
+     * @param childTimersToInsert The rule and the child get appended, to be inserted later.
+     * @return True if a child was created, false otherwise.
+     */
+    bool CreateChildReminder(
+        const std::shared_ptr<CPVREpgInfoTag>& epgTag,
+        const std::shared_ptr<CPVRTimerInfoTag>& timerRule,
+        std::vector<std::pair<std::shared_ptr<CPVRTimerInfoTag>, std::shared_ptr<CPVRTimerInfoTag>>>&
+            childTimersToInsert) const;
+
     enum TimerKind
     {
       TimerKindAny = 0,
@@ -120,6 +120,12 @@ void CAdvancedSettings::Initialize()
   //default hold time of 25 ms, this allows a 20 hertz sine to pass undistorted
   m_limiterHold = 0.025f;
   m_limiterRelease = 0.1f;
+  m_audioResampler = "ffmpeg";
+  m_audioStreamWorkers = 0;
+  m_audioPreDecodeTime = 5;
+  m_audioPreDecodeBuffer = 2;
+  m_audioDecodedCacheSize = 0;
+  m_audioDecodedCacheTime = 30;
 
   m_seekSteps = { 10, 30, 60, 180, 300, 600, 1800 };
 
@@ -140,6 +146,10 @@ void CAdvancedSettings::Initialize()
 
   m_videoPPFFmpegPostProc = "ha:128:7,va,dr";
   m_videoDefaultPlayer = "VideoPlayer";
+  m_videoDecoderThreading = "auto";
+  m_videoFastStart = true;
+  m_videoDemuxAhead = true;
+  m_videoTrickPlayFps = 4;
   m_videoIgnoreSecondsAtStart = 3*60;
   m_videoIgnorePercentAtEnd   = 8.0f;
   m_videoPlayCountMinimumPercent = 90.0f;
@@ -325,6 +335,8 @@ void CAdvancedSettings::Initialize()
   m_bEpgDisplayUpdatePopup = true; /* Display a progress popup while updating EPG data from clients */
   m_bEpgDisplayIncrementalUpdatePopup = false; /* Display a progress popup while doing incremental EPG updates, but
                                                   only if 'displayupdatepopup' is also enabled. */
+  m_iEpgMaxParallelClients = 4; /* Fetch the EPG data from at most X clients at the same time. Each client is
+                                   asked for the data of one channel at a time. */
 
   m_bEdlMergeShortCommBreaks = false;      // Off by default
   m_iEdlMaxCommBreakLength = 8 * 30 + 10;  // Just over 8 * 30 second commercial break.
@@ -374,6 +386,7 @@ void CAdvancedSettings::Initialize()
   m_iPVRNumericChannelSwitchTimeout = 2000;
   m_iPVRTimeshiftThreshold = 10;
   m_bPVRTimeshiftSimpleOSD = true;
+  m_iPVRPreOpenChannelsTimeout = 0;
   m_PVRDefaultSortOrder.sortBy = SortByDate;
   m_PVRDefaultSortOrder.sortOrder = SortOrderDescending;
 
@@ -558,6 +571,12 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
 
     XMLUtils::GetFloat(pElement, "limiterhold", m_limiterHold, 0.0f, 100.0f);
     XMLUtils::GetFloat(pElement, "limiterrelease", m_limiterRelease, 0.001f, 100.0f);
+    XMLUtils::GetString(pElement, "resampler", m_audioResampler);
+    XMLUtils::GetInt(pElement, "streamworkers", m_audioStreamWorkers, 0, 8);
+    XMLUtils::GetInt(pElement, "predecodetime", m_audioPreDecodeTime, 1, 60);
+    XMLUtils::GetInt(pElement, "predecodebuffer", m_audioPreDecodeBuffer, 2, 30);
+    XMLUtils::GetInt(pElement, "decodedcachesize", m_audioDecodedCacheSize, 0, 1024);
+    XMLUtils::GetInt(pElement, "decodedcachetime", m_audioDecodedCacheTime, 5, 600);
   }
 
   pElement = pRootElement->FirstChildElement("x11");
@@ -576,6 +595,10 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetFloat(pElement, "subsdelayrange", m_videoSubsDelayRange, 10, 600);
     XMLUtils::GetFloat(pElement, "audiodelayrange", m_videoAudioDelayRange, 10, 600);
     XMLUtils::GetString(pElement, "defaultplayer", m_videoDefaultPlayer);
+    XMLUtils::GetString(pElement, "decoderthreading", m_videoDecoderThreading);
+    XMLUtils::GetBoolean(pElement, "faststart", m_videoFastStart);
+    XMLUtils::GetBoolean(pElement, "demuxahead", m_videoDemuxAhead);
+    XMLUtils::GetInt(pElement, "trickplayfps", m_videoTrickPlayFps, 0, 25);
     XMLUtils::GetBoolean(pElement, "fullscreenonmoviestart", m_fullScreenOnMovieStart);
     // 101 on purpose - can be used to never automark as watched
     XMLUtils::GetFloat(pElement, "playcountminimumpercent", m_videoPlayCountMinimumPercent, 0.0f, 101.0f);
@@ -915,6 +938,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "updateemptytagsinterval", m_iEpgUpdateEmptyTagsInterval);
     XMLUtils::GetBoolean(pElement, "displayupdatepopup", m_bEpgDisplayUpdatePopup);
     XMLUtils::GetBoolean(pElement, "displayincrementalupdatepopup", m_bEpgDisplayIncrementalUpdatePopup);
+    XMLUtils::GetInt(pElement, "maxparallelclients", m_iEpgMaxParallelClients, 1, 16);
   }
 
   // EDL commercial break handling
@@ -1096,6 +1120,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pPVR, "numericchannelswitchtimeout", m_iPVRNumericChannelSwitchTimeout, 50, 60000);
     XMLUtils::GetInt(pPVR, "timeshiftthreshold", m_iPVRTimeshiftThreshold, 0, 60);
     XMLUtils::GetBoolean(pPVR, "timeshiftsimpleosd", m_bPVRTimeshiftSimpleOSD);
+    XMLUtils::GetInt(pPVR, "preopenchannelstimeout", m_iPVRPreOpenChannelsTimeout, 0, 300);
     TiXmlElement* pSortDecription = pPVR->FirstChildElement("pvrrecordings");
     if (pSortDecription)
     {
@@ -129,6 +129,12 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_VideoPlayerIgnoreDTSinWAV;
     float m_limiterHold;
     float m_limiterRelease;
+    std::string m_audioResampler;
+    int m_audioStreamWorkers;
+    int m_audioPreDecodeTime; // seconds before the end of a track the next one is opened
+    int m_audioPreDecodeBuffer; // seconds of decoded audio buffered per track
+    int m_audioDecodedCacheSize; // MB, 0 disables the cache of recently played tracks
+    int m_audioDecodedCacheTime; // seconds cached from the start of each track
 
     bool  m_omlSync = true;
 
@@ -175,6 +181,10 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_videoPreferStereoStream = false;
 
     std::string m_videoDefaultPlayer;
+    std::string m_videoDecoderThreading; // "auto" tunes thread type and count, "frame" uses fixed frame threading
+    bool m_videoFastStart; // shorten stream analysis if stream details are in the library
+    bool m_videoDemuxAhead; // read files of network shares ahead on a separate thread
+    int m_videoTrickPlayFps; // keyframes shown per second above 2x speed, 0 decodes all frames
     float m_videoPlayCountMinimumPercent;
 
     float m_slideshowBlackBarCompensation;
@@ -272,6 +282,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iEpgUpdateEmptyTagsInterval; // seconds
     bool m_bEpgDisplayUpdatePopup;
     bool m_bEpgDisplayIncrementalUpdatePopup;
+    int m_iEpgMaxParallelClients;
 
     // EDL Commercial Break
     bool m_bEdlMergeShortCommBreaks;
@@ -321,6 +332,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iPVRNumericChannelSwitchTimeout; /*!< @brief time in msecs after that a channel switch occurs after entering a channel number, if confirmchannelswitch is disabled */
     int m_iPVRTimeshiftThreshold; /*!< @brief time diff between current playing time and timeshift buffer end, in seconds, before a playing stream is displayed as timeshifting. */
     bool m_bPVRTimeshiftSimpleOSD; /*!< @brief use simple timeshift OSD (with progress only for the playing event instead of progress for the whole ts buffer). */
+    int m_iPVRPreOpenChannelsTimeout; /*!< @brief time in seconds to keep the streams of the channels next to the playing channel opened, if their client supports concurrent channel streams. 0 to not open them ahead. */
     SortDescription m_PVRDefaultSortOrder; /*!< @brief SortDecription used to store default recording sort type and sort order */
 
     DatabaseSettings m_databaseMusic; // advanced music database setup
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/*!
+ \brief Bounded lock-free queue for exactly one producer and one consumer thread.
+
+ Push must only be called by the producer, Pop and Clear only by the consumer.
+ The queue never allocates after construction and never blocks, waking up
+ the other side is left to the caller (e.g. a CEvent).
+ */
+template<typename T>
+class CSPSCQueue
+{
+public:
+  /*!
+   \param capacity number of elements the queue can hold, rounded up to a power of two
+   */
+  explicit CSPSCQueue(size_t capacity)
+  {
+    size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+    m_buffer.resize(size);
+    m_mask = size - 1;
+  }
+
+  CSPSCQueue(const CSPSCQueue&) = delete;
+  CSPSCQueue& operator=(const CSPSCQueue&) = delete;
+
+  /*!
+   \return false if the queue is full
+   */
+  bool Push(const T& value)
+  {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_headCache > m_mask)
+    {
+      m_headCache = m_head.load(std::memory_order_acquire);
+      if (tail - m_headCache > m_mask)
+        return false;
+    }
+
+    m_buffer[tail & m_mask] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   \return false if the queue is empty
+   */
+  bool Pop(T& value)
+  {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tailCache)
+    {
+      m_tailCache = m_tail.load(std::memory_order_acquire);
+      if (head == m_tailCache)
+        return false;
+    }
+
+    value = m_buffer[head & m_mask];
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   \brief Drops all elements, consumer side only
+   */
+  void Clear()
+  {
+    T value;
+    while (Pop(value))
+      ;
+  }
+
+  bool IsEmpty() const
+  {
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+  }
+
+  size_t GetCapacity() const { return m_mask + 1; }
+
+private:
+  std::vector<T> m_buffer;
+  size_t m_mask;
+
+  // keep producer and consumer state on separate cache lines
+  alignas(64) std::atomic<size_t> m_head{0};
+  size_t m_tailCache = 0; // consumer's copy of m_tail
+  alignas(64) std::atomic<size_t> m_tail{0};
+  size_t m_headCache = 0; // producer's copy of m_head
+};
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/SPSCQueue.h"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+TEST(TestSPSCQueue, PushPop)
+{
+  CSPSCQueue<int> queue(3);
+  EXPECT_EQ(4u, queue.GetCapacity());
+  EXPECT_TRUE(queue.IsEmpty());
+
+  int value = 0;
+  EXPECT_FALSE(queue.Pop(value));
+
+  for (int i = 0; i < 4; i++)
+    EXPECT_TRUE(queue.Push(i));
+  EXPECT_FALSE(queue.Push(4));
+  EXPECT_FALSE(queue.IsEmpty());
+
+  for (int i = 0; i < 4; i++)
+  {
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_FALSE(queue.Pop(value));
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(TestSPSCQueue, WrapAround)
+{
+  CSPSCQueue<int> queue(4);
+  int value = 0;
+  for (int i = 0; i < 100; i++)
+  {
+    EXPECT_TRUE(queue.Push(i));
+    EXPECT_TRUE(queue.Push(i + 1000));
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(i, value);
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(i + 1000, value);
+  }
+
+  queue.Push(1);
+  queue.Push(2);
+  queue.Clear();
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(TestSPSCQueue, Threads)
+{
+  const int count = 100000;
+  CSPSCQueue<int> queue(64);
+
+  std::thread producer([&queue]() {
+    for (int i = 0; i < count; i++)
+    {
+      while (!queue.Push(i))
+        std::this_thread::yield();
+    }
+  });
+
+  int expected = 0;
+  while (expected < count)
+  {
+    int value;
+    if (queue.Pop(value))
+    {
+      EXPECT_EQ(expected, value);
+      expected++;
+    }
+    else
+      std::this_thread::yield();
+  }
+
+  producer.join();
+  EXPECT_TRUE(queue.IsEmpty());
+}
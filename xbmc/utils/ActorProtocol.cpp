@@ -14,6 +14,27 @@
 
 using namespace Actor;
 
+Message::~Message() = default;
+
+void Message::SetData(const void* payload, size_t size)
+{
+  if (size > sizeof(buffer))
+  {
+    // keep the largest buffer so that recycled messages don't allocate again
+    if (size > heapBufferSize)
+    {
+      heapBuffer.reset(new uint8_t[size]);
+      heapBufferSize = size;
+    }
+    data = heapBuffer.get();
+  }
+  else
+    data = buffer;
+
+  memcpy(data, payload, size);
+  payloadSize = size;
+}
+
 void Message::Release()
 {
   bool skip;
@@ -25,15 +46,8 @@ void Message::Release()
   if (skip)
     return;
 
-  // free data buffer
-  if (data != buffer)
-    delete [] data;
-
   payloadObj.reset();
 
-  // delete event in case of sync message
-  delete event;
-
   origin.ReturnMessage(this);
 }
 
@@ -56,13 +70,7 @@ bool Message::Reply(int sig, void *data /* = NULL*/, size_t size /* = 0 */)
     msg->isOut = !isOut;
     replyMessage = msg;
     if (data)
-    {
-      if (size > sizeof(msg->buffer))
-        msg->data = new uint8_t[size];
-      else
-        msg->data = msg->buffer;
-      memcpy(msg->data, data, size);
-    }
+      msg->SetData(data, size);
   }
 
   origin.Unlock();
@@ -73,39 +81,62 @@ bool Message::Reply(int sig, void *data /* = NULL*/, size_t size /* = 0 */)
   return true;
 }
 
+void Protocol::MessageQueue::Push(Message *msg)
+{
+  msg->next = nullptr;
+  if (tail)
+    tail->next = msg;
+  else
+    head = msg;
+  tail = msg;
+}
+
+Message *Protocol::MessageQueue::Pop()
+{
+  Message *msg = head;
+  if (msg)
+  {
+    head = msg->next;
+    if (!head)
+      tail = nullptr;
+    msg->next = nullptr;
+  }
+  return msg;
+}
+
+Protocol::Protocol(std::string name, CEvent* inEvent, CEvent* outEvent)
+  : portName(std::move(name)), containerInEvent(inEvent), containerOutEvent(outEvent)
+{
+  for (int i = 0; i < PREALLOCATED_MESSAGES; i++)
+    freeMessageQueue.Push(new Message(*this));
+}
+
 Protocol::~Protocol()
 {
-  Message *msg;
   Purge();
-  while (!freeMessageQueue.empty())
-  {
-    msg = freeMessageQueue.front();
-    freeMessageQueue.pop();
+  while (Message *msg = freeMessageQueue.Pop())
     delete msg;
-  }
 }
 
 Message *Protocol::GetMessage()
 {
   Message *msg;
 
-  CSingleLock lock(criticalSection);
-
-  if (!freeMessageQueue.empty())
   {
-    msg = freeMessageQueue.front();
-    freeMessageQueue.pop();
+    CSingleLock lock(criticalSection);
+    msg = freeMessageQueue.Pop();
   }
-  else
+
+  if (!msg)
     msg = new Message(*this);
 
   msg->isSync = false;
   msg->isSyncFini = false;
   msg->isSyncTimeout = false;
-  msg->event = NULL;
-  msg->data = NULL;
+  msg->event = nullptr;
+  msg->data = nullptr;
   msg->payloadSize = 0;
-  msg->replyMessage = NULL;
+  msg->replyMessage = nullptr;
 
   return msg;
 }
@@ -114,7 +145,7 @@ void Protocol::ReturnMessage(Message *msg)
 {
   CSingleLock lock(criticalSection);
 
-  freeMessageQueue.push(msg);
+  freeMessageQueue.Push(msg);
 }
 
 bool Protocol::SendOutMessage(int signal,
@@ -132,16 +163,10 @@ bool Protocol::SendOutMessage(int signal,
   msg->isOut = true;
 
   if (data)
-  {
-    if (size > sizeof(msg->buffer))
-      msg->data = new uint8_t[size];
-    else
-      msg->data = msg->buffer;
-    memcpy(msg->data, data, size);
-  }
+    msg->SetData(data, size);
 
   { CSingleLock lock(criticalSection);
-    outMessages.push(msg);
+    outMessages.Push(msg);
   }
   if (containerOutEvent)
     containerOutEvent->Set();
@@ -163,7 +188,7 @@ bool Protocol::SendOutMessage(int signal, CPayloadWrapBase *payload, Message *ou
   msg->payloadObj.reset(payload);
 
   { CSingleLock lock(criticalSection);
-    outMessages.push(msg);
+    outMessages.Push(msg);
   }
   if (containerOutEvent)
     containerOutEvent->Set();
@@ -186,16 +211,10 @@ bool Protocol::SendInMessage(int signal,
   msg->isOut = false;
 
   if (data)
-  {
-    if (size > sizeof(msg->data))
-      msg->data = new uint8_t[size];
-    else
-      msg->data = msg->buffer;
-    memcpy(msg->data, data, size);
-  }
+    msg->SetData(data, size);
 
   { CSingleLock lock(criticalSection);
-    inMessages.push(msg);
+    inMessages.Push(msg);
   }
   if (containerInEvent)
     containerInEvent->Set();
@@ -217,7 +236,7 @@ bool Protocol::SendInMessage(int signal, CPayloadWrapBase *payload, Message *out
   msg->payloadObj.reset(payload);
 
   { CSingleLock lock(criticalSection);
-    inMessages.push(msg);
+    inMessages.Push(msg);
   }
   if (containerInEvent)
     containerInEvent->Set();
@@ -231,7 +250,9 @@ bool Protocol::SendOutMessageSync(
   Message *msg = GetMessage();
   msg->isOut = true;
   msg->isSync = true;
-  msg->event = new CEvent;
+  if (!msg->syncEvent)
+    msg->syncEvent.reset(new CEvent);
+  msg->event = msg->syncEvent.get();
   msg->event->Reset();
   SendOutMessage(signal, data, size, msg);
 
@@ -262,7 +283,9 @@ bool Protocol::SendOutMessageSync(int signal, Message **retMsg, int timeout, CPa
   Message *msg = GetMessage();
   msg->isOut = true;
   msg->isSync = true;
-  msg->event = new CEvent;
+  if (!msg->syncEvent)
+    msg->syncEvent.reset(new CEvent);
+  msg->event = msg->syncEvent.get();
   msg->event->Reset();
   SendOutMessage(signal, payload, msg);
 
@@ -292,11 +315,10 @@ bool Protocol::ReceiveOutMessage(Message **msg)
 {
   CSingleLock lock(criticalSection);
 
-  if (outMessages.empty() || outDefered)
+  if (outMessages.IsEmpty() || outDefered)
     return false;
 
-  *msg = outMessages.front();
-  outMessages.pop();
+  *msg = outMessages.Pop();
 
   return true;
 }
@@ -305,11 +327,10 @@ bool Protocol::ReceiveInMessage(Message **msg)
 {
   CSingleLock lock(criticalSection);
 
-  if (inMessages.empty() || inDefered)
+  if (inMessages.IsEmpty() || inDefered)
     return false;
 
-  *msg = inMessages.front();
-  inMessages.pop();
+  *msg = inMessages.Pop();
 
   return true;
 }
@@ -328,44 +349,32 @@ void Protocol::Purge()
 
 void Protocol::PurgeIn(int signal)
 {
-  Message *msg;
-  std::queue<Message*> msgs;
-
-  CSingleLock lock(criticalSection);
-
-  while (!inMessages.empty())
-  {
-    msg = inMessages.front();
-    inMessages.pop();
-    if (msg->signal != signal)
-      msgs.push(msg);
-  }
-  while (!msgs.empty())
-  {
-    msg = msgs.front();
-    msgs.pop();
-    inMessages.push(msg);
-  }
+  Purge(inMessages, signal);
 }
 
 void Protocol::PurgeOut(int signal)
 {
-  Message *msg;
-  std::queue<Message*> msgs;
+  Purge(outMessages, signal);
+}
 
-  CSingleLock lock(criticalSection);
+void Protocol::Purge(MessageQueue& queue, int signal)
+{
+  MessageQueue keep;
+  MessageQueue purged;
 
-  while (!outMessages.empty())
   {
-    msg = outMessages.front();
-    outMessages.pop();
-    if (msg->signal != signal)
-      msgs.push(msg);
-  }
-  while (!msgs.empty())
-  {
-    msg = msgs.front();
-    msgs.pop();
-    outMessages.push(msg);
+    CSingleLock lock(criticalSection);
+
+    while (Message *msg = queue.Pop())
+    {
+      if (msg->signal != signal)
+        keep.Push(msg);
+      else
+        purged.Push(msg);
+    }
+    queue = keep;
   }
+
+  while (Message *msg = purged.Pop())
+    msg->Release();
 }
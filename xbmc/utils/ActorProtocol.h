@@ -11,8 +11,8 @@
 #include "threads/CriticalSection.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <queue>
 #include <string>
 #include <utility>
 
@@ -34,6 +34,8 @@ public:
   ~CPayloadWrap() override = default;
   CPayloadWrap(Payload *data) {m_pPayload.reset(data);};
   CPayloadWrap(Payload &data) {m_pPayload.reset(new Payload(data));};
+  CPayloadWrap(Payload &&data) {m_pPayload.reset(new Payload(std::move(data)));};
+  CPayloadWrap(std::unique_ptr<Payload> data) : m_pPayload(std::move(data)) {}
   Payload *GetPlayload() {return m_pPayload.get();};
 protected:
   std::unique_ptr<Payload> m_pPayload;
@@ -45,7 +47,7 @@ class Message
 {
   friend class Protocol;
 
-  static constexpr size_t MSG_INTERNAL_BUFFER_SIZE = 32;
+  static constexpr size_t MSG_INTERNAL_BUFFER_SIZE = 64;
 
 public:
   int signal;
@@ -67,15 +69,22 @@ public:
 private:
   explicit Message(Protocol &_origin) noexcept
     :origin(_origin) {}
+  ~Message();
+  void SetData(const void* payload, size_t size);
+
+  // payloads not fitting into buffer, kept for reuse when the message is recycled
+  std::unique_ptr<uint8_t[]> heapBuffer;
+  size_t heapBufferSize = 0;
+  // created on first sync use, kept for reuse
+  std::unique_ptr<CEvent> syncEvent;
+  // link in the message queues of the protocol
+  Message *next = nullptr;
 };
 
 class Protocol
 {
 public:
-  Protocol(std::string name, CEvent* inEvent, CEvent* outEvent)
-    : portName(std::move(name)), containerInEvent(inEvent), containerOutEvent(outEvent)
-  {
-  }
+  Protocol(std::string name, CEvent* inEvent, CEvent* outEvent);
   Protocol(std::string name) : Protocol(std::move(name), nullptr, nullptr) {}
   ~Protocol();
   Message *GetMessage();
@@ -105,11 +114,31 @@ public:
   std::string portName;
 
 protected:
+  /*!
+   \brief FIFO of messages linked through Message::next, never allocates
+   */
+  class MessageQueue
+  {
+  public:
+    bool IsEmpty() const { return head == nullptr; }
+    void Push(Message *msg);
+    Message *Pop();
+
+  private:
+    Message *head = nullptr;
+    Message *tail = nullptr;
+  };
+
+  void Purge(MessageQueue& queue, int signal);
+
+  // number of messages allocated up front, the free list grows on demand
+  static constexpr int PREALLOCATED_MESSAGES = 8;
+
   CEvent *containerInEvent, *containerOutEvent;
   CCriticalSection criticalSection;
-  std::queue<Message*> outMessages;
-  std::queue<Message*> inMessages;
-  std::queue<Message*> freeMessageQueue;
+  MessageQueue outMessages;
+  MessageQueue inMessages;
+  MessageQueue freeMessageQueue;
   bool inDefered = false, outDefered = false;
 };
 
@@ -10,6 +10,11 @@
 
 #include "utils/Variant.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
@@ -26,6 +31,9 @@ bool InternalWrite(TWriter& writer, const CVariant &value)
     return writer.Uint64(value.asUnsignedInteger());
 
   case CVariant::VariantTypeDouble:
+    // JSON has no representation for NaN and infinity
+    if (!std::isfinite(value.asDouble()))
+      return writer.Null();
     return writer.Double(value.asDouble());
 
   case CVariant::VariantTypeBoolean:
@@ -90,3 +98,152 @@ bool CJSONVariantWriter::Write(const CVariant &value, std::string& output, bool
   output = stringBuffer.GetString();
   return true;
 }
+
+namespace
+{
+// amount of serialised data produced in one go by CJSONVariantStreamWriter
+constexpr size_t STREAM_CHUNK_SIZE = 64 * 1024;
+
+// rapidjson output stream appending to a string
+class CStringOutputStream
+{
+public:
+  using Ch = char;
+
+  explicit CStringOutputStream(std::string& output) : m_output(output) {}
+
+  void Put(char c) { m_output.push_back(c); }
+  void Flush() {}
+
+private:
+  std::string& m_output;
+};
+} // unnamed namespace
+
+class CJSONVariantStreamWriter::CWriter
+{
+public:
+  CWriter(std::string& output, bool compact) : m_stream(output)
+  {
+    if (compact)
+    {
+      m_compactWriter = std::make_unique<rapidjson::Writer<CStringOutputStream>>(m_stream);
+    }
+    else
+    {
+      m_prettyWriter = std::make_unique<rapidjson::PrettyWriter<CStringOutputStream>>(m_stream);
+      m_prettyWriter->SetIndent('\t', 1);
+    }
+  }
+
+  template<typename F>
+  bool Apply(F&& f)
+  {
+    return m_compactWriter ? f(*m_compactWriter) : f(*m_prettyWriter);
+  }
+
+private:
+  CStringOutputStream m_stream;
+  std::unique_ptr<rapidjson::Writer<CStringOutputStream>> m_compactWriter;
+  std::unique_ptr<rapidjson::PrettyWriter<CStringOutputStream>> m_prettyWriter;
+};
+
+CJSONVariantStreamWriter::CJSONVariantStreamWriter(CVariant value, bool compact)
+  : m_value(std::move(value)), m_writer(std::make_unique<CWriter>(m_pending, compact))
+{
+}
+
+CJSONVariantStreamWriter::~CJSONVariantStreamWriter() = default;
+
+size_t CJSONVariantStreamWriter::Read(char* buffer, size_t size)
+{
+  size_t copied = 0;
+  while (copied < size)
+  {
+    if (m_pendingPosition >= m_pending.size() && !Fill())
+      break;
+
+    const size_t length = std::min(size - copied, m_pending.size() - m_pendingPosition);
+    memcpy(buffer + copied, m_pending.data() + m_pendingPosition, length);
+    copied += length;
+    m_pendingPosition += length;
+  }
+
+  return copied;
+}
+
+bool CJSONVariantStreamWriter::IsComplete() const
+{
+  return m_started && m_stack.empty() && m_pendingPosition >= m_pending.size();
+}
+
+bool CJSONVariantStreamWriter::Fill()
+{
+  m_pending.clear();
+  m_pendingPosition = 0;
+
+  if (!m_started)
+  {
+    m_started = true;
+    WriteValue(m_value);
+  }
+
+  while (!m_stack.empty() && m_pending.size() < STREAM_CHUNK_SIZE)
+    Step();
+
+  return !m_pending.empty();
+}
+
+void CJSONVariantStreamWriter::Step()
+{
+  Frame& frame = m_stack.back();
+  if (frame.isObject ? frame.itMap == frame.endMap : frame.itArray == frame.endArray)
+  {
+    const bool isObject = frame.isObject;
+    m_stack.pop_back();
+    m_writer->Apply([isObject](auto& writer) {
+      return isObject ? writer.EndObject() : writer.EndArray();
+    });
+    return;
+  }
+
+  const CVariant* value;
+  if (frame.isObject)
+  {
+    const std::string& key = frame.itMap->first;
+    m_writer->Apply([&key](auto& writer) {
+      return writer.Key(key.c_str(), static_cast<rapidjson::SizeType>(key.size()));
+    });
+    value = &frame.itMap->second;
+    ++frame.itMap;
+  }
+  else
+  {
+    value = &*frame.itArray;
+    ++frame.itArray;
+  }
+
+  // may push a new frame, don't touch frame afterwards
+  WriteValue(*value);
+}
+
+void CJSONVariantStreamWriter::WriteValue(const CVariant& value)
+{
+  if (value.isObject() || value.isArray())
+  {
+    Frame frame;
+    frame.isObject = value.isObject();
+    frame.itArray = value.begin_array();
+    frame.endArray = value.end_array();
+    frame.itMap = value.begin_map();
+    frame.endMap = value.end_map();
+    m_stack.push_back(frame);
+
+    m_writer->Apply([&frame](auto& writer) {
+      return frame.isObject ? writer.StartObject() : writer.StartArray();
+    });
+    return;
+  }
+
+  m_writer->Apply([&value](auto& writer) { return InternalWrite(writer, value); });
+}
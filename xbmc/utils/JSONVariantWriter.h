@@ -8,9 +8,11 @@
 
 #pragma once
 
-#include <string>
+#include "utils/Variant.h"
 
-class CVariant;
+#include <memory>
+#include <string>
+#include <vector>
 
 class CJSONVariantWriter
 {
@@ -19,3 +21,52 @@ public:
 
   static bool Write(const CVariant &value, std::string& output, bool compact);
 };
+
+/*!
+ \brief Serialises a CVariant to JSON in consecutive chunks.
+
+ Produces the same output as CJSONVariantWriter::Write() but never holds more than a small chunk
+ of it in memory, so large values (e.g. JSON-RPC library responses) can be sent while they are
+ being serialised.
+ */
+class CJSONVariantStreamWriter
+{
+public:
+  CJSONVariantStreamWriter(CVariant value, bool compact);
+  ~CJSONVariantStreamWriter();
+
+  /*!
+   \brief Copy the next part of the serialised value into the given buffer.
+   \return Number of bytes copied, 0 once the complete value has been read.
+   */
+  size_t Read(char* buffer, size_t size);
+
+  /*!
+   \brief Whether the complete value has been serialised and read.
+   */
+  bool IsComplete() const;
+
+private:
+  struct Frame
+  {
+    bool isObject;
+    CVariant::const_iterator_array itArray;
+    CVariant::const_iterator_array endArray;
+    CVariant::const_iterator_map itMap;
+    CVariant::const_iterator_map endMap;
+  };
+
+  // the rapidjson writer used for the whole value, appending to m_pending
+  class CWriter;
+
+  bool Fill();
+  void Step();
+  void WriteValue(const CVariant& value);
+
+  CVariant m_value;
+  bool m_started = false;
+  std::vector<Frame> m_stack;
+  std::string m_pending;
+  size_t m_pendingPosition = 0;
+  std::unique_ptr<CWriter> m_writer;
+};
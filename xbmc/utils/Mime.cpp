@@ -17,6 +17,7 @@
 #include "video/VideoInfoTag.h"
 
 #include <algorithm>
+#include <unordered_set>
 
 const std::map<std::string, std::string> CMime::m_mimetypes = 
     {{{"3dm",       "x-world/x-3dmf"},
@@ -513,6 +514,19 @@ const std::map<std::string, std::string> CMime::m_mimetypes =
       {"zoo",       "application/octet-stream"},
       {"zsh",       "text/x-script.zsh"}}};
 
+bool CMime::IsKnownMimeType(const std::string& mimeType)
+{
+  static const std::unordered_set<std::string> knownTypes = []() {
+    std::unordered_set<std::string> types = {"x-directory/normal", "application/octet-stream",
+                                             "application/rss+xml"};
+    for (const auto& entry : m_mimetypes)
+      types.insert(entry.second);
+    return types;
+  }();
+
+  return knownTypes.find(mimeType) != knownTypes.end();
+}
+
 std::string CMime::GetMimeType(const std::string &extension)
 {
   if (extension.empty())
@@ -22,6 +22,13 @@ public:
   static std::string GetMimeType(const CFileItem &item);
   static std::string GetMimeType(const CURL &url, bool lookup = true);
 
+  /*!
+   \brief Check whether a mime type is one of the fixed set of types known to Kodi.
+   \param mimeType the mime type, compared case sensitive.
+   \return true if the type is known, false otherwise.
+   */
+  static bool IsKnownMimeType(const std::string& mimeType);
+
   enum EFileType
   {
     FileTypeUnknown = 0,
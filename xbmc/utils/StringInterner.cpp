@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "StringInterner.h"
+
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+
+#include <unordered_set>
+
+namespace
+{
+
+struct InternPool
+{
+  CCriticalSection lock;
+  // node based container, references to elements stay valid when rehashing
+  std::unordered_set<std::string> strings;
+};
+
+InternPool& GetPool()
+{
+  static InternPool pool;
+  return pool;
+}
+
+} // unnamed namespace
+
+const std::string& CStringInterner::Intern(const std::string& str)
+{
+  if (str.empty())
+    return Empty();
+
+  InternPool& pool = GetPool();
+  CSingleLock lock(pool.lock);
+  return *pool.strings.insert(str).first;
+}
+
+const std::string& CStringInterner::Empty()
+{
+  static const std::string empty;
+  return empty;
+}
+
+std::size_t CStringInterner::GetSize()
+{
+  InternPool& pool = GetPool();
+  CSingleLock lock(pool.lock);
+  return pool.strings.size();
+}
+
+std::size_t CStringInterner::GetMemoryUsage()
+{
+  InternPool& pool = GetPool();
+  CSingleLock lock(pool.lock);
+
+  std::size_t bytes = pool.strings.bucket_count() * sizeof(void*);
+  for (const auto& str : pool.strings)
+  {
+    // node: next pointer + cached hash + the string object itself
+    bytes += sizeof(void*) + sizeof(std::size_t) + sizeof(std::string);
+    if (str.capacity() >= sizeof(std::string))
+      bytes += str.capacity() + 1;
+  }
+  return bytes;
+}
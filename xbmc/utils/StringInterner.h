@@ -0,0 +1,45 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/*!
+ \brief Process wide pool of immutable strings.
+
+ Values that are repeated across a large number of objects (mime types, protocol prefixes, ...)
+ can be stored once in the pool and referenced by pointer instead of being copied into each
+ object. Interned strings are never released, so only intern values from a small, bounded set.
+ */
+class CStringInterner
+{
+public:
+  /*!
+   \brief Get the pooled instance of the given string, adding it to the pool if needed.
+   \param str the string to intern.
+   \return a reference to the pooled string, valid for the lifetime of the process.
+   */
+  static const std::string& Intern(const std::string& str);
+
+  /*!
+   \brief Get the pooled empty string.
+   */
+  static const std::string& Empty();
+
+  /*!
+   \brief Get the number of strings currently held by the pool.
+   */
+  static std::size_t GetSize();
+
+  /*!
+   \brief Get the approximate number of bytes held by the pool.
+   */
+  static std::size_t GetMemoryUsage();
+};
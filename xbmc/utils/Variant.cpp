@@ -9,6 +9,7 @@
 #include "Variant.h"
 
 #include <stdlib.h>
+#include <new>
 #include <string.h>
 #include <utility>
 
@@ -28,6 +29,10 @@
 #endif // TARGET_WINDOWS
 #endif // strtoll
 
+// the inline string is the largest member. anything bigger means a member was added to the union.
+static_assert(sizeof(CVariant) <= sizeof(std::string) + sizeof(void*),
+              "CVariant must not grow beyond an inline std::string plus its type");
+
 std::string trimRight(const std::string &str)
 {
   std::string tmp = str;
@@ -144,7 +149,7 @@ CVariant::CVariant(VariantType type)
       m_data.dvalue = 0.0;
       break;
     case VariantTypeString:
-      m_data.string = new std::string();
+      new (&m_data.string) std::string();
       break;
     case VariantTypeWideString:
       m_data.wstring = new std::wstring();
@@ -157,7 +162,7 @@ CVariant::CVariant(VariantType type)
       break;
     default:
 #ifndef TARGET_WINDOWS_STORE // this corrupts the heap in Win10 UWP version
-      memset(&m_data, 0, sizeof(m_data));
+      memset(static_cast<void*>(&m_data), 0, sizeof(m_data));
 #endif
       break;
   }
@@ -208,25 +213,25 @@ CVariant::CVariant(bool boolean)
 CVariant::CVariant(const char *str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  new (&m_data.string) std::string(str);
 }
 
 CVariant::CVariant(const char *str, unsigned int length)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str, length);
+  new (&m_data.string) std::string(str, length);
 }
 
 CVariant::CVariant(const std::string &str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  new (&m_data.string) std::string(str);
 }
 
 CVariant::CVariant(std::string &&str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(std::move(str));
+  new (&m_data.string) std::string(std::move(str));
 }
 
 CVariant::CVariant(const wchar_t *str)
@@ -262,6 +267,15 @@ CVariant::CVariant(const std::vector<std::string> &strArray)
     m_data.array->push_back(CVariant(item));
 }
 
+CVariant::CVariant(std::vector<std::string>&& strArray)
+{
+  m_type = VariantTypeArray;
+  m_data.array = new VariantArray;
+  m_data.array->reserve(strArray.size());
+  for (auto& item : strArray)
+    m_data.array->emplace_back(std::move(item));
+}
+
 CVariant::CVariant(const std::map<std::string, std::string> &strMap)
 {
   m_type = VariantTypeObject;
@@ -276,6 +290,12 @@ CVariant::CVariant(const std::map<std::string, CVariant> &variantMap)
   m_data.map = new VariantMap(variantMap.begin(), variantMap.end());
 }
 
+CVariant::CVariant(std::map<std::string, CVariant>&& variantMap)
+{
+  m_type = VariantTypeObject;
+  m_data.map = new VariantMap(std::move(variantMap));
+}
+
 CVariant::CVariant(const CVariant &variant)
 {
   m_type = VariantTypeNull;
@@ -301,8 +321,7 @@ void CVariant::cleanup()
   switch (m_type)
   {
   case VariantTypeString:
-    delete m_data.string;
-    m_data.string = nullptr;
+    m_data.string.~basic_string();
     break;
 
   case VariantTypeWideString:
@@ -391,7 +410,7 @@ int64_t CVariant::asInteger(int64_t fallback) const
     case VariantTypeDouble:
       return (int64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2int64(*m_data.string, fallback);
+      return str2int64(m_data.string, fallback);
     case VariantTypeWideString:
       return str2int64(*m_data.wstring, fallback);
     default:
@@ -417,7 +436,7 @@ uint64_t CVariant::asUnsignedInteger(uint64_t fallback) const
     case VariantTypeDouble:
       return (uint64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2uint64(*m_data.string, fallback);
+      return str2uint64(m_data.string, fallback);
     case VariantTypeWideString:
       return str2uint64(*m_data.wstring, fallback);
     default:
@@ -443,7 +462,7 @@ double CVariant::asDouble(double fallback) const
     case VariantTypeUnsignedInteger:
       return (double)m_data.unsignedinteger;
     case VariantTypeString:
-      return str2double(*m_data.string, fallback);
+      return str2double(m_data.string, fallback);
     case VariantTypeWideString:
       return str2double(*m_data.wstring, fallback);
     default:
@@ -464,7 +483,7 @@ float CVariant::asFloat(float fallback) const
     case VariantTypeUnsignedInteger:
       return (float)m_data.unsignedinteger;
     case VariantTypeString:
-      return (float)str2double(*m_data.string, fallback);
+      return (float)str2double(m_data.string, fallback);
     case VariantTypeWideString:
       return (float)str2double(*m_data.wstring, fallback);
     default:
@@ -487,7 +506,7 @@ bool CVariant::asBoolean(bool fallback) const
     case VariantTypeDouble:
       return (m_data.dvalue != 0);
     case VariantTypeString:
-      if (m_data.string->empty() || m_data.string->compare("0") == 0 || m_data.string->compare("false") == 0)
+      if (m_data.string.empty() || m_data.string.compare("0") == 0 || m_data.string.compare("false") == 0)
         return false;
       return true;
     case VariantTypeWideString:
@@ -506,7 +525,7 @@ std::string CVariant::asString(const std::string &fallback /* = "" */) const
   switch (m_type)
   {
     case VariantTypeString:
-      return *m_data.string;
+      return m_data.string;
     case VariantTypeBoolean:
       return m_data.boolean ? "true" : "false";
     case VariantTypeInteger:
@@ -557,6 +576,20 @@ CVariant &CVariant::operator[](const std::string &key)
     return ConstNullVariant;
 }
 
+CVariant& CVariant::operator[](std::string&& key)
+{
+  if (m_type == VariantTypeNull)
+  {
+    m_type = VariantTypeObject;
+    m_data.map = new VariantMap;
+  }
+
+  if (m_type == VariantTypeObject)
+    return (*m_data.map)[std::move(key)];
+  else
+    return ConstNullVariant;
+}
+
 const CVariant &CVariant::operator[](const std::string &key) const
 {
   VariantMap::const_iterator it;
@@ -606,7 +639,7 @@ CVariant &CVariant::operator=(const CVariant &rhs)
     m_data.dvalue = rhs.m_data.dvalue;
     break;
   case VariantTypeString:
-    m_data.string = new std::string(*rhs.m_data.string);
+    new (&m_data.string) std::string(rhs.m_data.string);
     break;
   case VariantTypeWideString:
     m_data.wstring = new std::wstring(*rhs.m_data.wstring);
@@ -633,23 +666,50 @@ CVariant& CVariant::operator=(CVariant&& rhs) noexcept
   if (m_type != VariantTypeNull)
     cleanup();
 
+  moveFrom(rhs);
+
+  return *this;
+}
+
+void CVariant::moveFrom(CVariant& rhs) noexcept
+{
   m_type = rhs.m_type;
-  m_data = rhs.m_data;
 
-  //Should be enough to just set m_type here
-  //but better safe than sorry, could probably lead to coverity warnings
-  if (rhs.m_type == VariantTypeString)
-    rhs.m_data.string = nullptr;
-  else if (rhs.m_type == VariantTypeWideString)
+  switch (m_type)
+  {
+  case VariantTypeString:
+    new (&m_data.string) std::string(std::move(rhs.m_data.string));
+    rhs.m_data.string.~basic_string();
+    break;
+  case VariantTypeWideString:
+    m_data.wstring = rhs.m_data.wstring;
     rhs.m_data.wstring = nullptr;
-  else if (rhs.m_type == VariantTypeArray)
+    break;
+  case VariantTypeArray:
+    m_data.array = rhs.m_data.array;
     rhs.m_data.array = nullptr;
-  else if (rhs.m_type == VariantTypeObject)
+    break;
+  case VariantTypeObject:
+    m_data.map = rhs.m_data.map;
     rhs.m_data.map = nullptr;
+    break;
+  case VariantTypeInteger:
+    m_data.integer = rhs.m_data.integer;
+    break;
+  case VariantTypeUnsignedInteger:
+    m_data.unsignedinteger = rhs.m_data.unsignedinteger;
+    break;
+  case VariantTypeBoolean:
+    m_data.boolean = rhs.m_data.boolean;
+    break;
+  case VariantTypeDouble:
+    m_data.dvalue = rhs.m_data.dvalue;
+    break;
+  default:
+    break;
+  }
 
   rhs.m_type = VariantTypeNull;
-
-  return *this;
 }
 
 bool CVariant::operator==(const CVariant &rhs) const
@@ -667,7 +727,7 @@ bool CVariant::operator==(const CVariant &rhs) const
     case VariantTypeDouble:
       return m_data.dvalue == rhs.m_data.dvalue;
     case VariantTypeString:
-      return *m_data.string == *rhs.m_data.string;
+      return m_data.string == rhs.m_data.string;
     case VariantTypeWideString:
       return *m_data.wstring == *rhs.m_data.wstring;
     case VariantTypeArray:
@@ -730,21 +790,21 @@ void CVariant::append(CVariant&& variant)
 const char *CVariant::c_str() const
 {
   if (m_type == VariantTypeString)
-    return m_data.string->c_str();
+    return m_data.string.c_str();
   else
     return NULL;
 }
 
 void CVariant::swap(CVariant &rhs)
 {
-  VariantType  temp_type = m_type;
-  VariantUnion temp_data = m_data;
-
-  m_type = rhs.m_type;
-  m_data = rhs.m_data;
+  if (this == &rhs)
+    return;
 
-  rhs.m_type = temp_type;
-  rhs.m_data = temp_data;
+  // moveFrom() transfers the type as is, so this also swaps const null variants
+  CVariant temp;
+  temp.moveFrom(rhs);
+  rhs.moveFrom(*this);
+  moveFrom(temp);
 }
 
 CVariant::iterator_array CVariant::begin_array()
@@ -818,7 +878,7 @@ unsigned int CVariant::size() const
   else if (m_type == VariantTypeArray)
     return m_data.array->size();
   else if (m_type == VariantTypeString)
-    return m_data.string->size();
+    return m_data.string.size();
   else if (m_type == VariantTypeWideString)
     return m_data.wstring->size();
   else
@@ -832,7 +892,7 @@ bool CVariant::empty() const
   else if (m_type == VariantTypeArray)
     return m_data.array->empty();
   else if (m_type == VariantTypeString)
-    return m_data.string->empty();
+    return m_data.string.empty();
   else if (m_type == VariantTypeWideString)
     return m_data.wstring->empty();
   else if (m_type == VariantTypeNull)
@@ -848,7 +908,7 @@ void CVariant::clear()
   else if (m_type == VariantTypeArray)
     m_data.array->clear();
   else if (m_type == VariantTypeString)
-    m_data.string->clear();
+    m_data.string.clear();
   else if (m_type == VariantTypeWideString)
     m_data.wstring->clear();
 }
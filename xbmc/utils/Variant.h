@@ -61,8 +61,10 @@ public:
   CVariant(const std::wstring &str);
   CVariant(std::wstring &&str);
   CVariant(const std::vector<std::string> &strArray);
+  CVariant(std::vector<std::string>&& strArray);
   CVariant(const std::map<std::string, std::string> &strMap);
   CVariant(const std::map<std::string, CVariant> &variantMap);
+  CVariant(std::map<std::string, CVariant>&& variantMap);
   CVariant(const CVariant &variant);
   CVariant(CVariant&& rhs) noexcept;
   ~CVariant();
@@ -93,6 +95,7 @@ public:
   float asFloat(float fallback = 0.0f) const;
 
   CVariant &operator[](const std::string &key);
+  CVariant& operator[](std::string&& key);
   const CVariant &operator[](const std::string &key) const;
   CVariant &operator[](unsigned int position);
   const CVariant &operator[](unsigned int position) const;
@@ -145,13 +148,25 @@ public:
 
 private:
   void cleanup();
+  void moveFrom(CVariant& rhs) noexcept;
+
+  /*!
+   Strings are by far the most common leaf values (JSON-RPC, properties, settings), so they are
+   stored inline to save a heap allocation per value and let std::string's own small string
+   buffer hold short values. This makes CVariant (and every array and map element) about as big
+   as a std::string plus the type, e.g. 40 instead of 16 bytes with libstdc++. Containers stay on
+   the heap so they don't grow it any further.
+   */
   union VariantUnion
   {
+    VariantUnion() {}
+    ~VariantUnion() {}
+
     int64_t integer;
     uint64_t unsignedinteger;
     bool boolean;
     double dvalue;
-    std::string *string;
+    std::string string;
     std::wstring *wstring;
     VariantArray *array;
     VariantMap *map;
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/Event.h"
+#include "utils/ActorProtocol.h"
+
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Actor;
+
+namespace
+{
+
+enum Signals
+{
+  PING,
+  PONG,
+  DATA,
+  STOP
+};
+
+struct MoveOnly
+{
+  explicit MoveOnly(int v) : value(new int(v)) {}
+  std::unique_ptr<int> value;
+};
+
+// answers every sync message with PONG until STOP is received
+class CResponder
+{
+public:
+  CResponder(Protocol& protocol, CEvent& event) : m_protocol(protocol), m_event(event)
+  {
+    m_thread = std::thread([this]() { Run(); });
+  }
+
+  ~CResponder()
+  {
+    m_protocol.SendOutMessage(STOP);
+    m_thread.join();
+  }
+
+private:
+  void Run()
+  {
+    while (true)
+    {
+      Message* msg;
+      if (!m_protocol.ReceiveOutMessage(&msg))
+      {
+        m_event.WaitMSec(100);
+        continue;
+      }
+
+      const bool stop = msg->signal == STOP;
+      if (msg->isSync)
+        msg->Reply(PONG);
+      msg->Release();
+      if (stop)
+        return;
+    }
+  }
+
+  Protocol& m_protocol;
+  CEvent& m_event;
+  std::thread m_thread;
+};
+
+} // unnamed namespace
+
+TEST(TestActorProtocol, SendReceive)
+{
+  Protocol protocol("test");
+  const int value = 42;
+  EXPECT_TRUE(protocol.SendOutMessage(DATA, &value, sizeof(value)));
+
+  Message* msg = nullptr;
+  EXPECT_FALSE(protocol.ReceiveInMessage(&msg));
+  ASSERT_TRUE(protocol.ReceiveOutMessage(&msg));
+  EXPECT_EQ(DATA, msg->signal);
+  EXPECT_TRUE(msg->isOut);
+  EXPECT_EQ(sizeof(value), msg->payloadSize);
+  EXPECT_EQ(value, *reinterpret_cast<int*>(msg->data));
+  msg->Release();
+
+  EXPECT_FALSE(protocol.ReceiveOutMessage(&msg));
+}
+
+TEST(TestActorProtocol, Order)
+{
+  Protocol protocol("test");
+  for (int i = 0; i < 100; i++)
+    protocol.SendInMessage(DATA, &i, sizeof(i));
+
+  Message* msg;
+  for (int i = 0; i < 100; i++)
+  {
+    ASSERT_TRUE(protocol.ReceiveInMessage(&msg));
+    EXPECT_EQ(i, *reinterpret_cast<int*>(msg->data));
+    msg->Release();
+  }
+  EXPECT_FALSE(protocol.ReceiveInMessage(&msg));
+}
+
+TEST(TestActorProtocol, LargePayload)
+{
+  Protocol protocol("test");
+  for (size_t size : {16u, 1000u, 100u, 4000u})
+  {
+    std::vector<uint8_t> payload(size);
+    for (size_t i = 0; i < size; i++)
+      payload[i] = static_cast<uint8_t>(i * 7);
+
+    protocol.SendInMessage(DATA, payload.data(), payload.size());
+
+    Message* msg;
+    ASSERT_TRUE(protocol.ReceiveInMessage(&msg));
+    ASSERT_EQ(size, msg->payloadSize);
+    EXPECT_EQ(0, memcmp(payload.data(), msg->data, size));
+    msg->Release();
+  }
+}
+
+TEST(TestActorProtocol, MoveOnlyPayload)
+{
+  Protocol protocol("test");
+  protocol.SendOutMessage(DATA, new CPayloadWrap<MoveOnly>(MoveOnly(7)));
+
+  Message* msg;
+  ASSERT_TRUE(protocol.ReceiveOutMessage(&msg));
+  auto* payload = static_cast<CPayloadWrap<MoveOnly>*>(msg->payloadObj.get());
+  ASSERT_NE(nullptr, payload->GetPlayload()->value);
+  EXPECT_EQ(7, *payload->GetPlayload()->value);
+  msg->Release();
+}
+
+TEST(TestActorProtocol, Purge)
+{
+  Protocol protocol("test");
+  protocol.SendInMessage(DATA);
+  protocol.SendInMessage(PING);
+  protocol.SendInMessage(DATA);
+  protocol.SendInMessage(STOP);
+  protocol.PurgeIn(DATA);
+
+  Message* msg;
+  ASSERT_TRUE(protocol.ReceiveInMessage(&msg));
+  EXPECT_EQ(PING, msg->signal);
+  msg->Release();
+  ASSERT_TRUE(protocol.ReceiveInMessage(&msg));
+  EXPECT_EQ(STOP, msg->signal);
+  msg->Release();
+  EXPECT_FALSE(protocol.ReceiveInMessage(&msg));
+
+  protocol.SendOutMessage(DATA);
+  protocol.Purge();
+  EXPECT_FALSE(protocol.ReceiveOutMessage(&msg));
+}
+
+TEST(TestActorProtocol, SyncTimeout)
+{
+  Protocol protocol("test");
+  Message* reply = nullptr;
+  EXPECT_FALSE(protocol.SendOutMessageSync(PING, &reply, 10));
+  EXPECT_EQ(nullptr, reply);
+
+  // a late reply must not reach the sender
+  Message* msg;
+  ASSERT_TRUE(protocol.ReceiveOutMessage(&msg));
+  EXPECT_TRUE(msg->Reply(PONG));
+  msg->Release();
+  EXPECT_FALSE(protocol.ReceiveInMessage(&msg));
+}
+
+TEST(TestActorProtocol, Sync)
+{
+  CEvent outEvent;
+  Protocol protocol("test", nullptr, &outEvent);
+  CResponder responder(protocol, outEvent);
+
+  for (int i = 0; i < 10; i++)
+  {
+    Message* reply = nullptr;
+    ASSERT_TRUE(protocol.SendOutMessageSync(PING, &reply, 5000, &i, sizeof(i)));
+    ASSERT_NE(nullptr, reply);
+    EXPECT_EQ(PONG, reply->signal);
+    reply->Release();
+  }
+}
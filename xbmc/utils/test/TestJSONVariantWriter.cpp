@@ -9,6 +9,9 @@
 #include "utils/JSONVariantWriter.h"
 #include "utils/Variant.h"
 
+#include <cmath>
+#include <limits>
+
 #include <gtest/gtest.h>
 
 TEST(TestJSONVariantWriter, CanWriteNull)
@@ -149,3 +152,71 @@ TEST(TestJSONVariantWriter, CanWriteArray)
   ASSERT_TRUE(CJSONVariantWriter::Write(variant, str, false));
   ASSERT_STREQ("[\n\t{\n\t\t\"foo\": \"bar\"\n\t}\n]", str.c_str());
 }
+
+namespace
+{
+std::string StreamWrite(CJSONVariantStreamWriter& writer, size_t chunkSize)
+{
+  std::string output;
+  std::vector<char> buffer(chunkSize);
+  size_t read;
+  while ((read = writer.Read(buffer.data(), buffer.size())) > 0)
+    output.append(buffer.data(), read);
+
+  return output;
+}
+} // namespace
+
+TEST(TestJSONVariantWriter, CanStreamWrite)
+{
+  CVariant variant;
+  variant["jsonrpc"] = "2.0";
+  variant["id"] = 1;
+  variant["result"]["limits"]["total"] = 20000;
+  variant["result"]["empty"] = CVariant(CVariant::VariantTypeArray);
+  for (int i = 0; i < 20000; ++i)
+  {
+    CVariant movie;
+    movie["movieid"] = i;
+    movie["label"] = "Movie \"" + std::to_string(i) + "\"";
+    movie["rating"] = 7.5;
+    movie["watched"] = (i % 2) == 0;
+    variant["result"]["movies"].push_back(std::move(movie));
+  }
+
+  for (bool compact : {true, false})
+  {
+    std::string expected;
+    ASSERT_TRUE(CJSONVariantWriter::Write(variant, expected, compact));
+
+    for (size_t chunkSize : {1u, 13u, 2048u, 1024u * 1024u})
+    {
+      CJSONVariantStreamWriter writer(variant, compact);
+      EXPECT_EQ(expected, StreamWrite(writer, chunkSize));
+      EXPECT_TRUE(writer.IsComplete());
+    }
+  }
+}
+
+TEST(TestJSONVariantWriter, CanStreamWriteScalar)
+{
+  CJSONVariantStreamWriter writer(CVariant("foo"), false);
+  EXPECT_FALSE(writer.IsComplete());
+  EXPECT_EQ("\"foo\"", StreamWrite(writer, 2));
+  EXPECT_TRUE(writer.IsComplete());
+}
+
+TEST(TestJSONVariantWriter, NonFiniteDoubleAsNull)
+{
+  CVariant variant;
+  variant["nan"] = std::nan("");
+  variant["inf"] = std::numeric_limits<double>::infinity();
+
+  std::string expected;
+  ASSERT_TRUE(CJSONVariantWriter::Write(variant, expected, true));
+  EXPECT_EQ("{\"inf\":null,\"nan\":null}", expected);
+
+  CJSONVariantStreamWriter writer(variant, true);
+  EXPECT_EQ(expected, StreamWrite(writer, 16));
+  EXPECT_TRUE(writer.IsComplete());
+}
@@ -27,3 +27,28 @@ TEST(TestMime, GetMimeType_CFileItem)
   varstr = CMime::GetMimeType(item);
   EXPECT_STREQ(refstr.c_str(), varstr.c_str());
 }
+
+TEST(TestMime, IsKnownMimeType)
+{
+  EXPECT_TRUE(CMime::IsKnownMimeType("video/mp4"));
+  EXPECT_TRUE(CMime::IsKnownMimeType("x-directory/normal"));
+  EXPECT_FALSE(CMime::IsKnownMimeType("video/x-server-specific; codecs=avc1"));
+  EXPECT_FALSE(CMime::IsKnownMimeType(""));
+}
+
+TEST(TestMime, SetMimeType_CFileItem)
+{
+  const size_t size = CStringInterner::GetSize();
+
+  CFileItem item("stream", false);
+  item.SetMimeType("video/x-server-specific; id=12345");
+  EXPECT_EQ("video/x-server-specific; id=12345", item.GetMimeType());
+  EXPECT_EQ(size, CStringInterner::GetSize());
+
+  CFileItem copy(item);
+  EXPECT_EQ(item.GetMimeType(), copy.GetMimeType());
+
+  item.SetMimeType("video/mp4");
+  EXPECT_EQ("video/mp4", item.GetMimeType());
+  EXPECT_EQ(&CStringInterner::Intern("video/mp4"), &item.GetMimeType());
+}
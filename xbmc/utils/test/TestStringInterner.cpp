@@ -0,0 +1,44 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/StringInterner.h"
+
+#include <gtest/gtest.h>
+
+TEST(TestStringInterner, SameValueSameInstance)
+{
+  const std::string& a = CStringInterner::Intern(std::string("video/x-matroska"));
+  const std::string& b = CStringInterner::Intern(std::string("video/x-matroska"));
+  EXPECT_EQ(&a, &b);
+  EXPECT_EQ("video/x-matroska", a);
+}
+
+TEST(TestStringInterner, DifferentValues)
+{
+  const std::string& a = CStringInterner::Intern("audio/flac");
+  const std::string& b = CStringInterner::Intern("audio/mpeg");
+  EXPECT_NE(&a, &b);
+  EXPECT_EQ("audio/flac", a);
+  EXPECT_EQ("audio/mpeg", b);
+}
+
+TEST(TestStringInterner, Empty)
+{
+  const size_t size = CStringInterner::GetSize();
+  EXPECT_EQ(&CStringInterner::Empty(), &CStringInterner::Intern(""));
+  EXPECT_EQ(size, CStringInterner::GetSize());
+}
+
+TEST(TestStringInterner, StableReferences)
+{
+  const std::string& first = CStringInterner::Intern("x-directory/normal");
+  for (int i = 0; i < 1000; ++i)
+    CStringInterner::Intern("test/stable-" + std::to_string(i));
+  EXPECT_EQ(&first, &CStringInterner::Intern("x-directory/normal"));
+  EXPECT_GT(CStringInterner::GetMemoryUsage(), 0u);
+}
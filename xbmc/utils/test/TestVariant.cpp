@@ -222,6 +222,40 @@ TEST(TestVariant, swap)
   a.swap(b);
   EXPECT_TRUE(b.isInteger());
   EXPECT_TRUE(a.isString());
+  EXPECT_STREQ("variant", a.c_str());
+
+  CVariant c(std::string(64, 'x'));
+  a.swap(c);
+  EXPECT_EQ(std::string(64, 'x'), a.asString());
+  EXPECT_STREQ("variant", c.c_str());
+}
+
+TEST(TestVariant, move)
+{
+  CVariant a(std::string(64, 'x'));
+  CVariant b(std::move(a));
+  EXPECT_TRUE(a.isNull());
+  EXPECT_EQ(std::string(64, 'x'), b.asString());
+
+  CVariant c("short");
+  c = std::move(b);
+  EXPECT_TRUE(b.isNull());
+  EXPECT_EQ(std::string(64, 'x'), c.asString());
+
+  std::vector<std::string> strarray{"string1", "string2"};
+  CVariant d(std::move(strarray));
+  ASSERT_TRUE(d.isArray());
+  EXPECT_STREQ("string2", d[1].c_str());
+
+  std::map<std::string, CVariant> variantMap;
+  variantMap["key"] = "value";
+  CVariant e(std::move(variantMap));
+  ASSERT_TRUE(e.isObject());
+  EXPECT_STREQ("value", e["key"].c_str());
+
+  std::string key("movedkey");
+  e[std::move(key)] = 1;
+  EXPECT_EQ(1, e["movedkey"].asInteger());
 }
 
 TEST(TestVariant, iterator_array)
@@ -100,6 +100,9 @@ void CVideoDatabase::CreateTables()
   CLog::Log(LOGINFO, "create stacktimes table");
   m_pDS->exec("CREATE TABLE stacktimes (idFile integer, times text)\n");
 
+  CLog::Log(LOGINFO, "create keyframes table");
+  m_pDS->exec("CREATE TABLE keyframes (idFile integer, keyframes text)\n");
+
   CLog::Log(LOGINFO, "create genre table");
   m_pDS->exec("CREATE TABLE genre ( genre_id integer primary key, name TEXT)\n");
   m_pDS->exec("CREATE TABLE genre_link (genre_id integer, media_id integer, media_type TEXT)");
@@ -232,6 +235,7 @@ void CVideoDatabase::CreateAnalytics()
   m_pDS->exec("CREATE INDEX ix_bookmark ON bookmark (idFile, type)");
   m_pDS->exec("CREATE UNIQUE INDEX ix_settings ON settings ( idFile )\n");
   m_pDS->exec("CREATE UNIQUE INDEX ix_stacktimes ON stacktimes ( idFile )\n");
+  m_pDS->exec("CREATE UNIQUE INDEX ix_keyframes ON keyframes ( idFile )\n");
   m_pDS->exec("CREATE INDEX ix_path ON path ( strPath(255) )");
   m_pDS->exec("CREATE INDEX ix_path2 ON path ( idParentPath )");
   m_pDS->exec("CREATE INDEX ix_files ON files ( idPath, strFilename(255) )");
@@ -342,6 +346,7 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM bookmark WHERE idFile=old.idFile; "
               "DELETE FROM settings WHERE idFile=old.idFile; "
               "DELETE FROM stacktimes WHERE idFile=old.idFile; "
+              "DELETE FROM keyframes WHERE idFile=old.idFile; "
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
               "END");
 
@@ -5057,6 +5062,63 @@ void CVideoDatabase::SetStackTimes(const std::string& filePath, const std::vecto
   }
 }
 
+/// \brief GetKeyframeIndex() obtains the keyframe index collected for a file during playback
+/// \retval Returns true if a keyframe index exists, false otherwise.
+bool CVideoDatabase::GetKeyframeIndex(const std::string& filePath, std::string& keyframes)
+{
+  try
+  {
+    int idFile = GetFileId(filePath);
+    if (idFile < 0)
+      return false;
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    std::string strSQL = PrepareSQL("select keyframes from keyframes where idFile=%i\n", idFile);
+    m_pDS->query(strSQL);
+    bool found = false;
+    if (m_pDS->num_rows() > 0)
+    {
+      keyframes = m_pDS->fv("keyframes").get_asString();
+      found = !keyframes.empty();
+    }
+    m_pDS->close();
+    return found;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return false;
+}
+
+/// \brief Sets the keyframe index for a particular video file
+void CVideoDatabase::SetKeyframeIndex(const std::string& filePath, const std::string& keyframes)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return;
+    if (nullptr == m_pDS)
+      return;
+    // the index is kept for files known to the database only, playing a file
+    // shouldn't add it
+    int idFile = GetFileId(filePath);
+    if (idFile < 0)
+      return;
+
+    m_pDS->exec(PrepareSQL("delete from keyframes where idFile=%i", idFile));
+    m_pDS->exec(PrepareSQL("insert into keyframes (idFile,keyframes) values (%i,'%s')\n", idFile,
+                           keyframes.c_str()));
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, CURL::GetRedacted(filePath).c_str());
+  }
+}
+
 void CVideoDatabase::RemoveContentForPath(const std::string& strPath, CGUIDialogProgress *progress /* = NULL */)
 {
   if(URIUtils::IsMultiPath(strPath))
@@ -5811,11 +5873,14 @@ void CVideoDatabase::UpdateTables(int iVersion)
 
   if (iVersion < 119)
     m_pDS->exec("ALTER TABLE path ADD allAudio bool");
+
+  if (iVersion < 120)
+    m_pDS->exec("CREATE TABLE keyframes (idFile integer, keyframes text)");
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 119;
+  return 120;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -610,6 +610,15 @@ public:
   bool GetStackTimes(const std::string &filePath, std::vector<uint64_t> &times);
   void SetStackTimes(const std::string &filePath, const std::vector<uint64_t> &times);
 
+  /**
+   * Gets the keyframe index of a file, as serialized by CDemuxKeyframeIndex
+   * @param filePath path of the file
+   * @param keyframes [out] the serialized keyframe index
+   * @return true if the file has a keyframe index
+   */
+  bool GetKeyframeIndex(const std::string& filePath, std::string& keyframes);
+  void SetKeyframeIndex(const std::string& filePath, const std::string& keyframes);
+
   void GetBookMarksForFile(const std::string& strFilenameAndPath, VECBOOKMARKS& bookmarks, CBookmark::EType type = CBookmark::STANDARD, bool bAppend=false, long partNumber=0);
   void AddBookMarkToFile(const std::string& strFilenameAndPath, const CBookmark &bookmark, CBookmark::EType type = CBookmark::STANDARD);
   bool GetResumeBookMark(const std::string& strFilenameAndPath, CBookmark &bookmark);
@@ -28,6 +28,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
+#include "utils/CPUInfo.h"
 #include "utils/EmbeddedArt.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -78,29 +79,47 @@ bool CThumbExtractor::operator==(const CJob* job) const
   return false;
 }
 
-bool CThumbExtractor::DoWork()
+namespace
+{
+bool CanExtractFrom(const CFileItem& item)
 {
-  if (m_item.IsLiveTV()
+  if (item.IsLiveTV()
   // Due to a pvr addon api design flaw (no support for multiple concurrent streams
   // per addon instance), pvr recording thumbnail extraction does not work (reliably).
-  ||  URIUtils::IsPVRRecording(m_item.GetDynPath())
-  ||  URIUtils::IsUPnP(m_item.GetPath())
-  ||  URIUtils::IsBluray(m_item.GetPath())
-  ||  URIUtils::IsPlugin(m_item.GetDynPath()) // plugin path not fully resolved
-  ||  m_item.IsBDFile()
-  ||  m_item.IsDVD()
-  ||  m_item.IsDiscImage()
-  ||  m_item.IsDVDFile(false, true)
-  ||  m_item.IsInternetStream()
-  ||  m_item.IsDiscStub()
-  ||  m_item.IsPlayList())
+  ||  URIUtils::IsPVRRecording(item.GetDynPath())
+  ||  URIUtils::IsUPnP(item.GetPath())
+  ||  URIUtils::IsBluray(item.GetPath())
+  ||  URIUtils::IsPlugin(item.GetDynPath()) // plugin path not fully resolved
+  ||  item.IsBDFile()
+  ||  item.IsDVD()
+  ||  item.IsDiscImage()
+  ||  item.IsDVDFile(false, true)
+  ||  item.IsInternetStream()
+  ||  item.IsDiscStub()
+  ||  item.IsPlayList())
     return false;
 
   // For HTTP/FTP we only allow extraction when on a LAN
-  if (URIUtils::IsRemote(m_item.GetPath()) &&
-     !URIUtils::IsOnLAN(m_item.GetPath())  &&
-     (URIUtils::IsFTP(m_item.GetPath())    ||
-      URIUtils::IsHTTP(m_item.GetPath())))
+  if (URIUtils::IsRemote(item.GetPath()) &&
+     !URIUtils::IsOnLAN(item.GetPath())  &&
+     (URIUtils::IsFTP(item.GetPath())    ||
+      URIUtils::IsHTTP(item.GetPath())))
+    return false;
+
+  return true;
+}
+
+// thumb extraction of several files at once, decoding is single threaded for thumbs
+unsigned int GetExtractorJobs()
+{
+  const int cpus = CServiceBroker::GetCPUInfo()->GetCPUCount();
+  return static_cast<unsigned int>(std::max(1, std::min(4, cpus / 2)));
+}
+} // unnamed namespace
+
+bool CThumbExtractor::DoWork()
+{
+  if (!CanExtractFrom(m_item))
     return false;
 
   bool result=false;
@@ -177,8 +196,60 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
+CBatchThumbExtractor::CBatchThumbExtractor(const CFileItem& item, std::vector<Target> targets)
+  : m_item(item), m_targets(std::move(targets))
+{
+  if (m_item.IsStack())
+    m_item.SetPath(CStackDirectory::GetFirstStackedFile(m_item.GetPath()));
+}
+
+CBatchThumbExtractor::~CBatchThumbExtractor() = default;
+
+bool CBatchThumbExtractor::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) == 0)
+  {
+    const CBatchThumbExtractor* jobExtract = dynamic_cast<const CBatchThumbExtractor*>(job);
+    if (jobExtract && jobExtract->m_item.GetPath() == m_item.GetPath() &&
+        jobExtract->m_targets.size() == m_targets.size() &&
+        std::equal(m_targets.begin(), m_targets.end(), jobExtract->m_targets.begin(),
+                   [](const Target& a, const Target& b) { return a.path == b.path; }))
+      return true;
+  }
+  return false;
+}
+
+bool CBatchThumbExtractor::DoWork()
+{
+  if (m_targets.empty() || !CanExtractFrom(m_item))
+    return false;
+
+  CLog::Log(LOGDEBUG, "{} - trying to extract {} thumbs from video file {}", __FUNCTION__,
+            m_targets.size(), CURL::GetRedacted(m_item.GetPath()));
+
+  std::vector<int64_t> positions;
+  std::vector<CTextureDetails> details(m_targets.size());
+  for (size_t i = 0; i < m_targets.size(); i++)
+  {
+    positions.push_back(m_targets[i].pos);
+    details[i].file = CTextureCache::GetCacheFile(m_targets[i].path) + ".jpg";
+  }
+
+  const int extracted = CDVDFileInfo::ExtractThumbs(
+      m_item, positions, details, nullptr, [this, &details](size_t index, bool extracted) {
+        if (extracted)
+        {
+          CTextureCache::GetInstance().AddCachedTexture(m_targets[index].path, details[index]);
+          m_targets[index].extracted = true;
+        }
+        return !ShouldCancel(index, m_targets.size());
+      });
+
+  return extracted > 0;
+}
+
 CVideoThumbLoader::CVideoThumbLoader() :
-  CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
+  CThumbLoader(), CJobQueue(true, GetExtractorJobs(), CJob::PRIORITY_LOW_PAUSABLE)
 {
   m_videoDatabase = new CVideoDatabase();
 }
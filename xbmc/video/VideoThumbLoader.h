@@ -56,6 +56,43 @@ public:
   bool m_fillStreamDetails; ///< fill in stream details?
 };
 
+/*!
+ \ingroup thumbs,jobs
+ \brief Extracts thumbs at several positions of one video file
+
+ The file is opened and the decoder set up only once for all positions, which
+ is much faster than one CThumbExtractor per position, e.g. for chapter thumbs.
+ The progress passed to IJobCallback::OnJobProgress is the index of the target
+ that was just finished.
+
+ \sa CThumbExtractor and CDVDFileInfo::ExtractThumbs
+ */
+class CBatchThumbExtractor : public CJob
+{
+public:
+  struct Target
+  {
+    std::string path; ///< thumbpath
+    int64_t pos; ///< position to extract thumb from
+    bool extracted = false;
+  };
+
+  CBatchThumbExtractor(const CFileItem& item, std::vector<Target> targets);
+  ~CBatchThumbExtractor() override;
+
+  bool DoWork() override;
+
+  const char* GetType() const override
+  {
+    return kJobTypeMediaFlags;
+  }
+
+  bool operator==(const CJob* job) const override;
+
+  CFileItem m_item;
+  std::vector<Target> m_targets;
+};
+
 class CVideoThumbLoader : public CThumbLoader, public CJobQueue
 {
 public:
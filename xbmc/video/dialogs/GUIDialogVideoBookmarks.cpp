@@ -260,7 +260,9 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
-  // add chapters if around
+  // add chapters if around, missing thumbs are extracted by one job for all chapters
+  std::vector<CBatchThumbExtractor::Target> thumbTargets;
+  std::vector<unsigned int> thumbChapters;
   for (int i = 1; i <= g_application.GetAppPlayer().GetChapterCount(); ++i)
   {
     std::string chapterName;
@@ -283,11 +285,9 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
       item->SetArt("thumb", cachefile);
     else if (i > m_jobsStarted && CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTCHAPTERTHUMBS))
     {
-      CFileItem item(m_filePath, false);
-      CJob* job = new CThumbExtractor(item, m_filePath, true, chapterPath, pos * 1000, false);
-      AddJob(job);
-      m_mapJobsChapter[job] = i;
-      m_jobsStarted++;
+      thumbTargets.push_back({chapterPath, pos * 1000});
+      thumbChapters.push_back(i);
+      m_jobsStarted = i;
     }
 
     item->SetProperty("chapter", i);
@@ -296,6 +296,16 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
+  if (!thumbTargets.empty())
+  {
+    CJob* job = new CBatchThumbExtractor(CFileItem(m_filePath, false), std::move(thumbTargets));
+    {
+      CSingleLock lock(m_jobsSection);
+      m_mapJobsChapter[job] = std::move(thumbChapters);
+    }
+    AddJob(job);
+  }
+
   // sort items by resume point
   std::sort(items.begin(), items.end(), [](const CFileItemPtr &item1, const CFileItemPtr &item2) {
     return item1->GetProperty("resumepoint").asDouble() < item2->GetProperty("resumepoint").asDouble();
@@ -464,7 +474,10 @@ void CGUIDialogVideoBookmarks::OnWindowLoaded()
   m_viewControl.SetParentWindow(GetID());
   m_viewControl.AddView(GetControl(CONTROL_THUMBS));
   m_jobsStarted = 0;
-  m_mapJobsChapter.clear();
+  {
+    CSingleLock lock(m_jobsSection);
+    m_mapJobsChapter.clear();
+  }
   m_vecItems->Clear();
 }
 
@@ -472,7 +485,10 @@ void CGUIDialogVideoBookmarks::OnWindowUnload()
 {
   //stop running thumb extraction jobs
   CancelJobs();
-  m_mapJobsChapter.clear();
+  {
+    CSingleLock lock(m_jobsSection);
+    m_mapJobsChapter.clear();
+  }
   m_vecItems->Clear();
   CGUIDialog::OnWindowUnload();
   m_viewControl.Reset();
@@ -560,16 +576,35 @@ bool CGUIDialogVideoBookmarks::OnAddEpisodeBookmark()
 void CGUIDialogVideoBookmarks::OnJobComplete(unsigned int jobID,
                                              bool success, CJob* job)
 {
-  if (success && IsActive())
   {
-    MAPJOBSCHAPS::iterator iter = m_mapJobsChapter.find(job);
-    if (iter != m_mapJobsChapter.end())
-    {
-      unsigned int chapterIdx = (*iter).second;
-      CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
-      CApplicationMessenger::GetInstance().SendGUIMessage(m);
-      m_mapJobsChapter.erase(iter);
-    }
+    CSingleLock lock(m_jobsSection);
+    m_mapJobsChapter.erase(job);
   }
   CJobQueue::OnJobComplete(jobID, success, job);
 }
+
+void CGUIDialogVideoBookmarks::OnJobProgress(unsigned int jobID,
+                                             unsigned int progress,
+                                             unsigned int total,
+                                             const CJob* job)
+{
+  if (!IsActive())
+    return;
+
+  const CBatchThumbExtractor* extractor = dynamic_cast<const CBatchThumbExtractor*>(job);
+  if (!extractor || progress >= extractor->m_targets.size() ||
+      !extractor->m_targets[progress].extracted)
+    return;
+
+  unsigned int chapter;
+  {
+    CSingleLock lock(m_jobsSection);
+    MAPJOBSCHAPS::const_iterator iter = m_mapJobsChapter.find(const_cast<CJob*>(job));
+    if (iter == m_mapJobsChapter.end() || progress >= iter->second.size())
+      return;
+    chapter = iter->second[progress];
+  }
+
+  CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapter);
+  CApplicationMessenger::GetInstance().SendGUIMessage(m);
+}
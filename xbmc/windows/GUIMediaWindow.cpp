@@ -759,6 +759,13 @@ bool CGUIMediaWindow::GetDirectory(const std::string &strDirectory, CFileItemLis
     // assign fetched directory items
     items.Assign(dirItems);
 
+    if (!items.IsEmpty() && CServiceBroker::GetLogging().IsLogLevelLogged(LOGDEBUG))
+    {
+      const std::size_t bytes = items.GetMemoryUsage();
+      CLog::Log(LOGDEBUG, "CGUIMediaWindow::GetDirectory - {} items use ~{} bytes ({} per item)",
+                items.Size(), bytes, bytes / static_cast<std::size_t>(items.Size()));
+    }
+
     // took over a second, and not normally cached, so cache it
     if ((XbmcThreads::SystemClockMillis() - time) > 1000  && items.CacheToDiscIfSlow())
       items.Save(GetID());